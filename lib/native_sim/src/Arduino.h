@@ -0,0 +1,100 @@
+// Native Arduino HAL
+// The subset of the Arduino-ESP32 core the firmware uses, backed by a
+// virtual clock and virtual touch pads (see hal_native.h). Only built for
+// the native platform; device builds use the real core.
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <type_traits>
+
+using std::min;
+using std::max;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define DEC 10
+#define HEX 16
+
+// RTC memory is ordinary memory here: it survives sim_reboot(), not sim_init()
+#define RTC_NOINIT_ATTR
+
+// Virtual clock: only advances through delay() or hal_advance_us()
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+// Deterministic stand-in for the hardware RNG (see hal_set_entropy)
+uint32_t esp_random();
+
+// Interrupt handlers need no special placement here
+#define IRAM_ATTR
+
+// Virtual touch pad reading (see hal_set_touch)
+uint16_t touchRead(uint8_t pin);
+
+// Virtual touch FSM: while a pad reads below threshold, isr runs at each
+// measurement as the virtual clock passes it (see hal_advance_us)
+void touchAttachInterrupt(uint8_t pin, void (*isr)(), uint16_t threshold);
+void touchSetCycles(uint16_t measure, uint16_t sleep);
+
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) {}
+
+  size_t print(const char* s);
+  size_t print(char c);
+
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  size_t print(T value, int base = DEC) {
+    if constexpr (std::is_floating_point<T>::value) {
+      return printFloat((double)value);
+    } else if constexpr (std::is_signed<T>::value) {
+      if (value < 0) {
+        return print('-') + printNumber(0ULL - (unsigned long long)value, base);
+      }
+    }
+    return printNumber((unsigned long long)value, base);
+  }
+
+  size_t println() { return print('\n'); }
+
+  template <typename T>
+  size_t println(T value) { return print(value) + println(); }
+
+  template <typename T>
+  size_t println(T value, int base) { return print(value, base) + println(); }
+
+private:
+  size_t printNumber(unsigned long long value, int base);
+  size_t printFloat(double value);
+};
+
+extern HardwareSerial Serial;
+
+// FreeRTOS subset: there is no scheduler on the host, so task creation
+// fails and callers take their single-task fallback
+typedef void* TaskHandle_t;
+typedef int BaseType_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                                   void* param, uint32_t priority, TaskHandle_t* handle, BaseType_t core);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, uint32_t ticksToWait);
+void xTaskNotifyGive(TaskHandle_t task);
+void vTaskDelay(uint32_t ticks);
+
+#endif // ARDUINO_H
@@ -0,0 +1,22 @@
+// Native EEPROM HAL
+// A RAM-backed byte array (erased to 0xFF by hal_reset())
+
+#ifndef EEPROM_H
+#define EEPROM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+static constexpr size_t HAL_EEPROM_BYTES = 512;
+
+class EEPROMClass {
+public:
+  bool begin(size_t size);
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  bool commit();
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // EEPROM_H
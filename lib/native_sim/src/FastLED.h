@@ -0,0 +1,104 @@
+// Native FastLED HAL
+// CRGB and the colour helpers the games use, with FastLED's integer
+// maths so frames match the device byte for byte. show() transmits
+// nothing; it counts frames and calls the hook set by hal_set_show_hook().
+
+#ifndef FASTLED_H
+#define FASTLED_H
+
+#include <Arduino.h>
+
+struct CRGB {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+
+  // Values match FastLED's HTML colour table
+  enum HTMLColorCode : uint32_t {
+    Black = 0x000000,
+    Blue = 0x0000FF,
+    Cyan = 0x00FFFF,
+    Green = 0x008000,
+    Magenta = 0xFF00FF,
+    Orange = 0xFFA500,
+    Purple = 0x800080,
+    Red = 0xFF0000,
+    White = 0xFFFFFF,
+    Yellow = 0xFFFF00
+  };
+
+  CRGB() = default;
+  constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  constexpr CRGB(uint32_t colorcode)
+    : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+  constexpr CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+
+  // Saturating add
+  CRGB& operator+=(const CRGB& rhs) {
+    r = qadd8(r, rhs.r);
+    g = qadd8(g, rhs.g);
+    b = qadd8(b, rhs.b);
+    return *this;
+  }
+
+  // Scale each channel by scale/256 (FastLED's "fixed" scale8)
+  CRGB& nscale8(uint8_t scale) {
+    r = scale8(r, scale);
+    g = scale8(g, scale);
+    b = scale8(b, scale);
+    return *this;
+  }
+
+  CRGB& fadeToBlackBy(uint8_t fadeBy) {
+    return nscale8(255 - fadeBy);
+  }
+
+  static uint8_t qadd8(uint8_t i, uint8_t j) {
+    unsigned t = i + j;
+    return t > 255 ? 255 : (uint8_t)t;
+  }
+
+  static uint8_t scale8(uint8_t i, uint8_t scale) {
+    return (uint8_t)(((uint16_t)i * (1 + (uint16_t)scale)) >> 8);
+  }
+};
+
+static_assert(sizeof(CRGB) == 3, "CRGB must be packed r, g, b");
+
+inline bool operator==(const CRGB& a, const CRGB& b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+inline bool operator!=(const CRGB& a, const CRGB& b) {
+  return !(a == b);
+}
+
+inline CRGB operator/(const CRGB& p, uint8_t d) {
+  return CRGB(p.r / d, p.g / d, p.b / d);
+}
+
+inline void fill_solid(CRGB* leds, int numToFill, const CRGB& color) {
+  for (int i = 0; i < numToFill; i++) {
+    leds[i] = color;
+  }
+}
+
+inline void fadeToBlackBy(CRGB* leds, uint16_t numLeds, uint8_t fadeBy) {
+  for (uint16_t i = 0; i < numLeds; i++) {
+    leds[i].fadeToBlackBy(fadeBy);
+  }
+}
+
+class CFastLED {
+public:
+  void show();
+  void setBrightness(uint8_t scale) { brightness = scale; }
+  uint8_t getBrightness() const { return brightness; }
+
+private:
+  uint8_t brightness = 255;
+};
+
+extern CFastLED FastLED;
+
+#endif // FASTLED_H
@@ -0,0 +1,244 @@
+// Native HAL implementation
+
+#include "hal_native.h"
+#include <Arduino.h>
+#include <FastLED.h>
+#include <EEPROM.h>
+#include <stdio.h>
+
+static constexpr uint8_t HAL_TOUCH_PINS = 40;
+static constexpr uint32_t HAL_DEFAULT_ENTROPY = 0x2545F491;
+
+static uint64_t nowUs = 0;
+static uint16_t touchValues[HAL_TOUCH_PINS];
+static uint32_t entropy = HAL_DEFAULT_ENTROPY;
+static uint8_t eepromData[HAL_EEPROM_BYTES];
+static void (*showHook)() = nullptr;
+static uint32_t showCount = 0;
+static bool serialEcho = false;
+
+// Touch FSM: one measurement of every pad per cycle
+struct TouchInterrupt {
+  void (*isr)();
+  uint16_t threshold;
+};
+static TouchInterrupt touchInterrupts[HAL_TOUCH_PINS];
+static uint32_t touchCycleUs = 0;
+static uint64_t nextMeasureUs = 0;
+static uint32_t touchReadCount = 0;
+
+// Measure time at 8MHz plus sleep time at 150kHz
+static uint32_t touchCycleFor(uint16_t measure, uint16_t sleep) {
+  return measure / 8 + (uint32_t)sleep * 1000000 / 150000;
+}
+
+HardwareSerial Serial;
+CFastLED FastLED;
+EEPROMClass EEPROM;
+
+void hal_reset() {
+  nowUs = 0;
+  for (uint8_t i = 0; i < HAL_TOUCH_PINS; i++) {
+    touchValues[i] = HAL_TOUCH_RELEASED;
+    touchInterrupts[i] = {nullptr, 0};
+  }
+  touchCycleUs = touchCycleFor(0x1000, 0x1000);  // Arduino-ESP32 defaults
+  nextMeasureUs = touchCycleUs;
+  touchReadCount = 0;
+  entropy = HAL_DEFAULT_ENTROPY;
+  memset(eepromData, 0xFF, sizeof(eepromData));
+  showCount = 0;
+}
+
+// Power-on state for code that runs before any hal_reset()
+static const bool halReady = (hal_reset(), true);
+
+static void measureTouch() {
+  for (uint8_t pin = 0; pin < HAL_TOUCH_PINS; pin++) {
+    const TouchInterrupt& irq = touchInterrupts[pin];
+    if (irq.isr && touchValues[pin] < irq.threshold) {
+      irq.isr();
+    }
+  }
+}
+
+// Step through each measurement on the way so handlers see its time
+static void advanceTo(uint64_t target) {
+  while (nextMeasureUs <= target) {
+    nowUs = nextMeasureUs;
+    measureTouch();
+    nextMeasureUs += touchCycleUs;
+  }
+  nowUs = target;
+}
+
+void hal_advance_us(uint32_t us) {
+  advanceTo(nowUs + us);
+}
+
+void hal_advance_ms(uint32_t ms) {
+  advanceTo(nowUs + (uint64_t)ms * 1000);
+}
+
+uint64_t hal_time_us() {
+  return nowUs;
+}
+
+void hal_set_touch(uint8_t pin, uint16_t value) {
+  if (pin < HAL_TOUCH_PINS) {
+    touchValues[pin] = value;
+  }
+}
+
+void hal_touch_interrupt(uint8_t pin) {
+  if (pin < HAL_TOUCH_PINS && touchInterrupts[pin].isr) {
+    touchInterrupts[pin].isr();
+  }
+}
+
+uint32_t hal_touch_read_count() {
+  return touchReadCount;
+}
+
+void hal_set_entropy(uint32_t seed) {
+  entropy = seed ? seed : HAL_DEFAULT_ENTROPY;
+}
+
+uint8_t* hal_eeprom_data() {
+  return eepromData;
+}
+
+void hal_set_show_hook(void (*hook)()) {
+  showHook = hook;
+}
+
+uint32_t hal_show_count() {
+  return showCount;
+}
+
+void hal_serial_echo(bool enabled) {
+  serialEcho = enabled;
+}
+
+// Arduino core
+
+uint32_t millis() {
+  return (uint32_t)(nowUs / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)nowUs;
+}
+
+void delay(uint32_t ms) {
+  hal_advance_ms(ms);
+}
+
+void delayMicroseconds(uint32_t us) {
+  hal_advance_us(us);
+}
+
+uint32_t esp_random() {
+  // xorshift32: only used to pick seeds, so quality is not a concern
+  entropy ^= entropy << 13;
+  entropy ^= entropy >> 17;
+  entropy ^= entropy << 5;
+  return entropy;
+}
+
+uint16_t touchRead(uint8_t pin) {
+  touchReadCount++;
+  return pin < HAL_TOUCH_PINS ? touchValues[pin] : HAL_TOUCH_RELEASED;
+}
+
+void touchAttachInterrupt(uint8_t pin, void (*isr)(), uint16_t threshold) {
+  if (pin < HAL_TOUCH_PINS) {
+    touchInterrupts[pin] = {isr, threshold};
+  }
+}
+
+void touchSetCycles(uint16_t measure, uint16_t sleep) {
+  touchCycleUs = touchCycleFor(measure, sleep);
+  nextMeasureUs = nowUs + touchCycleUs;
+}
+
+size_t HardwareSerial::print(const char* s) {
+  if (serialEcho) {
+    fputs(s, stdout);
+  }
+  return strlen(s);
+}
+
+size_t HardwareSerial::print(char c) {
+  if (serialEcho) {
+    fputc(c, stdout);
+  }
+  return 1;
+}
+
+size_t HardwareSerial::printNumber(unsigned long long value, int base) {
+  char buf[8 * sizeof(value) + 1];
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  if (base < 2) {
+    base = DEC;
+  }
+  do {
+    unsigned digit = (unsigned)(value % base);
+    *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+    value /= base;
+  } while (value);
+  return print(p);
+}
+
+size_t HardwareSerial::printFloat(double value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.2f", value);
+  return print(buf);
+}
+
+// FreeRTOS
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                                   void* param, uint32_t priority, TaskHandle_t* handle, BaseType_t core) {
+  return pdFAIL;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, uint32_t ticksToWait) {
+  return 0;
+}
+
+void xTaskNotifyGive(TaskHandle_t task) {}
+
+void vTaskDelay(uint32_t ticks) {
+  hal_advance_ms(ticks);  // 1 kHz tick, as configured on the ESP32
+}
+
+// FastLED
+
+void CFastLED::show() {
+  showCount++;
+  if (showHook) {
+    showHook();
+  }
+}
+
+// EEPROM
+
+bool EEPROMClass::begin(size_t size) {
+  return size <= HAL_EEPROM_BYTES;
+}
+
+uint8_t EEPROMClass::read(int address) {
+  return (address >= 0 && (size_t)address < HAL_EEPROM_BYTES) ? eepromData[address] : 0xFF;
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (address >= 0 && (size_t)address < HAL_EEPROM_BYTES) {
+    eepromData[address] = value;
+  }
+}
+
+bool EEPROMClass::commit() {
+  return true;
+}
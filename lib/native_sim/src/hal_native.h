@@ -0,0 +1,49 @@
+// Native HAL controls
+// Drives the host implementations of Arduino.h, FastLED.h and EEPROM.h:
+// the virtual clock, touch pads, entropy, EEPROM contents and Serial.
+// Everything is deterministic from hal_reset() and the values set here.
+
+#ifndef HAL_NATIVE_H
+#define HAL_NATIVE_H
+
+#include <stdint.h>
+
+// Touch readings for an untouched and a touched pad (threshold sits between)
+static constexpr uint16_t HAL_TOUCH_RELEASED = 80;
+static constexpr uint16_t HAL_TOUCH_PRESSED = 10;
+
+// Clock to zero, pads released and detached, EEPROM erased, entropy reseeded, counters cleared
+void hal_reset();
+
+// Advance the virtual clock, running the touch FSM's interrupts for each
+// measurement passed on the way
+void hal_advance_us(uint32_t us);
+void hal_advance_ms(uint32_t ms);
+
+// Virtual time since hal_reset() (does not wrap like micros())
+uint64_t hal_time_us();
+
+// Raw reading returned by touchRead(pin)
+void hal_set_touch(uint8_t pin, uint16_t value);
+
+// Run pin's touch interrupt handler now, as an extra FSM measurement below
+// threshold would; no-op if none is attached
+void hal_touch_interrupt(uint8_t pin);
+
+// touchRead() calls since hal_reset()
+uint32_t hal_touch_read_count();
+
+// Seed for esp_random()
+void hal_set_entropy(uint32_t seed);
+
+// Direct access to the EEPROM bytes (HAL_EEPROM_BYTES)
+uint8_t* hal_eeprom_data();
+
+// FastLED.show() calls since hal_reset(), and a hook run on each
+void hal_set_show_hook(void (*hook)());
+uint32_t hal_show_count();
+
+// Echo Serial output to stdout (off by default)
+void hal_serial_echo(bool enabled);
+
+#endif // HAL_NATIVE_H
@@ -0,0 +1,94 @@
+// Headless simulator implementation
+
+#include "sim.h"
+#include <EEPROM.h>
+#include "../../../src/config/led_config.h"
+#include "../../../src/input/touch_input.h"
+#include "../../../src/games/game_manager.h"
+#include "../../../src/games/game_snapshot.h"
+#include "../../../src/input/input_recorder.h"
+#include "../../../src/render/led_output.h"
+#include "../../../src/render/effect_sequencer.h"
+#include "../../../src/render/frame_output.h"
+#include "../../../src/status/frame_timing.h"
+#include "../../../src/status/input_latency.h"
+
+// Same buffers as main.cpp
+CRGB leds[NUM_LEDS];
+static CRGB frontLeds[NUM_LEDS];
+
+static const uint8_t BUTTON_PINS[] = {
+  TOUCH_PIN_LEFT,
+  TOUCH_PIN_RIGHT,
+  TOUCH_PIN_ACTION,
+  TOUCH_PIN_ALT
+};
+
+static uint32_t lastFrameMs = 0;
+
+// Module state outlives a reset on the host; clear what setup() assumes fresh
+static void resetModules() {
+  effect_sequencer_cancel();
+  input_recorder_stop();
+  frame_output_invalidate();
+  game_snapshot_clear_cache();
+  input_latency_clear();
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+  fill_solid(frontLeds, NUM_LEDS, CRGB::Black);
+
+  led_output_init((uint8_t*)frontLeds, NUM_LEDS);
+  touch_input_init();
+  game_manager_init();
+}
+
+void sim_init(uint8_t gameId, uint32_t entropy) {
+  hal_reset();
+  hal_set_entropy(entropy);
+  hal_eeprom_data()[0] = gameId;
+  game_snapshot_clear_checkpoint();
+
+  resetModules();
+  game_manager_setup();
+  lastFrameMs = millis();
+}
+
+void sim_reboot() {
+  resetModules();
+  game_manager_start();
+  lastFrameMs = millis();
+}
+
+void sim_set_button(SimButton button, bool down) {
+  hal_set_touch(BUTTON_PINS[button], down ? HAL_TOUCH_PRESSED : HAL_TOUCH_RELEASED);
+}
+
+void sim_frame(uint32_t dtMs) {
+  hal_advance_ms(dtMs);
+  frame_timing_begin();
+
+  uint32_t now = millis();
+  uint32_t dt = now - lastFrameMs;
+  lastFrameMs = now;
+
+  touch_input_update();
+  frame_timing_lap(PERF_TOUCH);
+  game_manager_loop(dt);
+  frame_timing_lap(PERF_GAME);
+
+  frame_timing_end(game_manager_get_current_game());
+}
+
+void sim_run(uint32_t durationMs, uint32_t frameMs) {
+  uint64_t end = hal_time_us() + (uint64_t)durationMs * 1000;
+  while (hal_time_us() < end) {
+    sim_frame(frameMs);
+  }
+}
+
+const CRGB* sim_leds() {
+  return leds;
+}
+
+const CRGB* sim_strip() {
+  return frontLeds;
+}
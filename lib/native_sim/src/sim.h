@@ -0,0 +1,47 @@
+// Headless simulator
+// Runs the firmware's own touch input, game manager and LED output on the
+// host against the native HAL. Time is virtual: a frame takes as long as
+// the code does, so games run many times faster than real time and every
+// run is reproducible from its entropy seed and input script.
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <FastLED.h>
+#include "hal_native.h"
+
+enum SimButton : uint8_t {
+  SIM_LEFT,
+  SIM_RIGHT,
+  SIM_ACTION,
+  SIM_ALT
+};
+
+// Default loop() period: the device loop is unthrottled, ~1ms per pass
+static constexpr uint32_t SIM_FRAME_MS = 1;
+
+// Power on with the given game selected (as if saved in EEPROM) and
+// esp_random() seeded with entropy; mirrors setup() without networking
+void sim_init(uint8_t gameId, uint32_t entropy);
+
+// Warm reboot, mirroring setup(): EEPROM and RTC memory (the game
+// checkpoint) survive, the clock keeps running, RAM state is lost
+void sim_reboot();
+
+// Hold or release a touch pad (read on the next frame)
+void sim_set_button(SimButton button, bool down);
+
+// Advance the clock by dtMs and run one pass of loop()
+void sim_frame(uint32_t dtMs = SIM_FRAME_MS);
+
+// Run frames of frameMs until durationMs of virtual time has passed
+void sim_run(uint32_t durationMs, uint32_t frameMs = SIM_FRAME_MS);
+
+// Back buffer the games render into
+const CRGB* sim_leds();
+
+// Front buffer: what the strip was last sent
+const CRGB* sim_strip();
+
+#endif // SIM_H
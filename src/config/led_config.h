@@ -0,0 +1,27 @@
+// LED strip configuration
+// Single source of truth for strip length: games, status monitor, web
+// server and dashboard all derive from NUM_LEDS
+
+#ifndef LED_CONFIG_H
+#define LED_CONFIG_H
+
+// Number of LEDs in the strip
+// Override at build time, e.g. build_flags = -DNUM_LEDS=300 in platformio.ini
+#ifndef NUM_LEDS
+#define NUM_LEDS 8
+#endif
+
+// Strip data pin (locked by the installed hardware)
+#define LED_PIN 16
+
+#define LED_CONFIG_STR_(x) #x
+#define LED_CONFIG_STR(x) LED_CONFIG_STR_(x)
+
+// Strip description for the games' boot banners, e.g. "(300 LEDs) on GPIO 16"
+#define LED_STRIP_BANNER "(" LED_CONFIG_STR(NUM_LEDS) " LEDs) on GPIO " LED_CONFIG_STR(LED_PIN)
+
+#if NUM_LEDS < 8
+#error "NUM_LEDS must be at least 8 (games place start/goal/defender zones)"
+#endif
+
+#endif // LED_CONFIG_H
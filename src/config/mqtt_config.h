@@ -18,5 +18,8 @@
 // Reconnection interval (milliseconds)
 #define MQTT_RECONNECT_INTERVAL_MS 5000
 
+// Status (<prefix>/status) goes out when it changed, at most this often
+#define MQTT_STATUS_INTERVAL_MS 1000
+
 #endif // MQTT_CONFIG_H
 
@@ -0,0 +1,19 @@
+// Red/green/blue colour ids shared by the colour-matching games
+
+#ifndef COLOR_ID_H
+#define COLOR_ID_H
+
+#include <stdint.h>
+#include <FastLED.h>
+
+enum ColorId : uint8_t { C_RED=0, C_GREEN=1, C_BLUE=2 };
+
+inline CRGB colorFromId(ColorId c) {
+  switch (c) {
+    case C_RED:   return CRGB::Red;
+    case C_GREEN: return CRGB::Green;
+    default:      return CRGB::Blue;
+  }
+}
+
+#endif // COLOR_ID_H
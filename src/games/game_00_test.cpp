@@ -6,16 +6,21 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_00_test.h"
+#include "game_arena.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
-static int ledPos = NUM_LEDS / 2;
-static uint8_t colorIndex = 0;
+// Update at ~30fps
+static constexpr uint32_t TICK_MS = 33;
+
+static TestState& s = game_00_state();
+
 static const CRGB colors[] = {
   CRGB::Red,
   CRGB::Green,
@@ -26,37 +31,34 @@ static const CRGB colors[] = {
   CRGB::White
 };
 static const int numColors = sizeof(colors) / sizeof(colors[0]);
-static uint32_t flashTimer = 0;
-static bool flashing = false;
 
 static void resetGame() {
-  ledPos = NUM_LEDS / 2;
-  colorIndex = 0;
-  flashTimer = 0;
-  flashing = false;
-  FastLED.clear();
-  FastLED.show();
+  s.ledPos = NUM_LEDS / 2;
+  s.colorIndex = 0;
+  s.flashTimer = 0;
+  s.flashing = false;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
 static void flashAll() {
-  flashing = true;
-  flashTimer = 200; // Flash for 200ms
-  fill_solid(leds, NUM_LEDS, colors[colorIndex]);
-  FastLED.show();
+  s.flashing = true;
+  s.flashTimer = 200; // Flash for 200ms
+  fill_solid(leds, NUM_LEDS, colors[s.colorIndex]);
 }
 
 static void updatePosition() {
-  if (touch_left_just_pressed() && ledPos > 0) {
-    ledPos--;
+  // Holding a pad keeps moving (auto-repeat)
+  if (touch_left_repeated() && s.ledPos > 0) {
+    s.ledPos--;
   }
-  if (touch_right_just_pressed() && ledPos < NUM_LEDS - 1) {
-    ledPos++;
+  if (touch_right_repeated() && s.ledPos < NUM_LEDS - 1) {
+    s.ledPos++;
   }
 }
 
 static void updateColor() {
   if (touch_action_just_pressed()) {
-    colorIndex = (colorIndex + 1) % numColors;
+    s.colorIndex = (s.colorIndex + 1) % numColors;
   }
 }
 
@@ -65,20 +67,20 @@ static void updateFlash() {
     flashAll();
   }
 
-  if (flashing) {
-    if (flashTimer > 0) {
-      flashTimer--;
+  if (s.flashing) {
+    if (s.flashTimer > 0) {
+      s.flashTimer--;
     } else {
-      flashing = false;
-      FastLED.clear();
+      s.flashing = false;
+      fill_solid(leds, NUM_LEDS, CRGB::Black);
     }
   }
 }
 
 static void render() {
-  if (!flashing) {
+  if (!s.flashing) {
     fadeToBlackBy(leds, NUM_LEDS, 50);
-    leds[ledPos] = colors[colorIndex];
+    leds[s.ledPos] = colors[s.colorIndex];
   }
 }
 
@@ -97,29 +99,25 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  static uint32_t accum = 0;
-  accum += dt;
-
-  // Update at ~30fps
-  while (accum >= 33) {
-    accum -= 33;
-
-    updatePosition();
-    updateColor();
-    updateFlash();
-    render();
-  }
-
-  FastLED.show();
+static void game_update() {
+  updatePosition();
+  updateColor();
+  updateFlash();
 }
 
 // Wrapper functions for game manager
+extern const uint16_t game_00_tick_ms = TICK_MS;
+
 void game_00_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_00_loop(uint32_t dt) {
-  game_loop(dt);
+void game_00_update() {
+  game_update();
+}
+
+void game_00_render() {
+  render();
 }
 
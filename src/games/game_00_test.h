@@ -0,0 +1,18 @@
+// Test Game state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_00_TEST_H
+#define GAME_00_TEST_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+
+struct TestState {
+  int ledPos = NUM_LEDS / 2;
+  uint8_t colorIndex = 0;
+  uint32_t flashTimer = 0;
+  bool flashing = false;
+};
+
+TestState& game_00_state();
+
+#endif // GAME_00_TEST_H
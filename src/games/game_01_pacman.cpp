@@ -4,13 +4,19 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_01_pacman.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "object_pool.h"
+#include "occupancy_layer.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 50;
 static constexpr uint32_t PELLET_SPAWN_MS = 2000;
@@ -18,135 +24,109 @@ static constexpr uint32_t GHOST_SPAWN_MS = 3000;
 static constexpr uint32_t GHOST_MOVE_MS = 400;
 static constexpr uint32_t POWER_PELLET_DURATION_MS = 5000;
 
-struct Pellet {
-  bool active = false;
-  int pos = 0;
-  bool isPowerPellet = false;
-};
-
-struct Ghost {
-  bool active = false;
-  int pos = 0;
-  int dir = 1;  // +1 right, -1 left
-};
-
-static int pacmanPos = NUM_LEDS / 2;
-static int pacmanDir = 0;  // -1 left, 0 none, +1 right
-static Pellet pellets[4];
-static Ghost ghost;
-static uint32_t score = 0;
-static uint32_t powerPelletTimer = 0;
-static bool powerMode = false;
-static uint32_t tPelletSpawn = 0;
-static uint32_t tGhostSpawn = 0;
-static uint32_t tGhostMove = 0;
+typedef PacmanState::Pellet Pellet;
+typedef PacmanState::Ghost Ghost;
+
+static PacmanState& s = game_01_state();
 
 static void resetGame() {
-  pacmanPos = NUM_LEDS / 2;
-  pacmanDir = 0;
-  for (int i = 0; i < 4; i++) pellets[i] = Pellet{};
-  ghost = Ghost{};
-  score = 0;
-  powerPelletTimer = 0;
-  powerMode = false;
-  tPelletSpawn = tGhostSpawn = tGhostMove = 0;
-  FastLED.clear();
-  FastLED.show();
+  s.pacmanPos = NUM_LEDS / 2;
+  s.pacmanDir = 0;
+  s.pellets.clear();
+  s.pelletCells.clear();
+  s.ghost = Ghost{};
+  s.score = 0;
+  s.powerPelletTimer = 0;
+  s.powerMode = false;
+  s.tPelletSpawn = s.tGhostSpawn = s.tGhostMove = 0;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
-static void flashGameOver() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Red);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
+static const FlashEffect GAME_OVER_FLASH = {CRGB::Red, 3, 150, 150, 0};
+
+// Runs when the game over flash finishes
+static void restartGame() {
+  resetGame();
+#ifdef ENABLE_NETWORKING
+  status_monitor_update_state(GAME_STATE_PLAYING);
+  status_monitor_update_score(0);
+#endif
 }
 
 static void spawnPellet() {
-  for (int i = 0; i < 4; i++) {
-    if (!pellets[i].active) {
-      pellets[i].active = true;
-      pellets[i].pos = esp_random() % NUM_LEDS;
-      pellets[i].isPowerPellet = (esp_random() % 10) == 0;  // 10% chance
-      return;
-    }
-  }
+  Pellet* pellet = s.pellets.acquire();
+  if (!pellet) return;
+  pellet->pos = game_random_below(NUM_LEDS);
+  pellet->isPowerPellet = game_random_below(10) == 0;  // 10% chance
+  s.pelletCells.insert(s.pellets.slotOf(pellet), pellet->pos);
 }
 
 static void spawnGhost() {
-  if (ghost.active) return;
-  ghost.active = true;
-  ghost.pos = (esp_random() & 1) ? 0 : (NUM_LEDS - 1);
-  ghost.dir = (ghost.pos == 0) ? 1 : -1;
+  if (s.ghost.active) return;
+  s.ghost.active = true;
+  s.ghost.pos = (game_random() & 1) ? 0 : (NUM_LEDS - 1);
+  s.ghost.dir = (s.ghost.pos == 0) ? 1 : -1;
 }
 
 static void updatePacman() {
-  if (pacmanDir != 0) {
-    pacmanPos += pacmanDir;
-    if (pacmanPos < 0) pacmanPos = NUM_LEDS - 1;
-    if (pacmanPos >= NUM_LEDS) pacmanPos = 0;
+  if (s.pacmanDir != 0) {
+    s.pacmanPos += s.pacmanDir;
+    if (s.pacmanPos < 0) s.pacmanPos = NUM_LEDS - 1;
+    if (s.pacmanPos >= NUM_LEDS) s.pacmanPos = 0;
   }
 }
 
 static void updateGhost() {
-  if (!ghost.active) return;
+  if (!s.ghost.active) return;
 
-  if (powerMode) {
+  if (s.powerMode) {
     // In power mode, ghost runs away
-    if (ghost.pos > pacmanPos) ghost.dir = 1;
-    else if (ghost.pos < pacmanPos) ghost.dir = -1;
-    else ghost.dir = (esp_random() & 1) ? 1 : -1;
+    if (s.ghost.pos > s.pacmanPos) s.ghost.dir = 1;
+    else if (s.ghost.pos < s.pacmanPos) s.ghost.dir = -1;
+    else s.ghost.dir = (game_random() & 1) ? 1 : -1;
   } else {
     // Normal mode: ghost chases pacman
-    if (ghost.pos > pacmanPos) ghost.dir = -1;
-    else if (ghost.pos < pacmanPos) ghost.dir = 1;
-    else ghost.dir = (esp_random() & 1) ? 1 : -1;
+    if (s.ghost.pos > s.pacmanPos) s.ghost.dir = -1;
+    else if (s.ghost.pos < s.pacmanPos) s.ghost.dir = 1;
+    else s.ghost.dir = (game_random() & 1) ? 1 : -1;
   }
 
-  ghost.pos += ghost.dir;
-  if (ghost.pos < 0) ghost.pos = NUM_LEDS - 1;
-  if (ghost.pos >= NUM_LEDS) ghost.pos = 0;
+  s.ghost.pos += s.ghost.dir;
+  if (s.ghost.pos < 0) s.ghost.pos = NUM_LEDS - 1;
+  if (s.ghost.pos >= NUM_LEDS) s.ghost.pos = 0;
 }
 
 static void checkCollisions() {
   // Check pellet collection
-  for (int i = 0; i < 4; i++) {
-    if (pellets[i].active && pellets[i].pos == pacmanPos) {
-      pellets[i].active = false;
-      if (pellets[i].isPowerPellet) {
-        powerMode = true;
-        powerPelletTimer = POWER_PELLET_DURATION_MS;
-      }
-      score++;
+  while (s.pelletCells.occupied(s.pacmanPos)) {
+    uint16_t id = s.pelletCells.first(s.pacmanPos);
+    if (s.pellets.atSlot(id).isPowerPellet) {
+      s.powerMode = true;
+      s.powerPelletTimer = POWER_PELLET_DURATION_MS;
+    }
+    s.pelletCells.remove(id);
+    s.pellets.release(&s.pellets.atSlot(id));
+    s.score++;
 #ifdef ENABLE_NETWORKING
-      status_monitor_update_score(score);
+    status_monitor_update_score(s.score);
 #endif
-    }
   }
 
   // Check ghost collision
-  if (ghost.active && ghost.pos == pacmanPos) {
-    if (powerMode) {
+  if (s.ghost.active && s.ghost.pos == s.pacmanPos) {
+    if (s.powerMode) {
       // Eat ghost
-      ghost.active = false;
-      score += 10;
+      s.ghost.active = false;
+      s.score += 10;
 #ifdef ENABLE_NETWORKING
-      status_monitor_update_score(score);
+      status_monitor_update_score(s.score);
 #endif
     } else {
       // Game over
 #ifdef ENABLE_NETWORKING
       status_monitor_update_state(GAME_STATE_GAME_OVER);
 #endif
-      flashGameOver();
-      resetGame();
-#ifdef ENABLE_NETWORKING
-      status_monitor_update_state(GAME_STATE_PLAYING);
-      status_monitor_update_score(0);
-#endif
+      effect_sequencer_play(GAME_OVER_FLASH, restartGame);
     }
   }
 }
@@ -155,38 +135,35 @@ static void render() {
   fadeToBlackBy(leds, NUM_LEDS, 100);
 
   // Render pellets
-  for (int i = 0; i < 4; i++) {
-    if (pellets[i].active) {
-      if (pellets[i].isPowerPellet) {
-        leds[pellets[i].pos] = CRGB::White;
-      } else {
-        leds[pellets[i].pos] = CRGB(64, 64, 0);  // Dim yellow
-      }
+  for (int i = 0; i < s.pellets.size(); i++) {
+    if (s.pellets[i].isPowerPellet) {
+      leds[s.pellets[i].pos] = CRGB::White;
+    } else {
+      leds[s.pellets[i].pos] = CRGB(64, 64, 0);  // Dim yellow
     }
   }
 
   // Render ghost
-  if (ghost.active) {
-    if (powerMode) {
+  if (s.ghost.active) {
+    if (s.powerMode) {
       // Blue when vulnerable
-      leds[ghost.pos] = CRGB::Blue;
+      leds[s.ghost.pos] = CRGB::Blue;
     } else {
-      leds[ghost.pos] = CRGB::Red;
+      leds[s.ghost.pos] = CRGB::Red;
     }
   }
 
   // Render pacman
-  leds[pacmanPos] = CRGB::Yellow;
+  leds[s.pacmanPos] = CRGB::Yellow;
 
   // Score indicator on last LED
-  uint8_t brightness = (uint8_t)min<uint32_t>(score * 5, 255);
+  uint8_t brightness = (uint8_t)min<uint32_t>(s.score * 5, 255);
   leds[NUM_LEDS - 1] += CRGB(0, brightness, 0);
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("1D Pacman (8 LEDs) on GPIO 16");
+  Serial.println("1D Pacman " LED_STRIP_BANNER);
   Serial.println("Left touch: move left, Right touch: move right");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("Pacman");
@@ -195,63 +172,58 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  static uint32_t accum = 0;
-  accum += dt;
-
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
+static void game_update() {
+  s.tPelletSpawn += TICK_MS;
+  s.tGhostSpawn += TICK_MS;
+  s.tGhostMove += TICK_MS;
 
-    tPelletSpawn += TICK_MS;
-    tGhostSpawn += TICK_MS;
-    tGhostMove += TICK_MS;
-
-    if (powerMode) {
-      if (powerPelletTimer > TICK_MS) {
-        powerPelletTimer -= TICK_MS;
-      } else {
-        powerMode = false;
-        powerPelletTimer = 0;
-      }
-    }
-
-    if (tPelletSpawn >= PELLET_SPAWN_MS) {
-      tPelletSpawn = 0;
-      spawnPellet();
+  if (s.powerMode) {
+    if (s.powerPelletTimer > TICK_MS) {
+      s.powerPelletTimer -= TICK_MS;
+    } else {
+      s.powerMode = false;
+      s.powerPelletTimer = 0;
     }
+  }
 
-    if (tGhostSpawn >= GHOST_SPAWN_MS) {
-      tGhostSpawn = 0;
-      spawnGhost();
-    }
+  if (s.tPelletSpawn >= PELLET_SPAWN_MS) {
+    s.tPelletSpawn = 0;
+    spawnPellet();
+  }
 
-    if (tGhostMove >= GHOST_MOVE_MS) {
-      tGhostMove = 0;
-      updateGhost();
-    }
+  if (s.tGhostSpawn >= GHOST_SPAWN_MS) {
+    s.tGhostSpawn = 0;
+    spawnGhost();
+  }
 
-    // Update pacman based on input
-    if (touch_left_just_pressed()) {
-      pacmanDir = -1;
-    } else if (touch_right_just_pressed()) {
-      pacmanDir = 1;
-    }
-    updatePacman();
+  if (s.tGhostMove >= GHOST_MOVE_MS) {
+    s.tGhostMove = 0;
+    updateGhost();
+  }
 
-    checkCollisions();
-    render();
+  // Update pacman based on input
+  if (touch_left_just_pressed()) {
+    s.pacmanDir = -1;
+  } else if (touch_right_just_pressed()) {
+    s.pacmanDir = 1;
   }
+  updatePacman();
 
-  FastLED.show();
+  checkCollisions();
 }
 
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_01_tick_ms = TICK_MS;
+
 void game_01_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_01_loop(uint32_t dt) {
-  game_loop(dt);
+void game_01_update() {
+  game_update();
+}
+
+void game_01_render() {
+  render();
 }
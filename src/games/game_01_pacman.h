@@ -0,0 +1,40 @@
+// 1D Pacman state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_01_PACMAN_H
+#define GAME_01_PACMAN_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+#include "object_pool.h"
+#include "occupancy_layer.h"
+
+static constexpr uint16_t MAX_PELLETS = NUM_LEDS / 2;
+
+struct PacmanState {
+  struct Pellet {
+    int pos = 0;
+    bool isPowerPellet = false;
+  };
+
+  struct Ghost {
+    bool active = false;
+    int pos = 0;
+    int dir = 1;  // +1 right, -1 left
+  };
+
+  int pacmanPos = NUM_LEDS / 2;
+  int pacmanDir = 0;  // -1 left, 0 none, +1 right
+  ObjectPool<Pellet, MAX_PELLETS> pellets;
+  OccupancyLayer<NUM_LEDS, MAX_PELLETS> pelletCells;  // Keyed by pool slot
+  Ghost ghost;
+  uint32_t score = 0;
+  uint32_t powerPelletTimer = 0;
+  bool powerMode = false;
+  uint32_t tPelletSpawn = 0;
+  uint32_t tGhostSpawn = 0;
+  uint32_t tGhostMove = 0;
+};
+
+PacmanState& game_01_state();
+
+#endif // GAME_01_PACMAN_H
@@ -4,86 +4,72 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_02_lava_run.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 100;
 static constexpr uint32_t LAVA_ERUPT_MS = 800;
 static constexpr uint32_t LAVA_COOL_MS = 1200;
 static constexpr uint32_t PLAYER_MOVE_MS = 200;
 
-static int playerPos = 0;
-static int targetPos = NUM_LEDS - 1;
-static bool lavaActive[NUM_LEDS];
-static uint32_t lavaTimers[NUM_LEDS];
-static uint32_t tLavaCycle = 0;
-static uint32_t tPlayerMove = 0;
-static bool gameWon = false;
-static bool gameOver = false;
+static LavaRunState& s = game_02_state();
 
 static void resetGame() {
-  playerPos = 0;
-  targetPos = NUM_LEDS - 1;
+  s.playerPos = 0;
+  s.targetPos = NUM_LEDS - 1;
   for (int i = 0; i < NUM_LEDS; i++) {
-    lavaActive[i] = false;
-    lavaTimers[i] = 0;
+    s.lavaActive[i] = false;
+    s.lavaTimers[i] = 0;
   }
-  tLavaCycle = 0;
-  tPlayerMove = 0;
-  gameWon = false;
-  gameOver = false;
-  FastLED.clear();
-  FastLED.show();
+  s.tLavaCycle = 0;
+  s.tPlayerMove = 0;
+  s.gameWon = false;
+  s.gameOver = false;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
-static void flashWin() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Green);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
-}
+// Flash three times, then hold dark for a second before the next round
+static const FlashEffect WIN_FLASH = {CRGB::Green, 3, 150, 150, 1000};
+static const FlashEffect GAME_OVER_FLASH = {CRGB::Red, 3, 150, 150, 1000};
 
-static void flashGameOver() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Red);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
+// Runs when the win / game over flash finishes
+static void restartGame() {
+  resetGame();
+#ifdef ENABLE_NETWORKING
+  status_monitor_update_state(GAME_STATE_PLAYING);
+#endif
 }
 
 static void updateLava() {
   // Randomly activate/deactivate lava zones
   for (int i = 1; i < NUM_LEDS - 1; i++) {  // Not on start/end
-    if (lavaTimers[i] > 0) {
-      lavaTimers[i] -= TICK_MS;
-      if (lavaTimers[i] <= 0) {
-        lavaActive[i] = !lavaActive[i];
-        if (lavaActive[i]) {
-          lavaTimers[i] = LAVA_ERUPT_MS;
+    if (s.lavaTimers[i] > 0) {
+      s.lavaTimers[i] -= TICK_MS;
+      if (s.lavaTimers[i] <= 0) {
+        s.lavaActive[i] = !s.lavaActive[i];
+        if (s.lavaActive[i]) {
+          s.lavaTimers[i] = LAVA_ERUPT_MS;
         } else {
-          lavaTimers[i] = LAVA_COOL_MS;
+          s.lavaTimers[i] = LAVA_COOL_MS;
         }
       }
     } else {
       // Initialize
-      if ((esp_random() % 3) == 0) {
-        lavaActive[i] = true;
-        lavaTimers[i] = LAVA_ERUPT_MS;
+      if (game_random_below(3) == 0) {
+        s.lavaActive[i] = true;
+        s.lavaTimers[i] = LAVA_ERUPT_MS;
       } else {
-        lavaActive[i] = false;
-        lavaTimers[i] = LAVA_COOL_MS;
+        s.lavaActive[i] = false;
+        s.lavaTimers[i] = LAVA_COOL_MS;
       }
     }
   }
@@ -91,48 +77,38 @@ static void updateLava() {
 
 static void updatePlayer() {
   // Move based on input
-  if (touch_action_just_pressed() && playerPos < targetPos && !lavaActive[playerPos + 1]) {
-    playerPos++;
+  if (touch_action_just_pressed() && s.playerPos < s.targetPos && !s.lavaActive[s.playerPos + 1]) {
+    s.playerPos++;
   }
 }
 
 static void checkGameState() {
-  if (playerPos == targetPos && !gameWon) {
-    gameWon = true;
+  if (s.playerPos == s.targetPos && !s.gameWon) {
+    s.gameWon = true;
 #ifdef ENABLE_NETWORKING
     status_monitor_update_state(GAME_STATE_WON);
 #endif
-    flashWin();
-    delay(1000);
-    resetGame();
-#ifdef ENABLE_NETWORKING
-    status_monitor_update_state(GAME_STATE_PLAYING);
-#endif
+    effect_sequencer_play(WIN_FLASH, restartGame);
   }
 
-  if (lavaActive[playerPos] && !gameOver) {
-    gameOver = true;
+  if (s.lavaActive[s.playerPos] && !s.gameOver) {
+    s.gameOver = true;
 #ifdef ENABLE_NETWORKING
     status_monitor_update_state(GAME_STATE_GAME_OVER);
 #endif
-    flashGameOver();
-    delay(1000);
-    resetGame();
-#ifdef ENABLE_NETWORKING
-    status_monitor_update_state(GAME_STATE_PLAYING);
-#endif
+    effect_sequencer_play(GAME_OVER_FLASH, restartGame);
   }
 }
 
 static void render() {
   fadeToBlackBy(leds, NUM_LEDS, 150);
 
-  // Render lava zones
+  // Render lava zones (pulsing red/orange, all zones in phase)
+  uint8_t intensity = 128 + (sin(millis() / 50.0) * 127);
+  CRGB lava(intensity, intensity / 4, 0);
   for (int i = 0; i < NUM_LEDS; i++) {
-    if (lavaActive[i]) {
-      // Pulsing red/orange
-      uint8_t intensity = 128 + (sin(millis() / 50.0) * 127);
-      leds[i] = CRGB(intensity, intensity / 4, 0);
+    if (s.lavaActive[i]) {
+      leds[i] = lava;
     }
   }
 
@@ -140,16 +116,15 @@ static void render() {
   leds[0] = CRGB::Green;
 
   // Render end (blue)
-  leds[targetPos] = CRGB::Blue;
+  leds[s.targetPos] = CRGB::Blue;
 
   // Render player (white)
-  leds[playerPos] = CRGB::White;
+  leds[s.playerPos] = CRGB::White;
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("Lava Run (8 LEDs) on GPIO 16");
+  Serial.println("Lava Run " LED_STRIP_BANNER);
   Serial.println("Action touch: move forward (when safe)");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("Lava Run");
@@ -157,43 +132,34 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  if (gameWon || gameOver) return;
-
-  static uint32_t accum = 0;
-  accum += dt;
+static void game_update() {
+  if (s.gameWon || s.gameOver) return;
 
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
+  s.tLavaCycle += TICK_MS;
+  s.tPlayerMove += TICK_MS;
 
-    tLavaCycle += TICK_MS;
-    tPlayerMove += TICK_MS;
+  updateLava();
 
-    updateLava();
-
-    if (tPlayerMove >= PLAYER_MOVE_MS) {
-      tPlayerMove = 0;
-      updatePlayer();
-    }
-
-    checkGameState();
-    render();
+  if (s.tPlayerMove >= PLAYER_MOVE_MS) {
+    s.tPlayerMove = 0;
+    updatePlayer();
   }
 
-  FastLED.show();
+  checkGameState();
 }
 
-
-
-
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_02_tick_ms = TICK_MS;
+
 void game_02_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_02_loop(uint32_t dt) {
-  game_loop(dt);
+void game_02_update() {
+  game_update();
+}
+
+void game_02_render() {
+  render();
 }
@@ -0,0 +1,22 @@
+// Lava Run state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_02_LAVA_RUN_H
+#define GAME_02_LAVA_RUN_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+
+struct LavaRunState {
+  int playerPos = 0;
+  int targetPos = NUM_LEDS - 1;
+  bool lavaActive[NUM_LEDS];
+  uint32_t lavaTimers[NUM_LEDS];
+  uint32_t tLavaCycle = 0;
+  uint32_t tPlayerMove = 0;
+  bool gameWon = false;
+  bool gameOver = false;
+};
+
+LavaRunState& game_02_state();
+
+#endif // GAME_02_LAVA_RUN_H
@@ -4,13 +4,17 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_03_lava_stealth.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 100;
 static constexpr uint32_t LAVA_ERUPT_MS = 1000;
@@ -19,136 +23,105 @@ static constexpr uint32_t STEALTH_DURATION_MS = 2000;
 static constexpr uint32_t STEALTH_COOLDOWN_MS = 5000;
 static constexpr uint32_t PLAYER_MOVE_MS = 250;
 
-static int playerPos = 0;
-static int targetPos = NUM_LEDS - 1;
-static bool lavaActive[NUM_LEDS];
-static uint32_t lavaTimers[NUM_LEDS];
-static bool stealthMode = false;
-static uint32_t stealthTimer = 0;
-static uint32_t stealthCooldown = 0;
-static uint32_t tLavaCycle = 0;
-static uint32_t tPlayerMove = 0;
-static bool gameWon = false;
-static bool gameOver = false;
+static LavaStealthState& s = game_03_state();
 
 static void resetGame() {
-  playerPos = 0;
-  targetPos = NUM_LEDS - 1;
+  s.playerPos = 0;
+  s.targetPos = NUM_LEDS - 1;
   for (int i = 0; i < NUM_LEDS; i++) {
-    lavaActive[i] = false;
-    lavaTimers[i] = 0;
+    s.lavaActive[i] = false;
+    s.lavaTimers[i] = 0;
   }
-  stealthMode = false;
-  stealthTimer = 0;
-  stealthCooldown = 0;
-  tLavaCycle = 0;
-  tPlayerMove = 0;
-  gameWon = false;
-  gameOver = false;
-  FastLED.clear();
-  FastLED.show();
+  s.stealthMode = false;
+  s.stealthTimer = 0;
+  s.stealthCooldown = 0;
+  s.tLavaCycle = 0;
+  s.tPlayerMove = 0;
+  s.gameWon = false;
+  s.gameOver = false;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
-static void flashWin() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Green);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
-}
+// Flash three times, then hold dark for a second before the next round
+static const FlashEffect WIN_FLASH = {CRGB::Green, 3, 150, 150, 1000};
+static const FlashEffect GAME_OVER_FLASH = {CRGB::Red, 3, 150, 150, 1000};
 
-static void flashGameOver() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Red);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
+// Runs when the win / game over flash finishes
+static void restartGame() {
+  resetGame();
+#ifdef ENABLE_NETWORKING
+  status_monitor_update_state(GAME_STATE_PLAYING);
+#endif
 }
 
 static void updateLava() {
   for (int i = 1; i < NUM_LEDS - 1; i++) {
-    if (lavaTimers[i] > 0) {
-      lavaTimers[i] -= TICK_MS;
-      if (lavaTimers[i] <= 0) {
-        lavaActive[i] = !lavaActive[i];
-        if (lavaActive[i]) {
-          lavaTimers[i] = LAVA_ERUPT_MS;
+    if (s.lavaTimers[i] > 0) {
+      s.lavaTimers[i] -= TICK_MS;
+      if (s.lavaTimers[i] <= 0) {
+        s.lavaActive[i] = !s.lavaActive[i];
+        if (s.lavaActive[i]) {
+          s.lavaTimers[i] = LAVA_ERUPT_MS;
         } else {
-          lavaTimers[i] = LAVA_COOL_MS;
+          s.lavaTimers[i] = LAVA_COOL_MS;
         }
       }
     } else {
-      if ((esp_random() % 3) == 0) {
-        lavaActive[i] = true;
-        lavaTimers[i] = LAVA_ERUPT_MS;
+      if (game_random_below(3) == 0) {
+        s.lavaActive[i] = true;
+        s.lavaTimers[i] = LAVA_ERUPT_MS;
       } else {
-        lavaActive[i] = false;
-        lavaTimers[i] = LAVA_COOL_MS;
+        s.lavaActive[i] = false;
+        s.lavaTimers[i] = LAVA_COOL_MS;
       }
     }
   }
 }
 
 static void updateStealth() {
-  if (stealthMode) {
-    if (stealthTimer > TICK_MS) {
-      stealthTimer -= TICK_MS;
+  if (s.stealthMode) {
+    if (s.stealthTimer > TICK_MS) {
+      s.stealthTimer -= TICK_MS;
     } else {
-      stealthMode = false;
-      stealthTimer = 0;
-      stealthCooldown = STEALTH_COOLDOWN_MS;
+      s.stealthMode = false;
+      s.stealthTimer = 0;
+      s.stealthCooldown = STEALTH_COOLDOWN_MS;
     }
   } else {
-    if (stealthCooldown > TICK_MS) {
-      stealthCooldown -= TICK_MS;
+    if (s.stealthCooldown > TICK_MS) {
+      s.stealthCooldown -= TICK_MS;
     }
   }
 
   // Activate stealth on button press (when cooldown ready)
-  if (touch_alt_just_pressed() && stealthCooldown == 0 && !stealthMode) {
-    stealthMode = true;
-    stealthTimer = STEALTH_DURATION_MS;
+  if (touch_alt_just_pressed() && s.stealthCooldown == 0 && !s.stealthMode) {
+    s.stealthMode = true;
+    s.stealthTimer = STEALTH_DURATION_MS;
   }
 }
 
 static void updatePlayer() {
   // Move based on input
-  if (touch_action_just_pressed() && playerPos < targetPos) {
-    playerPos++;
+  if (touch_action_just_pressed() && s.playerPos < s.targetPos) {
+    s.playerPos++;
   }
 }
 
 static void checkGameState() {
-  if (playerPos == targetPos && !gameWon) {
-    gameWon = true;
+  if (s.playerPos == s.targetPos && !s.gameWon) {
+    s.gameWon = true;
 #ifdef ENABLE_NETWORKING
     status_monitor_update_state(GAME_STATE_WON);
 #endif
-    flashWin();
-    delay(1000);
-    resetGame();
-#ifdef ENABLE_NETWORKING
-    status_monitor_update_state(GAME_STATE_PLAYING);
-#endif
+    effect_sequencer_play(WIN_FLASH, restartGame);
   }
 
-  if (lavaActive[playerPos] && !stealthMode && !gameOver) {
-    gameOver = true;
+  if (s.lavaActive[s.playerPos] && !s.stealthMode && !s.gameOver) {
+    s.gameOver = true;
 #ifdef ENABLE_NETWORKING
     status_monitor_update_state(GAME_STATE_GAME_OVER);
 #endif
-    flashGameOver();
-    delay(1000);
-    resetGame();
-#ifdef ENABLE_NETWORKING
-    status_monitor_update_state(GAME_STATE_PLAYING);
-#endif
+    effect_sequencer_play(GAME_OVER_FLASH, restartGame);
   }
 }
 
@@ -156,10 +129,11 @@ static void render() {
   fadeToBlackBy(leds, NUM_LEDS, 150);
 
   // Render lava zones
+  uint8_t intensity = 128 + (sin(millis() / 50.0) * 127);
+  CRGB lava(intensity, intensity / 4, 0);
   for (int i = 0; i < NUM_LEDS; i++) {
-    if (lavaActive[i]) {
-      uint8_t intensity = 128 + (sin(millis() / 50.0) * 127);
-      leds[i] = CRGB(intensity, intensity / 4, 0);
+    if (s.lavaActive[i]) {
+      leds[i] = lava;
     }
   }
 
@@ -167,27 +141,26 @@ static void render() {
   leds[0] = CRGB::Green;
 
   // Render end (blue)
-  leds[targetPos] = CRGB::Blue;
+  leds[s.targetPos] = CRGB::Blue;
 
   // Render player
-  if (stealthMode) {
+  if (s.stealthMode) {
     // Cyan when in stealth
-    leds[playerPos] = CRGB::Cyan;
+    leds[s.playerPos] = CRGB::Cyan;
   } else {
-    leds[playerPos] = CRGB::White;
+    leds[s.playerPos] = CRGB::White;
   }
 
   // Stealth cooldown indicator on first LED
-  if (stealthCooldown > 0) {
-    uint8_t cd = (uint8_t)((stealthCooldown * 255) / STEALTH_COOLDOWN_MS);
+  if (s.stealthCooldown > 0) {
+    uint8_t cd = (uint8_t)((s.stealthCooldown * 255) / STEALTH_COOLDOWN_MS);
     leds[0] += CRGB(0, 0, cd);
   }
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("Lava Stealth (8 LEDs) on GPIO 16");
+  Serial.println("Lava Stealth " LED_STRIP_BANNER);
   Serial.println("Action touch: move forward, Alt touch: activate stealth");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("Lava Stealth");
@@ -195,44 +168,35 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  if (gameWon || gameOver) return;
-
-  static uint32_t accum = 0;
-  accum += dt;
+static void game_update() {
+  if (s.gameWon || s.gameOver) return;
 
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
+  s.tLavaCycle += TICK_MS;
+  s.tPlayerMove += TICK_MS;
 
-    tLavaCycle += TICK_MS;
-    tPlayerMove += TICK_MS;
+  updateLava();
+  updateStealth();
 
-    updateLava();
-    updateStealth();
-
-    if (tPlayerMove >= PLAYER_MOVE_MS) {
-      tPlayerMove = 0;
-      updatePlayer();
-    }
-
-    checkGameState();
-    render();
+  if (s.tPlayerMove >= PLAYER_MOVE_MS) {
+    s.tPlayerMove = 0;
+    updatePlayer();
   }
 
-  FastLED.show();
+  checkGameState();
 }
 
-
-
-
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_03_tick_ms = TICK_MS;
+
 void game_03_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_03_loop(uint32_t dt) {
-  game_loop(dt);
+void game_03_update() {
+  game_update();
+}
+
+void game_03_render() {
+  render();
 }
@@ -0,0 +1,25 @@
+// Lava Stealth state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_03_LAVA_STEALTH_H
+#define GAME_03_LAVA_STEALTH_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+
+struct LavaStealthState {
+  int playerPos = 0;
+  int targetPos = NUM_LEDS - 1;
+  bool lavaActive[NUM_LEDS];
+  uint32_t lavaTimers[NUM_LEDS];
+  bool stealthMode = false;
+  uint32_t stealthTimer = 0;
+  uint32_t stealthCooldown = 0;
+  uint32_t tLavaCycle = 0;
+  uint32_t tPlayerMove = 0;
+  bool gameWon = false;
+  bool gameOver = false;
+};
+
+LavaStealthState& game_03_state();
+
+#endif // GAME_03_LAVA_STEALTH_H
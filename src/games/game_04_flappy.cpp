@@ -4,142 +4,116 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_04_flappy.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "object_pool.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 50;
-static constexpr uint32_t OBSTACLE_SPAWN_MS = 1500;
-static constexpr uint32_t OBSTACLE_MOVE_MS = 200;
 static constexpr uint32_t GRAVITY_MS = 150;
 static constexpr int GAP_SIZE = 2;
 
-struct Obstacle {
-  bool active = false;
-  int pos = 0;
-  int gapTop = 0;  // Top of gap
-};
-
-static int birdPos = NUM_LEDS / 2;
-static int birdVel = 0;  // Velocity: positive = down, negative = up
-static Obstacle obstacles[2];
-static uint32_t score = 0;
-static uint32_t tObstacleSpawn = 0;
-static uint32_t tObstacleMove = 0;
-static uint32_t tGravity = 0;
-static bool gameOver = false;
+typedef FlappyState::Obstacle Obstacle;
+
+static FlappyState& s = game_04_state();
 
 static void resetGame() {
-  birdPos = NUM_LEDS / 2;
-  birdVel = 0;
-  for (int i = 0; i < 2; i++) obstacles[i] = Obstacle{};
-  score = 0;
-  tObstacleSpawn = tObstacleMove = tGravity = 0;
-  gameOver = false;
-  FastLED.clear();
-  FastLED.show();
+  s.birdPos = NUM_LEDS / 2;
+  s.birdVel = 0;
+  s.obstacles.clear();
+  s.score = 0;
+  s.tObstacleSpawn = s.tObstacleMove = s.tGravity = 0;
+  s.gameOver = false;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
-static void flashGameOver() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Red);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
+static const FlashEffect GAME_OVER_FLASH = {CRGB::Red, 3, 150, 150, 0};
+
+// Runs when the game over flash finishes
+static void restartGame() {
+  resetGame();
+#ifdef ENABLE_NETWORKING
+  status_monitor_update_state(GAME_STATE_PLAYING);
+  status_monitor_update_score(0);
+#endif
 }
 
 static void spawnObstacle() {
-  for (int i = 0; i < 2; i++) {
-    if (!obstacles[i].active) {
-      obstacles[i].active = true;
-      obstacles[i].pos = NUM_LEDS - 1;
-      // Random gap position
-      obstacles[i].gapTop = 2 + (esp_random() % (NUM_LEDS - GAP_SIZE - 2));
-      return;
-    }
-  }
+  Obstacle* obstacle = s.obstacles.acquire();
+  if (!obstacle) return;
+  obstacle->pos = NUM_LEDS - 1;
+  // Random gap position
+  obstacle->gapTop = 2 + game_random_below(NUM_LEDS - GAP_SIZE - 2);
 }
 
 static void updateBird() {
   // Apply gravity
-  birdVel += 1;  // Gravity pulls down
+  s.birdVel += 1;  // Gravity pulls down
 
   // Flap on button press
   if (touch_action_just_pressed()) {
-    birdVel -= 3;
+    s.birdVel -= 3;
   }
 
-  birdPos += birdVel;
+  s.birdPos += s.birdVel;
 
   // Boundary check
-  if (birdPos < 0) {
-    birdPos = 0;
-    birdVel = 0;
+  if (s.birdPos < 0) {
+    s.birdPos = 0;
+    s.birdVel = 0;
   }
-  if (birdPos >= NUM_LEDS) {
-    birdPos = NUM_LEDS - 1;
-    birdVel = 0;
+  if (s.birdPos >= NUM_LEDS) {
+    s.birdPos = NUM_LEDS - 1;
+    s.birdVel = 0;
   }
 }
 
 static void updateObstacles() {
-  for (int i = 0; i < 2; i++) {
-    if (!obstacles[i].active) continue;
+  for (int i = s.obstacles.size() - 1; i >= 0; i--) {
+    s.obstacles[i].pos--;
 
-    obstacles[i].pos--;
-
-    if (obstacles[i].pos < 0) {
-      obstacles[i].active = false;
-      score++;
+    if (s.obstacles[i].pos < 0) {
+      s.obstacles.releaseAt(i);
+      s.score++;
 #ifdef ENABLE_NETWORKING
-      status_monitor_update_score(score);
+      status_monitor_update_score(s.score);
 #endif
     }
   }
 }
 
 static void checkCollisions() {
-  if (gameOver) return;
+  if (s.gameOver) return;
 
   // Check boundary collisions
-  if (birdPos <= 0 || birdPos >= NUM_LEDS - 1) {
-    gameOver = true;
+  if (s.birdPos <= 0 || s.birdPos >= NUM_LEDS - 1) {
+    s.gameOver = true;
 #ifdef ENABLE_NETWORKING
     status_monitor_update_state(GAME_STATE_GAME_OVER);
 #endif
-    flashGameOver();
-    resetGame();
-#ifdef ENABLE_NETWORKING
-    status_monitor_update_state(GAME_STATE_PLAYING);
-    status_monitor_update_score(0);
-#endif
+    effect_sequencer_play(GAME_OVER_FLASH, restartGame);
     return;
   }
 
   // Check obstacle collisions
-  for (int i = 0; i < 2; i++) {
-    if (!obstacles[i].active) continue;
-    if (obstacles[i].pos != 0) continue;  // Only check when obstacle is at bird position
+  for (int i = 0; i < s.obstacles.size(); i++) {
+    if (s.obstacles[i].pos != 0) continue;  // Only check when obstacle is at bird position
 
-    int gapBottom = obstacles[i].gapTop + GAP_SIZE;
-    if (birdPos < obstacles[i].gapTop || birdPos >= gapBottom) {
-      gameOver = true;
+    int gapBottom = s.obstacles[i].gapTop + GAP_SIZE;
+    if (s.birdPos < s.obstacles[i].gapTop || s.birdPos >= gapBottom) {
+      s.gameOver = true;
 #ifdef ENABLE_NETWORKING
       status_monitor_update_state(GAME_STATE_GAME_OVER);
 #endif
-      flashGameOver();
-      resetGame();
-#ifdef ENABLE_NETWORKING
-      status_monitor_update_state(GAME_STATE_PLAYING);
-      status_monitor_update_score(0);
-#endif
+      effect_sequencer_play(GAME_OVER_FLASH, restartGame);
       return;
     }
   }
@@ -149,31 +123,23 @@ static void render() {
   fadeToBlackBy(leds, NUM_LEDS, 120);
 
   // Render obstacles
-  for (int i = 0; i < 2; i++) {
-    if (!obstacles[i].active) continue;
-
-    int gapBottom = obstacles[i].gapTop + GAP_SIZE;
-    for (int j = 0; j < NUM_LEDS; j++) {
-      if (j < obstacles[i].gapTop || j >= gapBottom) {
-        if (obstacles[i].pos >= 0 && obstacles[i].pos < NUM_LEDS) {
-          leds[obstacles[i].pos] = CRGB::Red;
-        }
-      }
+  for (int i = 0; i < s.obstacles.size(); i++) {
+    if (s.obstacles[i].pos >= 0 && s.obstacles[i].pos < NUM_LEDS) {
+      leds[s.obstacles[i].pos] = CRGB::Red;
     }
   }
 
   // Render bird (yellow)
-  leds[birdPos] = CRGB::Yellow;
+  leds[s.birdPos] = CRGB::Yellow;
 
   // Score indicator
-  uint8_t brightness = (uint8_t)min<uint32_t>(score * 10, 255);
+  uint8_t brightness = (uint8_t)min<uint32_t>(s.score * 10, 255);
   leds[NUM_LEDS - 1] += CRGB(0, brightness, 0);
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("FlappyBird (8 LEDs) on GPIO 16");
+  Serial.println("FlappyBird " LED_STRIP_BANNER);
   Serial.println("Action touch: flap/jump");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("FlappyBird");
@@ -182,52 +148,43 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  if (gameOver) return;
-
-  static uint32_t accum = 0;
-  accum += dt;
+static void game_update() {
+  if (s.gameOver) return;
 
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
+  s.tObstacleSpawn += TICK_MS;
+  s.tObstacleMove += TICK_MS;
+  s.tGravity += TICK_MS;
 
-    tObstacleSpawn += TICK_MS;
-    tObstacleMove += TICK_MS;
-    tGravity += TICK_MS;
-
-    if (tObstacleSpawn >= OBSTACLE_SPAWN_MS) {
-      tObstacleSpawn = 0;
-      spawnObstacle();
-    }
-
-    if (tObstacleMove >= OBSTACLE_MOVE_MS) {
-      tObstacleMove = 0;
-      updateObstacles();
-    }
+  if (s.tObstacleSpawn >= OBSTACLE_SPAWN_MS) {
+    s.tObstacleSpawn = 0;
+    spawnObstacle();
+  }
 
-    if (tGravity >= GRAVITY_MS) {
-      tGravity = 0;
-      updateBird();
-    }
+  if (s.tObstacleMove >= OBSTACLE_MOVE_MS) {
+    s.tObstacleMove = 0;
+    updateObstacles();
+  }
 
-    checkCollisions();
-    render();
+  if (s.tGravity >= GRAVITY_MS) {
+    s.tGravity = 0;
+    updateBird();
   }
 
-  FastLED.show();
+  checkCollisions();
 }
 
-
-
-
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_04_tick_ms = TICK_MS;
+
 void game_04_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_04_loop(uint32_t dt) {
-  game_loop(dt);
+void game_04_update() {
+  game_update();
+}
+
+void game_04_render() {
+  render();
 }
@@ -0,0 +1,33 @@
+// FlappyBird state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_04_FLAPPY_H
+#define GAME_04_FLAPPY_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+#include "object_pool.h"
+
+static constexpr uint32_t OBSTACLE_SPAWN_MS = 1500;
+static constexpr uint32_t OBSTACLE_MOVE_MS = 200;
+// Obstacles alive at once: strip crossing time / spawn interval (2 on 8 LEDs)
+static constexpr uint16_t MAX_OBSTACLES = NUM_LEDS * OBSTACLE_MOVE_MS / OBSTACLE_SPAWN_MS + 1;
+
+struct FlappyState {
+  struct Obstacle {
+    int pos = 0;
+    int gapTop = 0;  // Top of gap
+  };
+
+  int birdPos = NUM_LEDS / 2;
+  int birdVel = 0;  // Velocity: positive = down, negative = up
+  ObjectPool<Obstacle, MAX_OBSTACLES> obstacles;
+  uint32_t score = 0;
+  uint32_t tObstacleSpawn = 0;
+  uint32_t tObstacleMove = 0;
+  uint32_t tGravity = 0;
+  bool gameOver = false;
+};
+
+FlappyState& game_04_state();
+
+#endif // GAME_04_FLAPPY_H
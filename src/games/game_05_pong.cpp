@@ -4,65 +4,60 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_05_pong.h"
+#include "game_arena.h"
+#include "game_random.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 50;
 static constexpr uint32_t BALL_MOVE_MS = 100;
 static constexpr uint32_t AI_MOVE_MS = 150;
 
-static int playerPaddle = 0;
-static int aiPaddle = NUM_LEDS - 1;
-static int ballPos = NUM_LEDS / 2;
-static int ballDir = 1;  // +1 right, -1 left
-static uint32_t playerScore = 0;
-static uint32_t aiScore = 0;
-static uint32_t tBallMove = 0;
-static uint32_t tAiMove = 0;
+static PongState& s = game_05_state();
 
 static void resetGame() {
-  playerPaddle = 0;
-  aiPaddle = NUM_LEDS - 1;
-  ballPos = NUM_LEDS / 2;
-  ballDir = (esp_random() & 1) ? 1 : -1;
-  tBallMove = tAiMove = 0;
-  FastLED.clear();
-  FastLED.show();
+  s.playerPaddle = 0;
+  s.aiPaddle = NUM_LEDS - 1;
+  s.ballPos = NUM_LEDS / 2;
+  s.ballDir = (game_random() & 1) ? 1 : -1;
+  s.tBallMove = s.tAiMove = 0;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
 static void updateBall() {
-  ballPos += ballDir;
+  s.ballPos += s.ballDir;
 
   // Collision with player paddle
-  if (ballPos == playerPaddle && ballDir < 0) {
-    ballDir = 1;  // Bounce right
-    ballPos = playerPaddle + 1;
+  if (s.ballPos == s.playerPaddle && s.ballDir < 0) {
+    s.ballDir = 1;  // Bounce right
+    s.ballPos = s.playerPaddle + 1;
   }
 
   // Collision with AI paddle
-  if (ballPos == aiPaddle && ballDir > 0) {
-    ballDir = -1;  // Bounce left
-    ballPos = aiPaddle - 1;
+  if (s.ballPos == s.aiPaddle && s.ballDir > 0) {
+    s.ballDir = -1;  // Bounce left
+    s.ballPos = s.aiPaddle - 1;
   }
 
   // Score points
-  if (ballPos < 0) {
-    aiScore++;
+  if (s.ballPos < 0) {
+    s.aiScore++;
 #ifdef ENABLE_NETWORKING
-    status_monitor_update_score(playerScore);  // Report player score
+    status_monitor_update_score(s.playerScore);  // Report player score
 #endif
     resetGame();
     return;
   }
-  if (ballPos >= NUM_LEDS) {
-    playerScore++;
+  if (s.ballPos >= NUM_LEDS) {
+    s.playerScore++;
 #ifdef ENABLE_NETWORKING
-    status_monitor_update_score(playerScore);
+    status_monitor_update_score(s.playerScore);
 #endif
     resetGame();
     return;
@@ -71,10 +66,10 @@ static void updateBall() {
 
 static void updateAI() {
   // Simple AI: move toward ball
-  if (ballPos > aiPaddle && aiPaddle > 0) {
-    aiPaddle--;
-  } else if (ballPos < aiPaddle && aiPaddle < NUM_LEDS - 1) {
-    aiPaddle++;
+  if (s.ballPos > s.aiPaddle && s.aiPaddle > 0) {
+    s.aiPaddle--;
+  } else if (s.ballPos < s.aiPaddle && s.aiPaddle < NUM_LEDS - 1) {
+    s.aiPaddle++;
   }
 }
 
@@ -82,34 +77,33 @@ static void render() {
   fadeToBlackBy(leds, NUM_LEDS, 200);
 
   // Render player paddle (green)
-  leds[playerPaddle] = CRGB::Green;
+  leds[s.playerPaddle] = CRGB::Green;
 
   // Render AI paddle (red)
-  leds[aiPaddle] = CRGB::Red;
+  leds[s.aiPaddle] = CRGB::Red;
 
   // Render ball (white)
-  if (ballPos >= 0 && ballPos < NUM_LEDS) {
-    leds[ballPos] = CRGB::White;
+  if (s.ballPos >= 0 && s.ballPos < NUM_LEDS) {
+    leds[s.ballPos] = CRGB::White;
   }
 
   // Score indicators
   // Player score on left side
-  if (playerScore > 0) {
-    uint8_t pBright = (uint8_t)min<uint32_t>(playerScore * 30, 255);
+  if (s.playerScore > 0) {
+    uint8_t pBright = (uint8_t)min<uint32_t>(s.playerScore * 30, 255);
     leds[0] += CRGB(0, pBright, 0);
   }
 
   // AI score on right side
-  if (aiScore > 0) {
-    uint8_t aBright = (uint8_t)min<uint32_t>(aiScore * 30, 255);
+  if (s.aiScore > 0) {
+    uint8_t aBright = (uint8_t)min<uint32_t>(s.aiScore * 30, 255);
     leds[NUM_LEDS - 1] += CRGB(aBright, 0, 0);
   }
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("1D Pong (8 LEDs) on GPIO 16");
+  Serial.println("1D Pong " LED_STRIP_BANNER);
   Serial.println("Left touch: move paddle left, Right touch: move paddle right");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("Pong");
@@ -118,50 +112,41 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  static uint32_t accum = 0;
-  accum += dt;
+static void game_update() {
+  s.tBallMove += TICK_MS;
+  s.tAiMove += TICK_MS;
 
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
-
-    tBallMove += TICK_MS;
-    tAiMove += TICK_MS;
-
-    if (tBallMove >= BALL_MOVE_MS) {
-      tBallMove = 0;
-      updateBall();
-    }
-
-    if (tAiMove >= AI_MOVE_MS) {
-      tAiMove = 0;
-      updateAI();
-    }
+  if (s.tBallMove >= BALL_MOVE_MS) {
+    s.tBallMove = 0;
+    updateBall();
+  }
 
-    // Update player paddle based on input
-    if (touch_left_just_pressed() && playerPaddle > 0) {
-      playerPaddle--;
-    } else if (touch_right_just_pressed() && playerPaddle < NUM_LEDS - 1) {
-      playerPaddle++;
-    }
+  if (s.tAiMove >= AI_MOVE_MS) {
+    s.tAiMove = 0;
+    updateAI();
+  }
 
-    render();
+  // Update player paddle based on input (held: auto-repeat)
+  if (touch_left_repeated() && s.playerPaddle > 0) {
+    s.playerPaddle--;
+  } else if (touch_right_repeated() && s.playerPaddle < NUM_LEDS - 1) {
+    s.playerPaddle++;
   }
 
-  FastLED.show();
 }
 
-
-
-
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_05_tick_ms = TICK_MS;
+
 void game_05_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_05_loop(uint32_t dt) {
-  game_loop(dt);
+void game_05_update() {
+  game_update();
+}
+
+void game_05_render() {
+  render();
 }
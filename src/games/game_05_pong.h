@@ -0,0 +1,22 @@
+// 1D Pong state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_05_PONG_H
+#define GAME_05_PONG_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+
+struct PongState {
+  int playerPaddle = 0;
+  int aiPaddle = NUM_LEDS - 1;
+  int ballPos = NUM_LEDS / 2;
+  int ballDir = 1;  // +1 right, -1 left
+  uint32_t playerScore = 0;
+  uint32_t aiScore = 0;
+  uint32_t tBallMove = 0;
+  uint32_t tAiMove = 0;
+};
+
+PongState& game_05_state();
+
+#endif // GAME_05_PONG_H
@@ -0,0 +1,33 @@
+// RGB Guardian state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_06_RGB_GUARDIAN_H
+#define GAME_06_RGB_GUARDIAN_H
+
+#include <stdint.h>
+#include "color_id.h"
+
+struct RgbGuardianState {
+  struct Enemy {
+    bool active = false;
+    int pos = 0;
+    int dir = 0;
+    ColorId color = C_RED;
+  };
+
+  struct Bullet {
+    bool active = false;
+    int pos = 0;
+    int dir = 0;
+    ColorId color = C_RED;
+  };
+
+  Enemy enemy;
+  Bullet bullet;
+  ColorId weaponColor = C_RED;
+  uint32_t score = 0;
+  uint32_t tSpawn = 0, tEnemyStep = 0, tBulletStep = 0;
+};
+
+RgbGuardianState& game_06_state();
+
+#endif // GAME_06_RGB_GUARDIAN_H
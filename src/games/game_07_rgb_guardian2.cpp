@@ -3,87 +3,53 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_07_rgb_guardian2.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "object_pool.h"
+#include "occupancy_layer.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
-static constexpr int DEF_POS = 3;
+static constexpr int DEF_POS = NUM_LEDS / 2 - 1;  // Defender near the middle
 static constexpr uint32_t TICK_MS = 30;
-static constexpr uint32_t SPAWN_EVERY_MS = 700;
-static constexpr uint32_t ENEMY_STEP_EVERY_MS = 220;
 static constexpr uint32_t BULLET_STEP_EVERY_MS = 120;
-static constexpr int MAX_ENEMIES = 2;
-static constexpr int MAX_BULLETS = 2;
 
-enum ColorId : uint8_t { C_RED=0, C_GREEN=1, C_BLUE=2 };
+typedef RgbGuardian2State::Enemy Enemy;
+typedef RgbGuardian2State::Bullet Bullet;
 
-static CRGB colorFromId(ColorId c) {
-  switch (c) {
-    case C_RED:   return CRGB::Red;
-    case C_GREEN: return CRGB::Green;
-    default:      return CRGB::Blue;
-  }
-}
-
-struct Enemy {
-  bool active = false;
-  int pos = 0;
-  int dir = 0;
-  ColorId color = C_RED;
-};
+static RgbGuardian2State& s = game_07_state();
 
-struct Bullet {
-  bool active = false;
-  int pos = 0;
-  int dir = 0;
-  ColorId color = C_RED;
-};
-
-static Enemy enemies[MAX_ENEMIES];
-static Bullet bullets[MAX_BULLETS];
-static ColorId weaponColor = C_RED;
-static uint32_t score = 0;
-static uint32_t tSpawn = 0, tEnemyStep = 0, tBulletStep = 0;
-
-static ColorId randColor() { return (ColorId)(esp_random() % 3); }
+static ColorId randColor() { return (ColorId)game_random_below(3); }
 
 static void resetGame() {
-  for (int i = 0; i < MAX_ENEMIES; i++) enemies[i] = Enemy{};
-  for (int i = 0; i < MAX_BULLETS; i++) bullets[i] = Bullet{};
-  weaponColor = C_RED;
-  score = 0;
-  tSpawn = tEnemyStep = tBulletStep = 0;
-  FastLED.clear();
-  FastLED.show();
+  s.enemies.clear();
+  s.bullets.clear();
+  s.enemyCells.clear();
+  s.bulletCells.clear();
+  s.weaponColor = C_RED;
+  s.score = 0;
+  s.tSpawn = s.tEnemyStep = s.tBulletStep = 0;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
-static void flashGameOver() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Red);
-    FastLED.show();
-    delay(110);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(110);
-  }
-}
+static const FlashEffect GAME_OVER_FLASH = {CRGB::Red, 3, 110, 110, 0};
 
 static void spawnEnemy() {
-  // Find inactive enemy slot
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (enemies[i].active) continue;
-
-    bool fromLeft = (esp_random() & 1) == 0;
-    enemies[i].active = true;
-    enemies[i].dir = fromLeft ? +1 : -1;
-    enemies[i].pos = fromLeft ? 0 : (NUM_LEDS - 1);
-    enemies[i].color = randColor();
-    return;
-  }
+  Enemy* enemy = s.enemies.acquire();
+  if (!enemy) return;
+
+  bool fromLeft = (game_random() & 1) == 0;
+  enemy->dir = fromLeft ? +1 : -1;
+  enemy->pos = fromLeft ? 0 : (NUM_LEDS - 1);
+  enemy->color = randColor();
+  s.enemyCells.insert(s.enemies.slotOf(enemy), enemy->pos);
 }
 
 static void fireBullet() {
@@ -91,9 +57,8 @@ static void fireBullet() {
   int nearestEnemy = -1;
   int nearestDist = NUM_LEDS;
 
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (!enemies[i].active) continue;
-    int dist = abs(enemies[i].pos - DEF_POS);
+  for (int i = 0; i < s.enemies.size(); i++) {
+    int dist = abs(s.enemies[i].pos - DEF_POS);
     if (dist < nearestDist) {
       nearestDist = dist;
       nearestEnemy = i;
@@ -102,66 +67,88 @@ static void fireBullet() {
 
   if (nearestEnemy < 0) return;
 
-  // Find inactive bullet slot
-  for (int i = 0; i < MAX_BULLETS; i++) {
-    if (bullets[i].active) continue;
+  Bullet* bullet = s.bullets.acquire();
+  if (!bullet) return;
 
-    bullets[i].active = true;
-    bullets[i].pos = DEF_POS;
-    bullets[i].dir = (enemies[nearestEnemy].pos < DEF_POS) ? -1 : +1;
-    bullets[i].color = weaponColor;
-    return;
-  }
+  bullet->pos = DEF_POS;
+  bullet->dir = (s.enemies[nearestEnemy].pos < DEF_POS) ? -1 : +1;
+  bullet->color = s.weaponColor;
+  s.bulletCells.insert(s.bullets.slotOf(bullet), bullet->pos);
 }
 
 static void stepEnemies() {
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (!enemies[i].active) continue;
+  for (int i = s.enemies.size() - 1; i >= 0; i--) {
+    uint16_t id = s.enemies.slotOf(&s.enemies[i]);
+    s.enemies[i].pos += s.enemies[i].dir;
 
-    enemies[i].pos += enemies[i].dir;
-
-    if (enemies[i].pos == DEF_POS) {
-      flashGameOver();
-      resetGame();
+    if (s.enemies[i].pos == DEF_POS) {
+      effect_sequencer_play(GAME_OVER_FLASH, resetGame);
       return;
     }
 
-    if (enemies[i].pos < 0 || enemies[i].pos >= NUM_LEDS) {
-      enemies[i].active = false;
+    if (s.enemies[i].pos < 0 || s.enemies[i].pos >= NUM_LEDS) {
+      s.enemyCells.remove(id);
+      s.enemies.releaseAt(i);
+    } else {
+      s.enemyCells.move(id, s.enemies[i].pos);
     }
   }
 }
 
 static void stepBullets() {
-  for (int i = 0; i < MAX_BULLETS; i++) {
-    if (!bullets[i].active) continue;
-
-    bullets[i].pos += bullets[i].dir;
-    if (bullets[i].pos < 0 || bullets[i].pos >= NUM_LEDS) {
-      bullets[i].active = false;
+  for (int i = s.bullets.size() - 1; i >= 0; i--) {
+    uint16_t id = s.bullets.slotOf(&s.bullets[i]);
+    s.bullets[i].pos += s.bullets[i].dir;
+    if (s.bullets[i].pos < 0 || s.bullets[i].pos >= NUM_LEDS) {
+      s.bulletCells.remove(id);
+      s.bullets.releaseAt(i);
+    } else {
+      s.bulletCells.move(id, s.bullets[i].pos);
     }
   }
 }
 
-static void collisions() {
-  for (int b = 0; b < MAX_BULLETS; b++) {
-    if (!bullets[b].active) continue;
-
-    for (int e = 0; e < MAX_ENEMIES; e++) {
-      if (!enemies[e].active) continue;
-      if (enemies[e].pos != bullets[b].pos) continue;
+// Bullet meets enemy: a matching colour destroys the enemy, the bullet is
+// spent either way
+static void hit(uint16_t bulletId, uint16_t enemyId) {
+  Bullet& bullet = s.bullets.atSlot(bulletId);
+  Enemy& enemy = s.enemies.atSlot(enemyId);
 
-      if (enemies[e].color == bullets[b].color) {
-        enemies[e].active = false;
-        score++;
+  if (enemy.color == bullet.color) {
+    s.enemyCells.remove(enemyId);
+    s.enemies.release(&enemy);
+    s.score++;
 #ifdef ENABLE_NETWORKING
-        status_monitor_update_score(score);
+    status_monitor_update_score(s.score);
 #endif
-      }
-      bullets[b].active = false;
-      break;
+  }
+  s.bulletCells.remove(bulletId);
+  s.bullets.release(&bullet);
+}
+
+static void collisions() {
+  // Bullet and enemy that swapped cells this tick
+  for (int i = s.bullets.size() - 1; i >= 0; i--) {
+    uint16_t b = s.bullets.slotOf(&s.bullets[i]);
+    if (!s.bulletCells.movedThisStep(b)) continue;
+
+    uint16_t e = s.enemyCells.crossing(s.bulletCells.prev[b], s.bulletCells.cell[b]);
+    if (e != OCCUPANCY_NONE) {
+      hit(b, e);
     }
   }
+
+  // Bullet and enemy in the same cell
+  uint16_t c = occupancy_next_overlap(s.bulletCells, s.enemyCells);
+  while (c != OCCUPANCY_NONE) {
+    while (s.bulletCells.occupied(c) && s.enemyCells.occupied(c)) {
+      hit(s.bulletCells.first(c), s.enemyCells.first(c));
+    }
+    c = occupancy_next_overlap(s.bulletCells, s.enemyCells, c + 1);
+  }
+
+  s.bulletCells.endStep();
+  s.enemyCells.endStep();
 }
 
 static void render() {
@@ -169,31 +156,26 @@ static void render() {
 
   // Defender
   leds[DEF_POS] = CRGB(25, 25, 25);
-  leds[DEF_POS] += colorFromId(weaponColor) / 5;
+  leds[DEF_POS] += colorFromId(s.weaponColor) / 5;
 
   // Enemies
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (enemies[i].active) {
-      leds[constrain(enemies[i].pos, 0, NUM_LEDS - 1)] = colorFromId(enemies[i].color);
-    }
+  for (int i = 0; i < s.enemies.size(); i++) {
+    leds[constrain(s.enemies[i].pos, 0, NUM_LEDS - 1)] = colorFromId(s.enemies[i].color);
   }
 
   // Bullets
-  for (int i = 0; i < MAX_BULLETS; i++) {
-    if (bullets[i].active) {
-      leds[constrain(bullets[i].pos, 0, NUM_LEDS - 1)] += colorFromId(bullets[i].color);
-    }
+  for (int i = 0; i < s.bullets.size(); i++) {
+    leds[constrain(s.bullets[i].pos, 0, NUM_LEDS - 1)] += colorFromId(s.bullets[i].color);
   }
 
   // Score
-  uint8_t level = (uint8_t)min<uint32_t>(score * 20, 120);
+  uint8_t level = (uint8_t)min<uint32_t>(s.score * 20, 120);
   leds[NUM_LEDS - 1] += CRGB(0, 0, level);
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("RGB Guardian 2 (8 LEDs) on GPIO 16");
+  Serial.println("RGB Guardian 2 " LED_STRIP_BANNER);
   Serial.println("Left touch: weapon color -, Right touch: weapon color +");
   Serial.println("Action touch: fire bullet");
 #ifdef ENABLE_NETWORKING
@@ -203,62 +185,53 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  static uint32_t accum = 0;
-  accum += dt;
-
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
-
-    tSpawn += TICK_MS;
-    tEnemyStep += TICK_MS;
-    tBulletStep += TICK_MS;
+static void game_update() {
+  s.tSpawn += TICK_MS;
+  s.tEnemyStep += TICK_MS;
+  s.tBulletStep += TICK_MS;
 
-    // Manual weapon color control
-    if (touch_left_just_pressed()) {
-      weaponColor = (ColorId)((weaponColor + 2) % 3);  // Cycle backward
-    } else if (touch_right_just_pressed()) {
-      weaponColor = (ColorId)((weaponColor + 1) % 3);  // Cycle forward
-    }
-
-    if (tSpawn >= SPAWN_EVERY_MS) {
-      tSpawn = 0;
-      spawnEnemy();
-    }
+  // Manual weapon color control
+  if (touch_left_just_pressed()) {
+    s.weaponColor = (ColorId)((s.weaponColor + 2) % 3);  // Cycle backward
+  } else if (touch_right_just_pressed()) {
+    s.weaponColor = (ColorId)((s.weaponColor + 1) % 3);  // Cycle forward
+  }
 
-    // Manual fire only
-    if (touch_action_just_pressed()) {
-      fireBullet();
-    }
+  if (s.tSpawn >= SPAWN_EVERY_MS) {
+    s.tSpawn = 0;
+    spawnEnemy();
+  }
 
-    if (tEnemyStep >= ENEMY_STEP_EVERY_MS) {
-      tEnemyStep = 0;
-      stepEnemies();
-    }
+  // Manual fire only
+  if (touch_action_just_pressed()) {
+    fireBullet();
+  }
 
-    if (tBulletStep >= BULLET_STEP_EVERY_MS) {
-      tBulletStep = 0;
-      stepBullets();
-    }
+  if (s.tEnemyStep >= ENEMY_STEP_EVERY_MS) {
+    s.tEnemyStep = 0;
+    stepEnemies();
+  }
 
-    collisions();
-    render();
+  if (s.tBulletStep >= BULLET_STEP_EVERY_MS) {
+    s.tBulletStep = 0;
+    stepBullets();
   }
 
-  FastLED.show();
+  collisions();
 }
 
-
-
-
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_07_tick_ms = TICK_MS;
+
 void game_07_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_07_loop(uint32_t dt) {
-  game_loop(dt);
+void game_07_update() {
+  game_update();
+}
+
+void game_07_render() {
+  render();
 }
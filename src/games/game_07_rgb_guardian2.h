@@ -0,0 +1,44 @@
+// RGB Guardian 2 state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_07_RGB_GUARDIAN2_H
+#define GAME_07_RGB_GUARDIAN2_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+#include "color_id.h"
+#include "object_pool.h"
+#include "occupancy_layer.h"
+
+static constexpr uint32_t SPAWN_EVERY_MS = 700;
+static constexpr uint32_t ENEMY_STEP_EVERY_MS = 220;
+// Enough for every enemy that can be in flight at once
+// (approach time to the defender / spawn interval); 2 on an 8 LED strip
+static constexpr uint16_t MAX_ENEMIES = (NUM_LEDS / 2) * ENEMY_STEP_EVERY_MS / SPAWN_EVERY_MS + 1;
+static constexpr uint16_t MAX_BULLETS = MAX_ENEMIES;
+
+struct RgbGuardian2State {
+  struct Enemy {
+    int pos = 0;
+    int dir = 0;
+    ColorId color = C_RED;
+  };
+
+  struct Bullet {
+    int pos = 0;
+    int dir = 0;
+    ColorId color = C_RED;
+  };
+
+  ObjectPool<Enemy, MAX_ENEMIES> enemies;
+  ObjectPool<Bullet, MAX_BULLETS> bullets;
+  // Cell occupancy of each pool, keyed by pool slot
+  OccupancyLayer<NUM_LEDS, MAX_ENEMIES> enemyCells;
+  OccupancyLayer<NUM_LEDS, MAX_BULLETS> bulletCells;
+  ColorId weaponColor = C_RED;
+  uint32_t score = 0;
+  uint32_t tSpawn = 0, tEnemyStep = 0, tBulletStep = 0;
+};
+
+RgbGuardian2State& game_07_state();
+
+#endif // GAME_07_RGB_GUARDIAN2_H
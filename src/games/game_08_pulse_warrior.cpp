@@ -4,84 +4,96 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "../input/input_events.h"
+#include "game_08_pulse_warrior.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 50;
 static constexpr uint32_t PULSE_INTERVAL_MS = 800;
 static constexpr uint32_t PULSE_DURATION_MS = 200;
-static constexpr uint32_t TARGET_WINDOW_MS = 150;
+static constexpr uint32_t TARGET_WINDOW_MS = 150;  // Centred on the arrival
+static constexpr uint32_t HIT_ERROR_MS = TARGET_WINDOW_MS / 2;
+// Pulse starts this many LEDs before the target so it can arrive within
+// PULSE_DURATION_MS on any strip length; it then waits there until the
+// window closes
+static constexpr int PULSE_LEAD = PULSE_DURATION_MS / TICK_MS - 1;
 
-static int pulsePos = 0;
-static int targetPos = NUM_LEDS / 2;
-static bool pulseActive = false;
-static uint32_t pulseTimer = 0;
-static uint32_t score = 0;
-static uint32_t combo = 0;
-static uint32_t tPulse = 0;
+static PulseWarriorState& s = game_08_state();
+
+static const FlashEffect HIT_FLASH = {CRGB::Green, 1, 50, 0, 0};
 
 static void resetGame() {
-  pulsePos = 0;
-  targetPos = NUM_LEDS / 2;
-  pulseActive = false;
-  pulseTimer = 0;
-  score = 0;
-  combo = 0;
-  tPulse = 0;
-  FastLED.clear();
-  FastLED.show();
+  s.pulsePos = 0;
+  s.targetPos = NUM_LEDS / 2;
+  s.pulseActive = false;
+  s.score = 0;
+  s.combo = 0;
+  s.tPulse = 0;
+  s.clockMs = 0;
+  s.arrivalMs = 0;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
 static void spawnPulse() {
-  if (pulseActive) return;
+  if (s.pulseActive) return;
 
-  pulseActive = true;
-  pulsePos = 0;
-  pulseTimer = PULSE_DURATION_MS;
-  targetPos = 2 + (esp_random() % (NUM_LEDS - 4));  // Random target, not at edges
+  s.pulseActive = true;
+  s.targetPos = 2 + game_random_below(NUM_LEDS - 4);  // Random target, not at edges
+  s.pulsePos = max(0, s.targetPos - PULSE_LEAD);
+  // One LED per tick, the first at the end of this one
+  s.arrivalMs = s.clockMs + (s.targetPos - s.pulsePos - 1) * TICK_MS;
 }
 
 static void updatePulse() {
-  if (!pulseActive) return;
-
-  pulseTimer -= TICK_MS;
+  if (!s.pulseActive) return;
 
-  if (pulseTimer <= 0) {
-    pulseActive = false;
-    combo = 0;  // Reset combo on miss
+  // Missed once no press in a later tick could be within HIT_ERROR_MS
+  if (s.clockMs >= s.arrivalMs + HIT_ERROR_MS) {
+    s.pulseActive = false;
+    s.combo = 0;  // Reset combo on miss
     return;
   }
 
   // Pulse moves toward target
-  if (pulsePos < targetPos) {
-    pulsePos++;
-  } else if (pulsePos > targetPos) {
-    pulsePos--;
+  if (s.pulsePos < s.targetPos) {
+    s.pulsePos++;
+  } else if (s.pulsePos > s.targetPos) {
+    s.pulsePos--;
   }
 }
 
+// When in this tick the action press came: the middle of its pressPhase
+static uint32_t pressTimeMs() {
+  uint32_t phase = touch_input_press_phase(INPUT_ACTION);
+  return s.clockMs - TICK_MS + (2 * phase + 1) * TICK_MS / (2 * INPUT_PRESS_PHASES);
+}
+
 static void checkHit() {
-  if (!pulseActive) return;
-
-  // Check button press
-  if (touch_action_just_pressed() && pulsePos == targetPos) {
-    // Perfect hit!
-    score += 10 + combo;
-    combo++;
-    pulseActive = false;
+  if (!s.pulseActive || !touch_action_just_pressed()) return;
+
+  // Judged on the press time, not on which tick saw it
+  uint32_t pressMs = pressTimeMs();
+  uint32_t error = pressMs > s.arrivalMs ? pressMs - s.arrivalMs : s.arrivalMs - pressMs;
+  if (error <= HIT_ERROR_MS) {
+    // Up to 5 bonus points for precise timing
+    s.score += 10 + s.combo + (HIT_ERROR_MS - error) / 15;
+    s.combo++;
+    s.pulseActive = false;
 #ifdef ENABLE_NETWORKING
-    status_monitor_update_score(score);
+    status_monitor_update_score(s.score);
 #endif
 
     // Flash success
-    fill_solid(leds, NUM_LEDS, CRGB::Green);
-    FastLED.show();
-    delay(50);
+    effect_sequencer_play(HIT_FLASH, nullptr);
   }
 }
 
@@ -89,32 +101,30 @@ static void render() {
   fadeToBlackBy(leds, NUM_LEDS, 150);
 
   // Render target position (dim white)
-  leds[targetPos] = CRGB(30, 30, 30);
+  leds[s.targetPos] = CRGB(30, 30, 30);
 
   // Render pulse
-  if (pulseActive) {
+  if (s.pulseActive) {
     // Intensity based on proximity to target
-    int dist = abs(pulsePos - targetPos);
-    uint8_t intensity = 255 - (dist * 40);
-    if (intensity > 255) intensity = 255;
+    int dist = abs(s.pulsePos - s.targetPos);
+    uint8_t intensity = (uint8_t)max(0, 255 - dist * 40);
 
-    leds[pulsePos] = CRGB(intensity, intensity / 2, 0);  // Orange pulse
+    leds[s.pulsePos] = CRGB(intensity, intensity / 2, 0);  // Orange pulse
 
     // Highlight when close to target
     if (dist <= 1) {
-      leds[targetPos] = CRGB::Yellow;
+      leds[s.targetPos] = CRGB::Yellow;
     }
   }
 
   // Score/combo indicator
-  uint8_t comboBright = (uint8_t)min<uint32_t>(combo * 20, 255);
+  uint8_t comboBright = (uint8_t)min<uint32_t>(s.combo * 20, 255);
   leds[NUM_LEDS - 1] += CRGB(0, comboBright, comboBright);
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("Pulse Warrior (8 LEDs) on GPIO 16");
+  Serial.println("Pulse Warrior " LED_STRIP_BANNER);
   Serial.println("Action touch: hit when pulse reaches target");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("Pulse Warrior");
@@ -123,39 +133,32 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  static uint32_t accum = 0;
-  accum += dt;
-
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
+static void game_update() {
+  s.clockMs += TICK_MS;
+  s.tPulse += TICK_MS;
 
-    tPulse += TICK_MS;
-
-    if (tPulse >= PULSE_INTERVAL_MS) {
-      tPulse = 0;
-      spawnPulse();
-    }
-
-    updatePulse();
-    checkHit();
-    render();
+  if (s.tPulse >= PULSE_INTERVAL_MS) {
+    s.tPulse = 0;
+    spawnPulse();
   }
 
-  FastLED.show();
+  // Before the pulse moves on: a press just after the arrival still counts
+  checkHit();
+  updatePulse();
 }
 
-
-
-
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_08_tick_ms = TICK_MS;
+
 void game_08_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_08_loop(uint32_t dt) {
-  game_loop(dt);
+void game_08_update() {
+  game_update();
+}
+
+void game_08_render() {
+  render();
 }
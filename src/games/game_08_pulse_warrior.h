@@ -0,0 +1,22 @@
+// Pulse Warrior state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_08_PULSE_WARRIOR_H
+#define GAME_08_PULSE_WARRIOR_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+
+struct PulseWarriorState {
+  int pulsePos = 0;
+  int targetPos = NUM_LEDS / 2;
+  bool pulseActive = false;
+  uint32_t score = 0;
+  uint32_t combo = 0;
+  uint32_t tPulse = 0;
+  uint32_t clockMs = 0;    // Game time at the end of the current tick
+  uint32_t arrivalMs = 0;  // When the active pulse reaches the target
+};
+
+PulseWarriorState& game_08_state();
+
+#endif // GAME_08_PULSE_WARRIOR_H
@@ -4,154 +4,136 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_09_color_runner.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "object_pool.h"
+#include "occupancy_layer.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 100;
-static constexpr uint32_t ZONE_SPAWN_MS = 1200;
-static constexpr uint32_t ZONE_MOVE_MS = 200;
 static constexpr uint32_t COLOR_CHANGE_MS = 500;
 
-enum ColorId : uint8_t { C_RED=0, C_GREEN=1, C_BLUE=2 };
+typedef ColorRunnerState::Zone Zone;
 
-static CRGB colorFromId(ColorId c) {
-  switch (c) {
-    case C_RED:   return CRGB::Red;
-    case C_GREEN: return CRGB::Green;
-    default:      return CRGB::Blue;
-  }
-}
-
-struct Zone {
-  bool active = false;
-  int pos = 0;
-  ColorId color = C_RED;
-};
-
-static int playerPos = 0;
-static ColorId playerColor = C_RED;
-static Zone zones[3];
-static uint32_t score = 0;
-static uint32_t tZoneSpawn = 0;
-static uint32_t tZoneMove = 0;
-static uint32_t tColorChange = 0;
-static bool gameOver = false;
+static ColorRunnerState& s = game_09_state();
 
 static void resetGame() {
-  playerPos = 0;
-  playerColor = C_RED;
-  for (int i = 0; i < 3; i++) zones[i] = Zone{};
-  score = 0;
-  tZoneSpawn = tZoneMove = tColorChange = 0;
-  gameOver = false;
-  FastLED.clear();
-  FastLED.show();
+  s.playerPos = 0;
+  s.lastPlayerPos = 0;
+  s.playerColor = C_RED;
+  s.zones.clear();
+  s.zoneCells.clear();
+  s.score = 0;
+  s.tZoneSpawn = s.tZoneMove = s.tColorChange = 0;
+  s.gameOver = false;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
 }
 
-static void flashGameOver() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Red);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
-}
+// Flash three times, then hold dark for a second before the next round
+static const FlashEffect GAME_OVER_FLASH = {CRGB::Red, 3, 150, 150, 1000};
+static const FlashEffect WIN_FLASH = {CRGB::Green, 3, 150, 150, 1000};
 
-static void flashWin() {
-  for (int i = 0; i < 3; i++) {
-    fill_solid(leds, NUM_LEDS, CRGB::Green);
-    FastLED.show();
-    delay(150);
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    delay(150);
-  }
+// Runs when the game over / win flash finishes
+static void restartGame() {
+  resetGame();
+#ifdef ENABLE_NETWORKING
+  status_monitor_update_state(GAME_STATE_PLAYING);
+  status_monitor_update_score(0);
+#endif
 }
 
-static ColorId randColor() { return (ColorId)(esp_random() % 3); }
+static ColorId randColor() { return (ColorId)game_random_below(3); }
 
 static void spawnZone() {
-  for (int i = 0; i < 3; i++) {
-    if (!zones[i].active) {
-      zones[i].active = true;
-      zones[i].pos = NUM_LEDS - 1;
-      zones[i].color = randColor();
-      return;
-    }
-  }
+  Zone* zone = s.zones.acquire();
+  if (!zone) return;
+  zone->pos = NUM_LEDS - 1;
+  zone->color = randColor();
+  s.zoneCells.insert(s.zones.slotOf(zone), zone->pos);
 }
 
 static void updateZones() {
-  for (int i = 0; i < 3; i++) {
-    if (!zones[i].active) continue;
-
-    zones[i].pos--;
+  for (int i = s.zones.size() - 1; i >= 0; i--) {
+    uint16_t id = s.zones.slotOf(&s.zones[i]);
+    s.zones[i].pos--;
 
-    if (zones[i].pos < 0) {
-      zones[i].active = false;
-      score++;
+    if (s.zones[i].pos >= 0) {
+      s.zoneCells.move(id, s.zones[i].pos);
+    } else {
+      s.zoneCells.remove(id);
+      s.zones.releaseAt(i);
+      s.score++;
 #ifdef ENABLE_NETWORKING
-      status_monitor_update_score(score);
+      status_monitor_update_score(s.score);
 #endif
     }
   }
 }
 
 static void updatePlayer() {
+  s.lastPlayerPos = s.playerPos;
+
   // Move based on input
-  if (touch_action_just_pressed() && playerPos < NUM_LEDS - 1) {
-    playerPos++;
+  if (touch_action_just_pressed() && s.playerPos < NUM_LEDS - 1) {
+    s.playerPos++;
   }
 
   // Change color on button press
   if (touch_alt_just_pressed()) {
-    playerColor = (ColorId)((playerColor + 1) % 3);
+    s.playerColor = (ColorId)((s.playerColor + 1) % 3);
   }
 }
 
-static void checkCollisions() {
-  if (gameOver) return;
-
-  for (int i = 0; i < 3; i++) {
-    if (!zones[i].active) continue;
-    if (zones[i].pos != playerPos) continue;
+// Player meets a zone; returns false if that ended the run
+static bool enterZone(uint16_t id) {
+  Zone& zone = s.zones.atSlot(id);
 
-    if (zones[i].color != playerColor) {
-      // Wrong color - game over
-      gameOver = true;
+  if (zone.color != s.playerColor) {
+    // Wrong color - game over
+    s.gameOver = true;
 #ifdef ENABLE_NETWORKING
-      status_monitor_update_state(GAME_STATE_GAME_OVER);
+    status_monitor_update_state(GAME_STATE_GAME_OVER);
 #endif
-      flashGameOver();
-      delay(1000);
-      resetGame();
-#ifdef ENABLE_NETWORKING
-      status_monitor_update_state(GAME_STATE_PLAYING);
-      status_monitor_update_score(0);
-#endif
-      return;
-    } else {
-      // Correct color - pass through
-      zones[i].active = false;
-      score += 5;
+    effect_sequencer_play(GAME_OVER_FLASH, restartGame);
+    return false;
+  }
+
+  // Correct color - pass through
+  s.zoneCells.remove(id);
+  s.zones.release(&zone);
+  s.score += 5;
 #ifdef ENABLE_NETWORKING
-      status_monitor_update_score(score);
+  status_monitor_update_score(s.score);
 #endif
-    }
+  return true;
+}
+
+static void checkCollisions() {
+  if (s.gameOver) return;
+
+  // Zone that swapped cells with the player this tick
+  if (s.playerPos != s.lastPlayerPos) {
+    uint16_t id = s.zoneCells.crossing(s.lastPlayerPos, s.playerPos);
+    if (id != OCCUPANCY_NONE && !enterZone(id)) return;
   }
 
+  // Zones in the player's cell
+  while (s.zoneCells.occupied(s.playerPos)) {
+    if (!enterZone(s.zoneCells.first(s.playerPos))) return;
+  }
+  s.zoneCells.endStep();
+
   // Win condition: reach end
-  if (playerPos >= NUM_LEDS - 1) {
-    flashWin();
-    delay(1000);
-    resetGame();
+  if (s.playerPos >= NUM_LEDS - 1) {
+    effect_sequencer_play(WIN_FLASH, resetGame);
   }
 }
 
@@ -159,24 +141,23 @@ static void render() {
   fadeToBlackBy(leds, NUM_LEDS, 120);
 
   // Render zones
-  for (int i = 0; i < 3; i++) {
-    if (zones[i].active && zones[i].pos >= 0 && zones[i].pos < NUM_LEDS) {
-      leds[zones[i].pos] = colorFromId(zones[i].color);
+  for (int i = 0; i < s.zones.size(); i++) {
+    if (s.zones[i].pos >= 0 && s.zones[i].pos < NUM_LEDS) {
+      leds[s.zones[i].pos] = colorFromId(s.zones[i].color);
     }
   }
 
   // Render player
-  leds[playerPos] = colorFromId(playerColor);
+  leds[s.playerPos] = colorFromId(s.playerColor);
 
   // Score indicator
-  uint8_t brightness = (uint8_t)min<uint32_t>(score * 5, 255);
+  uint8_t brightness = (uint8_t)min<uint32_t>(s.score * 5, 255);
   leds[NUM_LEDS - 1] += CRGB(0, brightness, brightness);
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("Color Runner X (8 LEDs) on GPIO 16");
+  Serial.println("Color Runner X " LED_STRIP_BANNER);
   Serial.println("Action touch: move forward, Alt touch: change color");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("Color Runner X");
@@ -185,48 +166,39 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  if (gameOver) return;
-
-  static uint32_t accum = 0;
-  accum += dt;
-
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
+static void game_update() {
+  if (s.gameOver) return;
 
-    tZoneSpawn += TICK_MS;
-    tZoneMove += TICK_MS;
-    tColorChange += TICK_MS;
-
-    if (tZoneSpawn >= ZONE_SPAWN_MS) {
-      tZoneSpawn = 0;
-      spawnZone();
-    }
+  s.tZoneSpawn += TICK_MS;
+  s.tZoneMove += TICK_MS;
+  s.tColorChange += TICK_MS;
 
-    if (tZoneMove >= ZONE_MOVE_MS) {
-      tZoneMove = 0;
-      updateZones();
-    }
+  if (s.tZoneSpawn >= ZONE_SPAWN_MS) {
+    s.tZoneSpawn = 0;
+    spawnZone();
+  }
 
-    updatePlayer();
-    checkCollisions();
-    render();
+  if (s.tZoneMove >= ZONE_MOVE_MS) {
+    s.tZoneMove = 0;
+    updateZones();
   }
 
-  FastLED.show();
+  updatePlayer();
+  checkCollisions();
 }
 
-
-
-
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_09_tick_ms = TICK_MS;
+
 void game_09_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_09_loop(uint32_t dt) {
-  game_loop(dt);
+void game_09_update() {
+  game_update();
+}
+
+void game_09_render() {
+  render();
 }
@@ -0,0 +1,37 @@
+// Color Runner X state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_09_COLOR_RUNNER_H
+#define GAME_09_COLOR_RUNNER_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+#include "color_id.h"
+#include "object_pool.h"
+#include "occupancy_layer.h"
+
+static constexpr uint32_t ZONE_SPAWN_MS = 1200;
+static constexpr uint32_t ZONE_MOVE_MS = 200;
+// Zones alive at once: strip crossing time / spawn interval (2 on 8 LEDs)
+static constexpr uint16_t MAX_ZONES = NUM_LEDS * ZONE_MOVE_MS / ZONE_SPAWN_MS + 1;
+
+struct ColorRunnerState {
+  struct Zone {
+    int pos = 0;
+    ColorId color = C_RED;
+  };
+
+  int playerPos = 0;
+  int lastPlayerPos = 0;  // Position before this tick's move
+  ColorId playerColor = C_RED;
+  ObjectPool<Zone, MAX_ZONES> zones;
+  OccupancyLayer<NUM_LEDS, MAX_ZONES> zoneCells;  // Keyed by pool slot
+  uint32_t score = 0;
+  uint32_t tZoneSpawn = 0;
+  uint32_t tZoneMove = 0;
+  uint32_t tColorChange = 0;
+  bool gameOver = false;
+};
+
+ColorRunnerState& game_09_state();
+
+#endif // GAME_09_COLOR_RUNNER_H
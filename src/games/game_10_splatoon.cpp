@@ -4,144 +4,127 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "../config/led_config.h"
 #include "../input/touch_input.h"
+#include "game_10_splatoon.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "../render/effect_sequencer.h"
 #ifdef ENABLE_NETWORKING
 #include "../status/status_monitor.h"
 #endif
 
 extern CRGB leds[];
-#define NUM_LEDS 8  // Must match main.cpp
 
 static constexpr uint32_t TICK_MS = 100;
 static constexpr uint32_t PAINT_MOVE_MS = 150;
 static constexpr uint32_t GAME_DURATION_MS = 30000;  // 30 seconds
 
-static int playerPos = 0;
-static int opponentPos = NUM_LEDS - 1;
-static uint8_t playerPaint[NUM_LEDS];  // 0 = neutral, 1 = player, 2 = opponent
-static uint32_t playerScore = 0;
-static uint32_t opponentScore = 0;
-static uint32_t gameTimer = 0;
-static bool gameOver = false;
+static SplatoonState& s = game_10_state();
 
 static void resetGame() {
-  playerPos = 0;
-  opponentPos = NUM_LEDS - 1;
+  s.playerPos = 0;
+  s.opponentPos = NUM_LEDS - 1;
   for (int i = 0; i < NUM_LEDS; i++) {
-    playerPaint[i] = 0;  // Neutral
+    s.playerPaint[i] = 0;  // Neutral
   }
-  playerScore = 0;
-  opponentScore = 0;
-  gameTimer = 0;
-  gameOver = false;
-  FastLED.clear();
-  FastLED.show();
+  s.playerScore = 0;
+  s.opponentScore = 0;
+  s.gameTimer = 0;
+  s.gameOver = false;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+}
+
+// Flash five times, then hold dark for a second before the next round
+static const FlashEffect WIN_FLASH = {CRGB::Green, 5, 200, 200, 1000};
+static const FlashEffect LOSE_FLASH = {CRGB::Red, 5, 200, 200, 1000};
+static const FlashEffect TIE_FLASH = {CRGB::Yellow, 5, 200, 200, 1000};
+
+// Runs when the end-of-round flash finishes
+static void restartGame() {
+  resetGame();
+#ifdef ENABLE_NETWORKING
+  status_monitor_update_state(GAME_STATE_PLAYING);
+  status_monitor_update_score(0);
+#endif
 }
 
 static void updatePaint() {
   // Player paints
-  if (playerPos >= 0 && playerPos < NUM_LEDS) {
-    if (playerPaint[playerPos] != 1) {
-      if (playerPaint[playerPos] == 2) {
-        opponentScore--;  // Remove opponent paint
+  if (s.playerPos >= 0 && s.playerPos < NUM_LEDS) {
+    if (s.playerPaint[s.playerPos] != 1) {
+      if (s.playerPaint[s.playerPos] == 2) {
+        s.opponentScore--;  // Remove opponent paint
       }
-      playerPaint[playerPos] = 1;
-      playerScore++;
+      s.playerPaint[s.playerPos] = 1;
+      s.playerScore++;
     }
   }
 
   // Opponent paints (AI)
-  if (opponentPos >= 0 && opponentPos < NUM_LEDS) {
-    if (playerPaint[opponentPos] != 2) {
-      if (playerPaint[opponentPos] == 1) {
-        playerScore--;  // Remove player paint
+  if (s.opponentPos >= 0 && s.opponentPos < NUM_LEDS) {
+    if (s.playerPaint[s.opponentPos] != 2) {
+      if (s.playerPaint[s.opponentPos] == 1) {
+        s.playerScore--;  // Remove player paint
       }
-      playerPaint[opponentPos] = 2;
-      opponentScore++;
+      s.playerPaint[s.opponentPos] = 2;
+      s.opponentScore++;
     }
   }
 }
 
 static void updatePlayer() {
-  // Move based on input
-  if (touch_left_just_pressed() && playerPos > 0) {
-    playerPos--;
-  } else if (touch_right_just_pressed() && playerPos < NUM_LEDS - 1) {
-    playerPos++;
+  // Move based on input (held: auto-repeat)
+  if (touch_left_repeated() && s.playerPos > 0) {
+    s.playerPos--;
+  } else if (touch_right_repeated() && s.playerPos < NUM_LEDS - 1) {
+    s.playerPos++;
   }
 }
 
 static void updateOpponent() {
   // Simple AI: move toward areas with less opponent paint
-  int bestPos = opponentPos;
-  int minPaint = playerPaint[opponentPos];
+  int bestPos = s.opponentPos;
+  int minPaint = s.playerPaint[s.opponentPos];
 
   // Check nearby positions
   for (int i = -1; i <= 1; i++) {
-    int checkPos = opponentPos + i;
+    int checkPos = s.opponentPos + i;
     if (checkPos < 0 || checkPos >= NUM_LEDS) continue;
 
-    if (playerPaint[checkPos] < minPaint ||
-        (playerPaint[checkPos] == minPaint && (esp_random() & 1))) {
+    if (s.playerPaint[checkPos] < minPaint ||
+        (s.playerPaint[checkPos] == minPaint && (game_random() & 1))) {
       bestPos = checkPos;
-      minPaint = playerPaint[checkPos];
+      minPaint = s.playerPaint[checkPos];
     }
   }
 
-  opponentPos = bestPos;
+  s.opponentPos = bestPos;
 }
 
 static void checkGameOver() {
-  if (gameTimer >= GAME_DURATION_MS) {
-    gameOver = true;
+  if (s.gameTimer >= GAME_DURATION_MS) {
+    s.gameOver = true;
 #ifdef ENABLE_NETWORKING
-    if (playerScore > opponentScore) {
+    if (s.playerScore > s.opponentScore) {
       status_monitor_update_state(GAME_STATE_WON);
     } else {
       status_monitor_update_state(GAME_STATE_GAME_OVER);
     }
-    status_monitor_update_score(playerScore);
+    status_monitor_update_score(s.playerScore);
 #endif
 
     // Determine winner
-    if (playerScore > opponentScore) {
+    if (s.playerScore > s.opponentScore) {
       // Player wins - flash green
-      for (int i = 0; i < 5; i++) {
-        fill_solid(leds, NUM_LEDS, CRGB::Green);
-        FastLED.show();
-        delay(200);
-        fill_solid(leds, NUM_LEDS, CRGB::Black);
-        FastLED.show();
-        delay(200);
-      }
-    } else if (opponentScore > playerScore) {
+      effect_sequencer_play(WIN_FLASH, restartGame);
+    } else if (s.opponentScore > s.playerScore) {
       // Opponent wins - flash red
-      for (int i = 0; i < 5; i++) {
-        fill_solid(leds, NUM_LEDS, CRGB::Red);
-        FastLED.show();
-        delay(200);
-        fill_solid(leds, NUM_LEDS, CRGB::Black);
-        FastLED.show();
-        delay(200);
-      }
+      effect_sequencer_play(LOSE_FLASH, restartGame);
     } else {
       // Tie - flash yellow
-      for (int i = 0; i < 5; i++) {
-        fill_solid(leds, NUM_LEDS, CRGB::Yellow);
-        FastLED.show();
-        delay(200);
-        fill_solid(leds, NUM_LEDS, CRGB::Black);
-        FastLED.show();
-        delay(200);
-      }
+      effect_sequencer_play(TIE_FLASH, restartGame);
     }
-
-    delay(1000);
-    resetGame();
-#ifdef ENABLE_NETWORKING
-    status_monitor_update_state(GAME_STATE_PLAYING);
-    status_monitor_update_score(0);
-#endif
   }
 }
 
@@ -150,10 +133,10 @@ static void render() {
 
   // Render painted areas
   for (int i = 0; i < NUM_LEDS; i++) {
-    if (playerPaint[i] == 1) {
+    if (s.playerPaint[i] == 1) {
       // Player paint (green)
       leds[i] = CRGB(0, 128, 0);
-    } else if (playerPaint[i] == 2) {
+    } else if (s.playerPaint[i] == 2) {
       // Opponent paint (red)
       leds[i] = CRGB(128, 0, 0);
     } else {
@@ -163,22 +146,21 @@ static void render() {
   }
 
   // Render player (bright green)
-  leds[playerPos] = CRGB::Green;
+  leds[s.playerPos] = CRGB::Green;
 
   // Render opponent (bright red)
-  leds[opponentPos] = CRGB::Red;
+  leds[s.opponentPos] = CRGB::Red;
 
   // Score indicator - player on left, opponent on right
-  uint8_t pBright = (uint8_t)min<uint32_t>((playerScore * 255) / NUM_LEDS, 255);
-  uint8_t oBright = (uint8_t)min<uint32_t>((opponentScore * 255) / NUM_LEDS, 255);
+  uint8_t pBright = (uint8_t)min<uint32_t>((s.playerScore * 255) / NUM_LEDS, 255);
+  uint8_t oBright = (uint8_t)min<uint32_t>((s.opponentScore * 255) / NUM_LEDS, 255);
   leds[0] += CRGB(0, pBright, 0);
   leds[NUM_LEDS - 1] += CRGB(oBright, 0, 0);
 }
 
 static void game_setup() {
-  randomSeed(esp_random());
   resetGame();
-  Serial.println("1D Splatoon (8 LEDs) on GPIO 16");
+  Serial.println("1D Splatoon " LED_STRIP_BANNER);
   Serial.println("Left touch: move left, Right touch: move right");
 #ifdef ENABLE_NETWORKING
   status_monitor_update_game_name("Splatoon");
@@ -187,35 +169,29 @@ static void game_setup() {
 #endif
 }
 
-static void game_loop(uint32_t dt) {
-  if (gameOver) return;
-
-  static uint32_t accum = 0;
-  accum += dt;
+static void game_update() {
+  if (s.gameOver) return;
 
-  gameTimer += dt;
-
-  while (accum >= TICK_MS) {
-    accum -= TICK_MS;
-
-    updatePlayer();
-    updateOpponent();
-    updatePaint();
-    checkGameOver();
-    render();
-  }
+  s.gameTimer += TICK_MS;
 
-  FastLED.show();
+  updatePlayer();
+  updateOpponent();
+  updatePaint();
+  checkGameOver();
 }
 
-
-
-
 // Wrapper functions for game manager
+extern const uint16_t game_10_tick_ms = TICK_MS;
+
 void game_10_setup() {
+  game_arena_reset(s);
   game_setup();
 }
 
-void game_10_loop(uint32_t dt) {
-  game_loop(dt);
+void game_10_update() {
+  game_update();
+}
+
+void game_10_render() {
+  render();
 }
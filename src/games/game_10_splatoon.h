@@ -0,0 +1,21 @@
+// 1D Splatoon state (lives in the game arena, see game_arena.h)
+
+#ifndef GAME_10_SPLATOON_H
+#define GAME_10_SPLATOON_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+
+struct SplatoonState {
+  int playerPos = 0;
+  int opponentPos = NUM_LEDS - 1;
+  uint8_t playerPaint[NUM_LEDS];  // 0 = neutral, 1 = player, 2 = opponent
+  uint32_t playerScore = 0;
+  uint32_t opponentScore = 0;
+  uint32_t gameTimer = 0;
+  bool gameOver = false;
+};
+
+SplatoonState& game_10_state();
+
+#endif // GAME_10_SPLATOON_H
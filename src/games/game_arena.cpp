@@ -0,0 +1,83 @@
+// Game state arena implementation
+
+#include "game_arena.h"
+#include "game_00_test.h"
+#include "game_01_pacman.h"
+#include "game_02_lava_run.h"
+#include "game_03_lava_stealth.h"
+#include "game_04_flappy.h"
+#include "game_05_pong.h"
+#include "game_06_rgb_guardian.h"
+#include "game_07_rgb_guardian2.h"
+#include "game_08_pulse_warrior.h"
+#include "game_09_color_runner.h"
+#include "game_10_splatoon.h"
+
+// Members are constructed by game_arena_reset(), not here; snapshots copy
+// them as raw bytes
+union GameArena {
+  TestState test;
+  PacmanState pacman;
+  LavaRunState lavaRun;
+  LavaStealthState lavaStealth;
+  FlappyState flappy;
+  PongState pong;
+  RgbGuardianState rgbGuardian;
+  RgbGuardian2State rgbGuardian2;
+  PulseWarriorState pulseWarrior;
+  ColorRunnerState colorRunner;
+  SplatoonState splatoon;
+
+  GameArena() {}
+};
+
+static GameArena arena;
+
+// Indexed by game ID
+static const size_t STATE_SIZES[] = {
+  sizeof(TestState), sizeof(PacmanState), sizeof(LavaRunState),
+  sizeof(LavaStealthState), sizeof(FlappyState), sizeof(PongState),
+  sizeof(RgbGuardianState), sizeof(RgbGuardian2State), sizeof(PulseWarriorState),
+  sizeof(ColorRunnerState), sizeof(SplatoonState)
+};
+
+template <typename... T>
+static constexpr bool allTriviallyCopyable() {
+  return (std::is_trivially_copyable<T>::value && ...);
+}
+static_assert(allTriviallyCopyable<TestState, PacmanState, LavaRunState, LavaStealthState,
+                                   FlappyState, PongState, RgbGuardianState, RgbGuardian2State,
+                                   PulseWarriorState, ColorRunnerState, SplatoonState>(),
+              "Game state must be plain data: snapshots save and restore it with memcpy");
+
+TestState& game_00_state() { return arena.test; }
+PacmanState& game_01_state() { return arena.pacman; }
+LavaRunState& game_02_state() { return arena.lavaRun; }
+LavaStealthState& game_03_state() { return arena.lavaStealth; }
+FlappyState& game_04_state() { return arena.flappy; }
+PongState& game_05_state() { return arena.pong; }
+RgbGuardianState& game_06_state() { return arena.rgbGuardian; }
+RgbGuardian2State& game_07_state() { return arena.rgbGuardian2; }
+PulseWarriorState& game_08_state() { return arena.pulseWarrior; }
+ColorRunnerState& game_09_state() { return arena.colorRunner; }
+SplatoonState& game_10_state() { return arena.splatoon; }
+
+uint8_t* game_arena_data() {
+  return reinterpret_cast<uint8_t*>(&arena);
+}
+
+size_t game_arena_state_size(uint8_t gameId) {
+  return gameId < sizeof(STATE_SIZES) / sizeof(STATE_SIZES[0]) ? STATE_SIZES[gameId] : 0;
+}
+
+size_t game_arena_size() {
+  return sizeof(GameArena);
+}
+
+size_t game_arena_unshared_size() {
+  size_t total = 0;
+  for (size_t size : STATE_SIZES) {
+    total += size;
+  }
+  return total;
+}
@@ -0,0 +1,38 @@
+// Game state arena
+// Only one game runs at a time, so every game's state shares one region
+// sized to the largest game (game_arena.cpp) instead of each keeping its
+// own statics. A game reaches its slot through game_XX_state() and must
+// reset it in game_XX_setup() before touching it: the bytes still hold
+// whichever game ran last.
+
+#ifndef GAME_ARENA_H
+#define GAME_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <type_traits>
+
+// Start a fresh lifetime of the game's state in its slot (all fields back
+// to their initializers, arrays zeroed)
+template <typename T>
+inline void game_arena_reset(T& state) {
+  // The previous occupant is overwritten, never destroyed
+  static_assert(std::is_trivially_destructible<T>::value, "Game state must be trivially destructible");
+  new (&state) T();
+}
+
+// Start of the arena; every game's state struct begins here, so a game's
+// state is the first game_arena_state_size(gameId) bytes (game_snapshot.h)
+uint8_t* game_arena_data();
+
+// Size of a game's state struct (0 for an unknown game)
+size_t game_arena_state_size(uint8_t gameId);
+
+// Bytes reserved for game state (the largest game's)
+size_t game_arena_size();
+
+// Bytes the per-game statics would take (the sum over all games)
+size_t game_arena_unshared_size();
+
+#endif // GAME_ARENA_H
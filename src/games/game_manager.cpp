@@ -1,51 +1,92 @@
 // Game manager implementation
 
 #include "game_manager.h"
+#include "tick_scheduler.h"
+#include "game_random.h"
+#include "game_snapshot.h"
+#include "../input/input_events.h"
+#include "../input/input_recorder.h"
+#include "../render/effect_sequencer.h"
+#include "../render/frame_output.h"
+#include "../status/frame_timing.h"
+#include "../status/input_latency.h"
+#ifdef ENABLE_NETWORKING
+#include "../status/status_monitor.h"
+#endif
 #include <EEPROM.h>
 #include <Arduino.h>
+#include <atomic>
 
 // Forward declarations for all game wrapper functions
+extern const uint16_t game_00_tick_ms;
 extern void game_00_setup();
-extern void game_00_loop(uint32_t dt);
+extern void game_00_update();
+extern void game_00_render();
+extern const uint16_t game_01_tick_ms;
 extern void game_01_setup();
-extern void game_01_loop(uint32_t dt);
+extern void game_01_update();
+extern void game_01_render();
+extern const uint16_t game_02_tick_ms;
 extern void game_02_setup();
-extern void game_02_loop(uint32_t dt);
+extern void game_02_update();
+extern void game_02_render();
+extern const uint16_t game_03_tick_ms;
 extern void game_03_setup();
-extern void game_03_loop(uint32_t dt);
+extern void game_03_update();
+extern void game_03_render();
+extern const uint16_t game_04_tick_ms;
 extern void game_04_setup();
-extern void game_04_loop(uint32_t dt);
+extern void game_04_update();
+extern void game_04_render();
+extern const uint16_t game_05_tick_ms;
 extern void game_05_setup();
-extern void game_05_loop(uint32_t dt);
+extern void game_05_update();
+extern void game_05_render();
+extern const uint16_t game_06_tick_ms;
 extern void game_06_setup();
-extern void game_06_loop(uint32_t dt);
+extern void game_06_update();
+extern void game_06_render();
+extern const uint16_t game_07_tick_ms;
 extern void game_07_setup();
-extern void game_07_loop(uint32_t dt);
+extern void game_07_update();
+extern void game_07_render();
+extern const uint16_t game_08_tick_ms;
 extern void game_08_setup();
-extern void game_08_loop(uint32_t dt);
+extern void game_08_update();
+extern void game_08_render();
+extern const uint16_t game_09_tick_ms;
 extern void game_09_setup();
-extern void game_09_loop(uint32_t dt);
+extern void game_09_update();
+extern void game_09_render();
+extern const uint16_t game_10_tick_ms;
 extern void game_10_setup();
-extern void game_10_loop(uint32_t dt);
+extern void game_10_update();
+extern void game_10_render();
 
-// Game registry - all available games
+// Game registry - all available games (tick rates come from each game's TICK_MS)
 static const GameInfo GAMES[] = {
-  {0, "Test", game_00_setup, game_00_loop},
-  {1, "Pacman", game_01_setup, game_01_loop},
-  {2, "Lava Run", game_02_setup, game_02_loop},
-  {3, "Lava Stealth", game_03_setup, game_03_loop},
-  {4, "FlappyBird", game_04_setup, game_04_loop},
-  {5, "Pong", game_05_setup, game_05_loop},
-  {6, "RGB Guardian", game_06_setup, game_06_loop},
-  {7, "RGB Guardian 2", game_07_setup, game_07_loop},
-  {8, "Pulse Warrior", game_08_setup, game_08_loop},
-  {9, "Color Runner X", game_09_setup, game_09_loop},
-  {10, "Splatoon", game_10_setup, game_10_loop}
+  {0, "Test", game_00_tick_ms, game_00_setup, game_00_update, game_00_render},
+  {1, "Pacman", game_01_tick_ms, game_01_setup, game_01_update, game_01_render},
+  {2, "Lava Run", game_02_tick_ms, game_02_setup, game_02_update, game_02_render},
+  {3, "Lava Stealth", game_03_tick_ms, game_03_setup, game_03_update, game_03_render},
+  {4, "FlappyBird", game_04_tick_ms, game_04_setup, game_04_update, game_04_render},
+  {5, "Pong", game_05_tick_ms, game_05_setup, game_05_update, game_05_render},
+  {6, "RGB Guardian", game_06_tick_ms, game_06_setup, game_06_update, game_06_render},
+  {7, "RGB Guardian 2", game_07_tick_ms, game_07_setup, game_07_update, game_07_render},
+  {8, "Pulse Warrior", game_08_tick_ms, game_08_setup, game_08_update, game_08_render},
+  {9, "Color Runner X", game_09_tick_ms, game_09_setup, game_09_update, game_09_render},
+  {10, "Splatoon", game_10_tick_ms, game_10_setup, game_10_update, game_10_render}
 };
 
 static const uint8_t NUM_GAMES = sizeof(GAMES) / sizeof(GAMES[0]);
 static uint8_t currentGameId = 0;
 static constexpr uint8_t EEPROM_GAME_ID_ADDR = 0;
+static TickScheduler scheduler = {0, 0, 0};
+static uint32_t checkpointAccum = 0;  // Game time since the last RTC checkpoint
+
+// Cross-task switch request (NO_PENDING_GAME = none)
+static constexpr uint8_t NO_PENDING_GAME = 0xFF;
+static std::atomic<uint8_t> pendingGameId{NO_PENDING_GAME};
 
 void game_manager_init() {
   // Initialize EEPROM (1 byte for game ID)
@@ -71,14 +112,61 @@ void game_manager_init() {
   Serial.println(")");
 }
 
+static uint32_t currentScore() {
+#ifdef ENABLE_NETWORKING
+  return status_monitor_get_score();
+#else
+  return 0;
+#endif
+}
+
+// A round that is ending (effect running) restarts anyway, and a replay is
+// a one-off run: neither is worth resuming
+static bool canSuspend() {
+  return !effect_sequencer_is_active() && !input_recorder_is_replaying();
+}
+
+// Carry on with a game whose state and RNG a snapshot just restored
+static void resumeCurrentGame(uint32_t score) {
+  const GameInfo& game = GAMES[currentGameId];
+  tick_scheduler_reset(scheduler, game.tickMs);
+  input_events_skip(millis());
+  touch_input_reset_holds();
+  checkpointAccum = 0;
+  input_recorder_discard(currentGameId);
+
+#ifdef ENABLE_NETWORKING
+  status_monitor_update_game_name(game.name);
+  status_monitor_update_state(GAME_STATE_PLAYING);
+  status_monitor_update_score(score);
+#else
+  (void)score;
+#endif
+
+  // Show the restored state now rather than after the first tick
+  if (game.render) {
+    game.render();
+  }
+  Serial.println("Resumed from snapshot");
+}
+
 bool game_manager_set_game(uint8_t gameId) {
   if (gameId >= NUM_GAMES) {
     return false;
   }
 
   if (currentGameId != gameId) {
+    if (canSuspend()) {
+      game_snapshot_suspend(currentGameId, currentScore(), gameId);
+    }
     currentGameId = gameId;
 
+    // Drop any effect the old game started (its callback would reset the wrong game)
+    effect_sequencer_cancel();
+
+    // A replay belongs to the game it was recorded in
+    input_recorder_stop();
+
     // Save to EEPROM
     EEPROM.write(EEPROM_GAME_ID_ADDR, gameId);
     EEPROM.commit();
@@ -89,15 +177,26 @@ bool game_manager_set_game(uint8_t gameId) {
     Serial.print(GAMES[gameId].name);
     Serial.println(")");
 
-    // Call setup for the new game
-    if (GAMES[gameId].setup) {
-      GAMES[gameId].setup();
+    // Pick up where the new game was left, or start it fresh
+    uint32_t score;
+    if (game_snapshot_resume(gameId, score)) {
+      resumeCurrentGame(score);
+    } else {
+      game_manager_setup();
     }
   }
 
   return true;
 }
 
+bool game_manager_request_game(uint8_t gameId) {
+  if (gameId >= NUM_GAMES) {
+    return false;
+  }
+  pendingGameId.store(gameId, std::memory_order_release);
+  return true;
+}
+
 uint8_t game_manager_get_current_game() {
   return currentGameId;
 }
@@ -120,15 +219,115 @@ const GameInfo* game_manager_get_game_info(uint8_t gameId) {
   return nullptr;
 }
 
+bool game_manager_replay(const InputRecording& recording) {
+  if (recording.gameId >= NUM_GAMES) {
+    return false;
+  }
+
+  // Not persisted to EEPROM: a replay is a one-off run
+  currentGameId = recording.gameId;
+  effect_sequencer_cancel();
+  input_recorder_replay(recording);
+  game_manager_setup();
+  return true;
+}
+
+void game_manager_start() {
+  uint32_t score;
+  if (currentGameId < NUM_GAMES && game_snapshot_resume_checkpoint(currentGameId, score)) {
+    resumeCurrentGame(score);
+  } else {
+    game_manager_setup();
+  }
+}
+
 void game_manager_setup() {
-  if (currentGameId < NUM_GAMES && GAMES[currentGameId].setup) {
+  if (currentGameId >= NUM_GAMES) {
+    return;
+  }
+
+  // New timeline: never replay time (or input) that accrued under another game
+  tick_scheduler_reset(scheduler, GAMES[currentGameId].tickMs);
+  input_events_skip(millis());
+  touch_input_reset_holds();
+  checkpointAccum = 0;
+
+  // A fresh start replaces any suspended run of this game
+  game_snapshot_forget(currentGameId);
+
+  // Hardware entropy only picks the seed; the game itself is deterministic
+  // from here, and the logged seed reproduces the run
+  uint32_t seed = input_recorder_is_replaying() ? input_recorder_get_replay_seed() : esp_random();
+  game_random_seed(seed);
+  input_recorder_begin(currentGameId, seed);
+  Serial.print("Game seed: 0x");
+  Serial.println(seed, HEX);
+
+  if (GAMES[currentGameId].setup) {
     GAMES[currentGameId].setup();
   }
 }
 
 void game_manager_loop(uint32_t dt) {
-  if (currentGameId < NUM_GAMES && GAMES[currentGameId].loop) {
-    GAMES[currentGameId].loop(dt);
+  // Apply switches requested by other tasks here, between frames
+  uint8_t requested = pendingGameId.exchange(NO_PENDING_GAME, std::memory_order_acquire);
+  if (requested != NO_PENDING_GAME) {
+    game_manager_set_game(requested);
+  }
+  input_recorder_service();
+  input_latency_update(currentGameId);
+  uint32_t now = millis();
+
+  // A running effect owns the strip (and the buttons pressed meanwhile);
+  // the game resumes once it finishes
+  if (effect_sequencer_update(dt)) {
+    input_events_skip(now);
+    return;
+  }
+
+  if (currentGameId >= NUM_GAMES || !GAMES[currentGameId].update) {
+    return;
+  }
+
+  const GameInfo& game = GAMES[currentGameId];
+  uint32_t lateMs = tick_scheduler_lateness(scheduler, dt);
+  uint8_t ticks = tick_scheduler_advance(scheduler, dt);
+  if (ticks > 0) {
+    frame_timing_record_tick_latency(currentGameId, lateMs * 1000);
+  }
+  // The last tick due ended accum ago; each tick gets the edges in its window
+  uint32_t tickEndMs = now - scheduler.accum - (ticks > 0 ? (ticks - 1) * game.tickMs : 0);
+  bool advanced = false;
+  for (uint8_t i = 0; i < ticks; i++) {
+    // Stop simulating as soon as a tick hands the strip to an effect
+    if (effect_sequencer_is_active()) {
+      break;
+    }
+    touch_input_set(input_events_tick(tickEndMs, game.tickMs));
+    input_recorder_tick();
+    touch_input_tick(game.tickMs);
+    game.update();
+    advanced = true;
+    tickEndMs += game.tickMs;
+  }
+
+  // Keep a recent copy in RTC memory for a warm reboot to resume
+  checkpointAccum += dt;
+  if (checkpointAccum >= GAME_SNAPSHOT_CHECKPOINT_MS && canSuspend()) {
+    checkpointAccum = 0;
+    game_snapshot_checkpoint(currentGameId, currentScore());
+  }
+
+  // Draw once per frame, and only when the simulation moved
+  if (advanced && game.render && !effect_sequencer_is_active()) {
+    game.render();
   }
+
+  // Skips the transmission when nothing changed
+  frame_output_show();
+}
+
+uint8_t game_manager_get_tick_alpha() {
+  return tick_scheduler_alpha(scheduler);
 }
 
@@ -4,25 +4,40 @@
 
 #include <stdint.h>
 
+struct InputRecording;
+
 // Game function pointer types
 typedef void (*GameSetupFunc)();
-typedef void (*GameLoopFunc)(uint32_t dt);
+typedef void (*GameUpdateFunc)();
+typedef void (*GameRenderFunc)();
 
 // Game information structure
 struct GameInfo {
   uint8_t id;
   const char* name;
+  uint16_t tickMs;        // Fixed simulation step, run by game_manager_loop()
   GameSetupFunc setup;
-  GameLoopFunc loop;
+  GameUpdateFunc update;  // One simulation tick (no drawing)
+  GameRenderFunc render;  // Draw current state into leds[] (once per frame)
 };
 
 // Initialize game manager (loads saved game from EEPROM)
 void game_manager_init();
 
-// Set the current game by ID (0-10)
+// Set the current game by ID (0-10). The old game is suspended into the
+// snapshot cache and the new one resumes from it if cached, else starts fresh
 // Returns true if successful, false if invalid game ID
 bool game_manager_set_game(uint8_t gameId);
 
+// Request a game switch from another task (e.g. the web server on core 0)
+// Applied by the game task at the start of the next game_manager_loop()
+// Returns true if the game ID is valid
+bool game_manager_request_game(uint8_t gameId);
+
+// Restart the recording's game with its seed and feed it the recorded
+// input (game task only). Returns false if the game ID is invalid
+bool game_manager_replay(const InputRecording& recording);
+
 // Get the current game ID
 uint8_t game_manager_get_current_game();
 
@@ -35,11 +50,19 @@ uint8_t game_manager_get_game_count();
 // Get game info by ID (returns nullptr if invalid)
 const GameInfo* game_manager_get_game_info(uint8_t gameId);
 
-// Setup function for current game
+// Start the current game at boot: resumes the RTC checkpoint if a warm
+// reboot interrupted it, else game_manager_setup()
+void game_manager_start();
+
+// Start the current game fresh
 void game_manager_setup();
 
-// Loop function for current game
+// Loop function for current game: runs the fixed ticks owed for dt
+// (at most MAX_TICKS_PER_FRAME), renders once if any tick ran, and shows the frame
 void game_manager_loop(uint32_t dt);
 
+// Fraction of the next tick already elapsed (0-255), for render interpolation
+uint8_t game_manager_get_tick_alpha();
+
 #endif // GAME_MANAGER_H
 
@@ -0,0 +1,33 @@
+// Game random numbers implementation
+
+#include "game_random.h"
+#include "rng.h"
+
+static Pcg32 rng = {0};
+static uint32_t currentSeed = 0;
+
+void game_random_seed(uint32_t seed) {
+  currentSeed = seed;
+  pcg32_seed(rng, seed);
+}
+
+uint32_t game_random_get_seed() {
+  return currentSeed;
+}
+
+Pcg32 game_random_get_state() {
+  return rng;
+}
+
+void game_random_restore(uint32_t seed, const Pcg32& state) {
+  currentSeed = seed;
+  rng = state;
+}
+
+uint32_t game_random() {
+  return pcg32_next(rng);
+}
+
+uint32_t game_random_below(uint32_t bound) {
+  return pcg32_below(rng, bound);
+}
@@ -0,0 +1,30 @@
+// Game random numbers
+// One seedable generator shared by the running game. game_manager seeds it
+// from hardware entropy on every game setup and keeps the seed, so a run
+// can be reproduced by seeding again with the same value.
+
+#ifndef GAME_RANDOM_H
+#define GAME_RANDOM_H
+
+#include <stdint.h>
+#include "rng.h"
+
+// Restart the sequence from seed
+void game_random_seed(uint32_t seed);
+
+// Seed the current sequence started from
+uint32_t game_random_get_seed();
+
+// Generator position, for suspending a game mid-run (game_snapshot.h)
+Pcg32 game_random_get_state();
+
+// Continue a suspended sequence: seed it started from, position reached
+void game_random_restore(uint32_t seed, const Pcg32& state);
+
+// Next 32-bit value
+uint32_t game_random();
+
+// Value in [0, bound)
+uint32_t game_random_below(uint32_t bound);
+
+#endif // GAME_RANDOM_H
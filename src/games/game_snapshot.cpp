@@ -0,0 +1,242 @@
+// Game snapshot implementation
+
+#include "game_snapshot.h"
+#include "game_arena.h"
+#include "game_random.h"
+#include "packbits.h"
+#include <Arduino.h>
+#include <string.h>
+
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x50414E53;  // "SNAP"
+
+// Copied in and out with memcpy: cache entries are not aligned
+struct SnapshotHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t numLeds;
+  uint32_t stateBytes;   // sizeof the game's state struct
+  uint32_t packedBytes;  // PackBits payload that follows the header
+  uint32_t seed;
+  Pcg32 rng;
+  uint32_t score;
+  uint32_t checksum;     // FNV-1a of header (this field zero) and payload
+  uint8_t gameId;
+};
+
+struct CacheEntry {
+  uint8_t gameId;
+  uint32_t offset;
+  uint32_t length;
+  uint32_t lastUsed;
+};
+
+// Entries are kept in pool order, packed from offset 0
+static uint8_t cachePool[GAME_SNAPSHOT_CACHE_BYTES];
+static CacheEntry entries[GAME_SNAPSHOT_SLOTS];
+static uint8_t entryCount = 0;
+static uint32_t cacheUsed = 0;
+static uint32_t useCounter = 0;
+
+#if GAME_SNAPSHOT_RTC_BYTES > 0
+// Left alone by a warm reboot; validated by the header before use
+RTC_NOINIT_ATTR static uint8_t rtcSnapshot[GAME_SNAPSHOT_RTC_BYTES];
+#endif
+
+static uint32_t fnv1a(uint32_t hash, const uint8_t* data, uint32_t length) {
+  for (uint32_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+static uint32_t checksumOf(SnapshotHeader header, const uint8_t* payload) {
+  header.checksum = 0;
+  uint32_t hash = fnv1a(2166136261u, reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+  return fnv1a(hash, payload, header.packedBytes);
+}
+
+uint32_t game_snapshot_capture(uint8_t gameId, uint32_t score, uint8_t* out, uint32_t capacity) {
+  uint32_t stateBytes = (uint32_t)game_arena_state_size(gameId);
+  if (stateBytes == 0 || capacity <= sizeof(SnapshotHeader)) {
+    return 0;
+  }
+
+  uint8_t* payload = out + sizeof(SnapshotHeader);
+  uint32_t packed = packbits_encode(game_arena_data(), stateBytes, payload, capacity - sizeof(SnapshotHeader));
+  if (packed == 0) {
+    return 0;
+  }
+
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));  // Padding is checksummed too
+  header.magic = SNAPSHOT_MAGIC;
+  header.version = GAME_SNAPSHOT_VERSION;
+  header.numLeds = NUM_LEDS;
+  header.stateBytes = stateBytes;
+  header.packedBytes = packed;
+  header.seed = game_random_get_seed();
+  header.rng = game_random_get_state();
+  header.score = score;
+  header.gameId = gameId;
+  header.checksum = checksumOf(header, payload);
+  memcpy(out, &header, sizeof(header));
+  return sizeof(header) + packed;
+}
+
+bool game_snapshot_apply(uint8_t gameId, const uint8_t* snapshot, uint32_t length, uint32_t& score) {
+  if (length < sizeof(SnapshotHeader)) {
+    return false;
+  }
+
+  SnapshotHeader header;
+  memcpy(&header, snapshot, sizeof(header));
+  const uint8_t* payload = snapshot + sizeof(header);
+  if (header.magic != SNAPSHOT_MAGIC || header.version != GAME_SNAPSHOT_VERSION ||
+      header.numLeds != NUM_LEDS || header.gameId != gameId ||
+      header.stateBytes != game_arena_state_size(gameId) ||
+      header.packedBytes > length - sizeof(header) ||
+      header.checksum != checksumOf(header, payload)) {
+    return false;
+  }
+
+  if (!packbits_decode(payload, header.packedBytes, game_arena_data(), header.stateBytes)) {
+    return false;
+  }
+  game_random_restore(header.seed, header.rng);
+  score = header.score;
+  return true;
+}
+
+static int8_t findEntry(uint8_t gameId) {
+  for (uint8_t i = 0; i < entryCount; i++) {
+    if (entries[i].gameId == gameId) {
+      return (int8_t)i;
+    }
+  }
+  return -1;
+}
+
+// Remove an entry and close the gap it leaves in the pool
+static void removeEntry(uint8_t index) {
+  uint32_t offset = entries[index].offset;
+  uint32_t length = entries[index].length;
+  memmove(cachePool + offset, cachePool + offset + length, cacheUsed - offset - length);
+  cacheUsed -= length;
+
+  for (uint8_t i = index; i + 1 < entryCount; i++) {
+    entries[i] = entries[i + 1];
+    entries[i].offset -= length;
+  }
+  entryCount--;
+}
+
+// Returns false if nothing but keepGameId is left to evict
+static bool evictLeastRecent(uint8_t keepGameId) {
+  int8_t oldest = -1;
+  for (uint8_t i = 0; i < entryCount; i++) {
+    if (entries[i].gameId != keepGameId &&
+        (oldest < 0 || entries[i].lastUsed < entries[oldest].lastUsed)) {
+      oldest = (int8_t)i;
+    }
+  }
+  if (oldest < 0) {
+    return false;
+  }
+  removeEntry((uint8_t)oldest);
+  return true;
+}
+
+void game_snapshot_suspend(uint8_t gameId, uint32_t score, uint8_t keepGameId) {
+  int8_t existing = findEntry(gameId);
+  if (existing >= 0) {
+    removeEntry((uint8_t)existing);
+  }
+
+  // Evict until the packed state fits (its size is only known once packed)
+  while (true) {
+    if (entryCount < GAME_SNAPSHOT_SLOTS) {
+      uint32_t length = game_snapshot_capture(gameId, score, cachePool + cacheUsed,
+                                              GAME_SNAPSHOT_CACHE_BYTES - cacheUsed);
+      if (length > 0) {
+        entries[entryCount++] = {gameId, cacheUsed, length, ++useCounter};
+        cacheUsed += length;
+        return;
+      }
+    }
+    if (!evictLeastRecent(keepGameId)) {
+      Serial.println("Game snapshot does not fit the cache");
+      return;
+    }
+  }
+}
+
+bool game_snapshot_resume(uint8_t gameId, uint32_t& score) {
+  int8_t index = findEntry(gameId);
+  if (index < 0) {
+    return false;
+  }
+
+  const CacheEntry& entry = entries[index];
+  bool ok = game_snapshot_apply(gameId, cachePool + entry.offset, entry.length, score);
+  // The run continues from here, so the cached copy is stale either way
+  removeEntry((uint8_t)index);
+  return ok;
+}
+
+void game_snapshot_forget(uint8_t gameId) {
+  int8_t index = findEntry(gameId);
+  if (index >= 0) {
+    removeEntry((uint8_t)index);
+  }
+
+#if GAME_SNAPSHOT_RTC_BYTES > 0
+  SnapshotHeader header;
+  memcpy(&header, rtcSnapshot, sizeof(header));
+  if (header.gameId == gameId) {
+    game_snapshot_clear_checkpoint();
+  }
+#endif
+}
+
+bool game_snapshot_is_cached(uint8_t gameId) {
+  return findEntry(gameId) >= 0;
+}
+
+uint8_t game_snapshot_cached_count() {
+  return entryCount;
+}
+
+void game_snapshot_clear_cache() {
+  entryCount = 0;
+  cacheUsed = 0;
+  useCounter = 0;
+}
+
+void game_snapshot_checkpoint(uint8_t gameId, uint32_t score) {
+#if GAME_SNAPSHOT_RTC_BYTES > 0
+  // A run too large for RTC memory must not leave an older one resumable
+  if (game_snapshot_capture(gameId, score, rtcSnapshot, GAME_SNAPSHOT_RTC_BYTES) == 0) {
+    game_snapshot_clear_checkpoint();
+  }
+#else
+  (void)gameId;
+  (void)score;
+#endif
+}
+
+bool game_snapshot_resume_checkpoint(uint8_t gameId, uint32_t& score) {
+#if GAME_SNAPSHOT_RTC_BYTES > 0
+  return game_snapshot_apply(gameId, rtcSnapshot, GAME_SNAPSHOT_RTC_BYTES, score);
+#else
+  (void)gameId;
+  (void)score;
+  return false;
+#endif
+}
+
+void game_snapshot_clear_checkpoint() {
+#if GAME_SNAPSHOT_RTC_BYTES > 0
+  memset(rtcSnapshot, 0, sizeof(SnapshotHeader));
+#endif
+}
@@ -0,0 +1,79 @@
+// Game snapshots
+// Suspends a game instead of discarding it: the game's arena state
+// (game_arena.h), packed with PackBits, plus its random number position and
+// score. Recently left games wait in a small LRU cache in RAM, so switching
+// back resumes them. The running game is also checkpointed to RTC memory,
+// which survives a warm reboot (crash, watchdog, OTA restart) but not a
+// power cycle.
+//
+// A snapshot is only valid for the firmware that wrote it: the header
+// records GAME_SNAPSHOT_VERSION, NUM_LEDS and the state struct's size, and
+// anything that does not match is rejected in favour of a fresh setup.
+
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include <stdint.h>
+#include "../config/led_config.h"
+
+// Bump whenever a game's state struct changes meaning without changing size
+static constexpr uint16_t GAME_SNAPSHOT_VERSION = 1;
+
+// Most suspended games kept at once
+#ifndef GAME_SNAPSHOT_SLOTS
+#define GAME_SNAPSHOT_SLOTS 4
+#endif
+
+// RAM shared by the cached snapshots; the least recently used are evicted
+// to make room
+#ifndef GAME_SNAPSHOT_CACHE_BYTES
+#define GAME_SNAPSHOT_CACHE_BYTES (1024 + NUM_LEDS * 8)
+#endif
+
+// RTC slow memory for the checkpoint (8KB on the ESP32); 0 disables it
+#ifndef GAME_SNAPSHOT_RTC_BYTES
+#define GAME_SNAPSHOT_RTC_BYTES 4096
+#endif
+
+// How often the running game is checkpointed (game time)
+static constexpr uint32_t GAME_SNAPSHOT_CHECKPOINT_MS = 1000;
+
+// Pack the running game (which must be gameId) into out; returns the bytes
+// written, or 0 if it does not fit in capacity
+uint32_t game_snapshot_capture(uint8_t gameId, uint32_t score, uint8_t* out, uint32_t capacity);
+
+// Load a captured snapshot of gameId into the arena and game_random; false
+// if it is not a valid snapshot of gameId for this build. On false the
+// arena may be partly overwritten, so the game must be set up fresh.
+bool game_snapshot_apply(uint8_t gameId, const uint8_t* snapshot, uint32_t length, uint32_t& score);
+
+// Cache the running game (gameId) so it can be resumed later. keepGameId
+// is the game about to be resumed: its entry is never evicted for room
+void game_snapshot_suspend(uint8_t gameId, uint32_t score, uint8_t keepGameId);
+
+// Restore gameId from the cache and drop the entry; false if not cached
+bool game_snapshot_resume(uint8_t gameId, uint32_t& score);
+
+// Discard any suspended run of gameId, cached or checkpointed (it was
+// restarted fresh)
+void game_snapshot_forget(uint8_t gameId);
+
+// Check if gameId has a cached snapshot
+bool game_snapshot_is_cached(uint8_t gameId);
+
+// Number of cached snapshots
+uint8_t game_snapshot_cached_count();
+
+// Empty the RAM cache
+void game_snapshot_clear_cache();
+
+// Write the running game (gameId) to RTC memory
+void game_snapshot_checkpoint(uint8_t gameId, uint32_t score);
+
+// Restore gameId from the RTC checkpoint; false if there is no valid one
+bool game_snapshot_resume_checkpoint(uint8_t gameId, uint32_t& score);
+
+// Invalidate the RTC checkpoint
+void game_snapshot_clear_checkpoint();
+
+#endif // GAME_SNAPSHOT_H
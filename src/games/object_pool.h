@@ -0,0 +1,117 @@
+// Fixed-capacity object pool for game entities
+// O(1) acquire/release, iteration over live objects only, and handles that
+// detect when their object has been released
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <stdint.h>
+
+// Stable reference to a pooled object; goes stale once the object is released
+struct PoolHandle {
+  uint16_t slot;
+  uint16_t generation;
+};
+
+// Objects never move, so pointers stay valid while the object is live.
+// order[] is a permutation of slot indices: order[0..count) are live (dense,
+// for iteration) and order[count..N) is the free list. index[] maps a slot
+// back to its position in order[], so release is a swap with the last live
+// entry rather than a scan.
+template <typename T, uint16_t N>
+struct ObjectPool {
+  static_assert(N > 0 && N < 0xFFFF, "ObjectPool capacity out of range");
+
+  T slots[N];
+  uint16_t order[N];
+  uint16_t index[N];
+  uint16_t generation[N] = {};
+  uint16_t count = 0;
+
+  ObjectPool() { clear(); }
+
+  static constexpr uint16_t capacity() { return N; }
+  uint16_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == N; }
+
+  // Release every object (invalidates all outstanding handles)
+  void clear() {
+    for (uint16_t i = 0; i < count; i++) {
+      generation[order[i]]++;
+    }
+    for (uint16_t i = 0; i < N; i++) {
+      order[i] = i;
+      index[i] = i;
+    }
+    count = 0;
+  }
+
+  // Take a free object, reset to T{}; nullptr when the pool is full
+  T* acquire() {
+    if (count == N) {
+      return nullptr;
+    }
+    T* obj = &slots[order[count++]];
+    *obj = T{};
+    return obj;
+  }
+
+  // i-th live object, 0 <= i < size(); order changes when objects are released
+  T& operator[](uint16_t i) { return slots[order[i]]; }
+  const T& operator[](uint16_t i) const { return slots[order[i]]; }
+
+  // Release the i-th live object. The last live object moves into position
+  // i, so loops that release while iterating should run from size() - 1 down.
+  void releaseAt(uint16_t i) {
+    releaseSlot(order[i]);
+  }
+
+  // Release by pointer; false if obj is not a live object of this pool
+  bool release(const T* obj) {
+    if (obj < slots || obj >= slots + N) {
+      return false;
+    }
+    uint16_t slot = (uint16_t)(obj - slots);
+    if (index[slot] >= count) {
+      return false;
+    }
+    releaseSlot(slot);
+    return true;
+  }
+
+  // Slot index of an object; fixed for its lifetime, usable as a small id
+  uint16_t slotOf(const T* obj) const {
+    return (uint16_t)(obj - slots);
+  }
+
+  T& atSlot(uint16_t slot) { return slots[slot]; }
+
+  PoolHandle handleOf(const T* obj) const {
+    uint16_t slot = (uint16_t)(obj - slots);
+    return PoolHandle{slot, generation[slot]};
+  }
+
+  // Object behind a handle, or nullptr if it has been released since
+  T* get(PoolHandle h) {
+    if (h.slot >= N || generation[h.slot] != h.generation || index[h.slot] >= count) {
+      return nullptr;
+    }
+    return &slots[h.slot];
+  }
+
+ private:
+  void releaseSlot(uint16_t slot) {
+    uint16_t pos = index[slot];
+    uint16_t last = --count;
+    uint16_t moved = order[last];
+
+    order[pos] = moved;
+    index[moved] = pos;
+    order[last] = slot;
+    index[slot] = last;
+    generation[slot]++;
+  }
+};
+
+#endif // OBJECT_POOL_H
@@ -0,0 +1,139 @@
+// 1D occupancy layer for collision queries
+// One bit per LED says whether any entity of this layer is there; per-cell
+// lists say which. Layers are compared word-at-a-time (AND / popcount)
+// instead of comparing every entity pair.
+
+#ifndef OCCUPANCY_LAYER_H
+#define OCCUPANCY_LAYER_H
+
+#include <stdint.h>
+
+static constexpr uint16_t OCCUPANCY_NONE = 0xFFFF;
+
+// Entities are identified by a small id (e.g. their ObjectPool slot).
+// Each cell keeps a singly linked list of the ids in it; a cell rarely
+// holds more than one, so insert/remove/lookup are effectively O(1).
+template <uint16_t CELLS, uint16_t MAX_IDS>
+struct OccupancyLayer {
+  static constexpr uint16_t WORDS = (CELLS + 31) / 32;
+
+  uint32_t bits[WORDS];
+  uint16_t head[CELLS];     // First id in each cell
+  uint16_t next[MAX_IDS];   // Next id in the same cell
+  uint16_t cell[MAX_IDS];   // Current cell of each id
+  uint16_t prev[MAX_IDS];   // Cell before the last move (swept queries)
+  uint32_t movedStep[MAX_IDS];  // Step of the last move
+  uint32_t step;
+
+  OccupancyLayer() { clear(); }
+
+  void clear() {
+    for (uint16_t w = 0; w < WORDS; w++) bits[w] = 0;
+    for (uint16_t c = 0; c < CELLS; c++) head[c] = OCCUPANCY_NONE;
+    for (uint16_t i = 0; i < MAX_IDS; i++) {
+      cell[i] = OCCUPANCY_NONE;
+      prev[i] = OCCUPANCY_NONE;
+      movedStep[i] = 0;
+    }
+    step = 1;
+  }
+
+  bool occupied(uint16_t c) const {
+    return (bits[c >> 5] >> (c & 31)) & 1;
+  }
+
+  // First id in cell c, or OCCUPANCY_NONE; walk the rest with next[id]
+  uint16_t first(uint16_t c) const {
+    return head[c];
+  }
+
+  // Number of occupied cells
+  uint16_t count() const {
+    uint16_t n = 0;
+    for (uint16_t w = 0; w < WORDS; w++) n += __builtin_popcount(bits[w]);
+    return n;
+  }
+
+  void insert(uint16_t id, uint16_t c) {
+    cell[id] = c;
+    next[id] = head[c];
+    head[c] = id;
+    bits[c >> 5] |= 1u << (c & 31);
+  }
+
+  void remove(uint16_t id) {
+    uint16_t c = cell[id];
+    if (c == OCCUPANCY_NONE) return;
+
+    uint16_t* link = &head[c];
+    while (*link != id) link = &next[*link];
+    *link = next[id];
+    if (head[c] == OCCUPANCY_NONE) {
+      bits[c >> 5] &= ~(1u << (c & 31));
+    }
+    cell[id] = OCCUPANCY_NONE;
+    prev[id] = OCCUPANCY_NONE;
+    movedStep[id] = 0;
+  }
+
+  // Move an id, remembering where it came from for this step
+  void move(uint16_t id, uint16_t c) {
+    uint16_t from = cell[id];
+    if (from == c) return;
+    remove(id);
+    insert(id, c);
+    prev[id] = from;
+    movedStep[id] = step;
+  }
+
+  bool movedThisStep(uint16_t id) const {
+    return movedStep[id] == step;
+  }
+
+  // Id that crossed a mover going from -> to this step (it was at `to`
+  // and is now at `from`), or OCCUPANCY_NONE. Catches entities that
+  // swap cells in one step, which a same-cell check misses.
+  uint16_t crossing(uint16_t from, uint16_t to) const {
+    for (uint16_t id = head[from]; id != OCCUPANCY_NONE; id = next[id]) {
+      if (movedThisStep(id) && prev[id] == to) return id;
+    }
+    return OCCUPANCY_NONE;
+  }
+
+  // Start a new step; earlier moves no longer count for crossing()
+  void endStep() {
+    step++;
+  }
+};
+
+// Number of cells occupied in both layers
+template <uint16_t CELLS, uint16_t A, uint16_t B>
+inline uint16_t occupancy_overlap_count(const OccupancyLayer<CELLS, A>& a,
+                                        const OccupancyLayer<CELLS, B>& b) {
+  uint16_t n = 0;
+  for (uint16_t w = 0; w < OccupancyLayer<CELLS, A>::WORDS; w++) {
+    n += __builtin_popcount(a.bits[w] & b.bits[w]);
+  }
+  return n;
+}
+
+// Lowest cell occupied in both layers at or after `start`, or OCCUPANCY_NONE
+template <uint16_t CELLS, uint16_t A, uint16_t B>
+inline uint16_t occupancy_next_overlap(const OccupancyLayer<CELLS, A>& a,
+                                       const OccupancyLayer<CELLS, B>& b,
+                                       uint16_t start = 0) {
+  if (start >= CELLS) return OCCUPANCY_NONE;
+
+  uint16_t w = start >> 5;
+  uint32_t word = (a.bits[w] & b.bits[w]) & (~0u << (start & 31));
+  for (;;) {
+    if (word) {
+      uint16_t c = (uint16_t)((w << 5) + __builtin_ctz(word));
+      return c < CELLS ? c : OCCUPANCY_NONE;
+    }
+    if (++w >= OccupancyLayer<CELLS, A>::WORDS) return OCCUPANCY_NONE;
+    word = a.bits[w] & b.bits[w];
+  }
+}
+
+#endif // OCCUPANCY_LAYER_H
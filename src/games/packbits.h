@@ -0,0 +1,79 @@
+// PackBits byte compression for game snapshots
+// Game state is mostly zeroed arrays and small repeated values, so byte
+// runs compress well. The stream is a sequence of packets, each starting
+// with a control byte c:
+//   0..127    c + 1 literal bytes follow
+//   129..255  the next byte repeats 257 - c times (3..128)
+//   128       no-op
+
+#ifndef PACKBITS_H
+#define PACKBITS_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Worst case packed size: one control byte per 128 literals
+inline uint32_t packbits_bound(uint32_t n) {
+  return n + (n + 127) / 128;
+}
+
+// Pack n bytes of src into dst; returns the packed length, or 0 if it
+// does not fit in capacity
+inline uint32_t packbits_encode(const uint8_t* src, uint32_t n, uint8_t* dst, uint32_t capacity) {
+  uint32_t i = 0;
+  uint32_t out = 0;
+
+  while (i < n) {
+    uint32_t run = 1;
+    while (i + run < n && run < 128 && src[i + run] == src[i]) {
+      run++;
+    }
+
+    if (run >= 3) {
+      if (out + 2 > capacity) return 0;
+      dst[out++] = (uint8_t)(257 - run);
+      dst[out++] = src[i];
+      i += run;
+      continue;
+    }
+
+    // Literals until the next run worth encoding
+    uint32_t start = i;
+    while (i < n && i - start < 128) {
+      if (i + 2 < n && src[i] == src[i + 1] && src[i] == src[i + 2]) break;
+      i++;
+    }
+    uint32_t len = i - start;
+    if (out + 1 + len > capacity) return 0;
+    dst[out++] = (uint8_t)(len - 1);
+    memcpy(dst + out, src + start, len);
+    out += len;
+  }
+  return out;
+}
+
+// Unpack length bytes of src into exactly n bytes of dst; false if the
+// stream is malformed or does not produce exactly n bytes
+inline bool packbits_decode(const uint8_t* src, uint32_t length, uint8_t* dst, uint32_t n) {
+  uint32_t in = 0;
+  uint32_t out = 0;
+
+  while (in < length) {
+    uint8_t c = src[in++];
+    if (c < 128) {
+      uint32_t len = (uint32_t)c + 1;
+      if (in + len > length || out + len > n) return false;
+      memcpy(dst + out, src + in, len);
+      in += len;
+      out += len;
+    } else if (c > 128) {
+      uint32_t len = 257 - (uint32_t)c;
+      if (in >= length || out + len > n) return false;
+      memset(dst + out, src[in++], len);
+      out += len;
+    }
+  }
+  return out == n;
+}
+
+#endif // PACKBITS_H
@@ -0,0 +1,36 @@
+// Deterministic pseudo-random generator (PCG32, XSH-RR output)
+// Same seed, same sequence, on the ESP32 and in the native test build
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+struct Pcg32 {
+  uint64_t state;
+};
+
+static constexpr uint64_t PCG32_MULT = 6364136223846793005ULL;
+static constexpr uint64_t PCG32_INC = 1442695040888963407ULL;
+
+inline uint32_t pcg32_next(Pcg32& rng) {
+  uint64_t old = rng.state;
+  rng.state = old * PCG32_MULT + PCG32_INC;
+  uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+  uint32_t rot = (uint32_t)(old >> 59);
+  return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+inline void pcg32_seed(Pcg32& rng, uint64_t seed) {
+  rng.state = 0;
+  pcg32_next(rng);
+  rng.state += seed;
+  pcg32_next(rng);
+}
+
+// Uniform-enough value in [0, bound) without a divide (multiply-shift)
+inline uint32_t pcg32_below(Pcg32& rng, uint32_t bound) {
+  return (uint32_t)(((uint64_t)pcg32_next(rng) * bound) >> 32);
+}
+
+#endif // RNG_H
@@ -0,0 +1,58 @@
+// Fixed-timestep tick scheduler
+// Turns variable frame dt into a bounded number of fixed simulation ticks
+
+#ifndef TICK_SCHEDULER_H
+#define TICK_SCHEDULER_H
+
+#include <stdint.h>
+
+// Upper bound on ticks run in one frame; older backlog is dropped so a
+// long stall costs at most this many ticks instead of a catch-up spiral
+static constexpr uint8_t MAX_TICKS_PER_FRAME = 4;
+
+struct TickScheduler {
+  uint32_t accum;     // Time owed to the simulation (ms)
+  uint16_t tickMs;    // Fixed step of the current game
+  uint32_t dropped;   // Ticks discarded by the catch-up clamp
+};
+
+// Start a fresh timeline (call on game switch / setup)
+inline void tick_scheduler_reset(TickScheduler& sched, uint16_t tickMs) {
+  sched.accum = 0;
+  sched.tickMs = tickMs;
+  sched.dropped = 0;
+}
+
+// How long the oldest tick owed after adding dt has been due (ms, 0 if none
+// is due); call before tick_scheduler_advance()
+inline uint32_t tick_scheduler_lateness(const TickScheduler& sched, uint32_t dt) {
+  uint32_t total = sched.accum + dt;
+  return (sched.tickMs != 0 && total >= sched.tickMs) ? total - sched.tickMs : 0;
+}
+
+// Add frame time and return how many ticks to run now (0..MAX_TICKS_PER_FRAME)
+inline uint8_t tick_scheduler_advance(TickScheduler& sched, uint32_t dt) {
+  if (sched.tickMs == 0) {
+    return 0;
+  }
+
+  sched.accum += dt;
+  uint32_t owed = sched.accum / sched.tickMs;
+  sched.accum -= owed * sched.tickMs;
+
+  if (owed > MAX_TICKS_PER_FRAME) {
+    sched.dropped += owed - MAX_TICKS_PER_FRAME;
+    owed = MAX_TICKS_PER_FRAME;
+  }
+  return (uint8_t)owed;
+}
+
+// Fraction of the next tick already elapsed (0-255), for render interpolation
+inline uint8_t tick_scheduler_alpha(const TickScheduler& sched) {
+  if (sched.tickMs == 0) {
+    return 0;
+  }
+  return (uint8_t)((sched.accum * 256) / sched.tickMs);
+}
+
+#endif // TICK_SCHEDULER_H
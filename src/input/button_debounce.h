@@ -0,0 +1,121 @@
+// Per-button debounce and hold tracking
+// Two small state machines, kept header-only so they test without hardware:
+//
+// ButtonDebounce turns raw pad readings (millisecond clock) into clean
+// press/release edges. Touching presses at once; letting go must last
+// releaseMs before it counts, and a touch again within that time is a
+// flicker that produces no edges at all:
+//   UP --touched--> DOWN (press) --released--> RELEASING
+//   RELEASING --touched--> DOWN
+//   RELEASING --released for releaseMs--> UP (release, timed when it began)
+//
+// ButtonHold follows one button through game ticks: how long it has been
+// held, when it becomes a long press, and auto-repeat.
+
+#ifndef BUTTON_DEBOUNCE_H
+#define BUTTON_DEBOUNCE_H
+
+#include <stdint.h>
+
+enum ButtonPhase : uint8_t {
+  BUTTON_UP,
+  BUTTON_DOWN,
+  BUTTON_RELEASING
+};
+
+enum ButtonEdge : uint8_t {
+  BUTTON_EDGE_NONE,
+  BUTTON_EDGE_PRESS,
+  BUTTON_EDGE_RELEASE
+};
+
+struct ButtonDebounce {
+  uint8_t phase;     // ButtonPhase
+  uint32_t sinceMs;  // When the press (DOWN) or the letting go (RELEASING) began
+};
+
+inline void button_debounce_reset(ButtonDebounce& b) {
+  b.phase = BUTTON_UP;
+  b.sinceMs = 0;
+}
+
+// Down as far as games are concerned (a release still settling counts)
+inline bool button_debounce_is_down(const ButtonDebounce& b) {
+  return b.phase != BUTTON_UP;
+}
+
+// Feed one reading taken at nowMs; changedMs is when the raw state last
+// changed (nowMs if unknown). Returns the edge it produced, which happened
+// at b.sinceMs.
+inline ButtonEdge button_debounce_update(ButtonDebounce& b, bool touched, uint32_t changedMs,
+                                         uint32_t nowMs, uint32_t releaseMs) {
+  switch (b.phase) {
+    case BUTTON_UP:
+      if (touched) {
+        b.phase = BUTTON_DOWN;
+        b.sinceMs = changedMs;
+        return BUTTON_EDGE_PRESS;
+      }
+      break;
+
+    case BUTTON_DOWN:
+      if (!touched) {
+        b.phase = BUTTON_RELEASING;
+        b.sinceMs = changedMs;
+      }
+      break;
+
+    case BUTTON_RELEASING:
+      if (touched) {
+        b.phase = BUTTON_DOWN;  // Flicker: the press carries on
+      } else if (nowMs - b.sinceMs >= releaseMs) {
+        b.phase = BUTTON_UP;
+        return BUTTON_EDGE_RELEASE;
+      }
+      break;
+  }
+  return BUTTON_EDGE_NONE;
+}
+
+struct ButtonHold {
+  uint32_t heldMs;        // Tick time since the press (0 on the press tick)
+  uint32_t nextRepeatMs;  // heldMs of the next auto-repeat
+  bool longPressed;       // Tick the hold reached the long-press time
+  bool repeated;          // Press tick, and each auto-repeat after it
+};
+
+inline void button_hold_reset(ButtonHold& h) {
+  h.heldMs = 0;
+  h.nextRepeatMs = 0;
+  h.longPressed = false;
+  h.repeated = false;
+}
+
+// Advance one tick of tickMs that saw the button justPressed / pressed.
+// repeatMs = 0 disables auto-repeat.
+inline void button_hold_tick(ButtonHold& h, bool justPressed, bool pressed, uint16_t tickMs,
+                             uint32_t longPressMs, uint32_t repeatDelayMs, uint32_t repeatMs) {
+  h.longPressed = false;
+  h.repeated = false;
+
+  if (justPressed) {
+    h.heldMs = 0;
+    h.nextRepeatMs = repeatDelayMs;
+    h.repeated = true;
+    return;
+  }
+  if (!pressed) {
+    h.heldMs = 0;
+    return;
+  }
+
+  uint32_t before = h.heldMs;
+  h.heldMs += tickMs;
+  h.longPressed = before < longPressMs && h.heldMs >= longPressMs;
+  if (repeatMs > 0 && h.heldMs >= h.nextRepeatMs) {
+    h.repeated = true;
+    h.nextRepeatMs += repeatMs;
+  }
+}
+
+#endif // BUTTON_DEBOUNCE_H
@@ -0,0 +1,77 @@
+// Input event queue implementation
+
+#include "input_events.h"
+#include "spsc_queue.h"
+#include "../status/input_latency.h"
+
+static SpscQueue<InputEvent, INPUT_EVENT_QUEUE_SIZE> events;
+
+// Button levels after the last consumed edge
+static bool down[INPUT_BUTTON_COUNT];
+
+void input_events_push(uint8_t button, bool isDown, uint32_t timeMs) {
+  if (button < INPUT_BUTTON_COUNT) {
+    events.push({button, isDown, timeMs});
+  }
+}
+
+// Next queued edge at or before endMs (wrap-safe)
+static bool nextEvent(uint32_t endMs, InputEvent& out) {
+  const InputEvent* head = events.peek();
+  if (!head || (int32_t)(head->timeMs - endMs) > 0) {
+    return false;
+  }
+  return events.pop(out);
+}
+
+InputState input_events_tick(uint32_t endMs, uint16_t tickMs) {
+  InputState state = {};
+  uint32_t startMs = endMs - tickMs;
+
+  InputEvent event;
+  while (nextEvent(endMs, event)) {
+    ButtonState& b = input_state_button(state, event.button);
+    down[event.button] = event.down;
+    if (event.down) {
+      input_latency_ticked(event.button, event.timeMs);
+      if (!b.justPressed) {
+        // The button's first press of the tick; (startMs, endMs] maps to 0..15
+        int32_t into = (int32_t)(event.timeMs - startMs);
+        int32_t phase = into <= 0 ? 0 : (into * INPUT_PRESS_PHASES - 1) / tickMs;
+        b.pressPhase = (uint8_t)min<int32_t>(phase, INPUT_PRESS_PHASES - 1);
+      }
+      b.justPressed = true;
+      b.pressed = true;  // Even if released again within the tick
+    } else {
+      b.justReleased = true;
+    }
+  }
+
+  for (uint8_t button = 0; button < INPUT_BUTTON_COUNT; button++) {
+    input_state_button(state, button).pressed |= down[button];
+  }
+  return state;
+}
+
+void input_events_skip(uint32_t endMs) {
+  InputEvent event;
+  while (nextEvent(endMs, event)) {
+    down[event.button] = event.down;
+    if (event.down) {
+      input_latency_skipped(event.button, event.timeMs);
+    }
+  }
+}
+
+void input_events_clear() {
+  InputEvent event;
+  while (events.pop(event)) {
+  }
+  for (uint8_t button = 0; button < INPUT_BUTTON_COUNT; button++) {
+    down[button] = false;
+  }
+}
+
+uint32_t input_events_dropped() {
+  return events.dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,46 @@
+// Input event queue
+// touch_input_update() queues every debounced button edge with the time it
+// happened. The game manager hands them out tick by tick: each fixed-step
+// tick covers a window of time and sees exactly the edges inside it, so a
+// press is neither lost in a frame that runs no tick nor repeated across
+// the several ticks of one frame.
+
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <stdint.h>
+#include "touch_input.h"
+
+// Edges queued between two ticks
+#define INPUT_EVENT_QUEUE_SIZE 32
+
+// Sub-tick resolution of ButtonState::pressPhase
+static constexpr uint8_t INPUT_PRESS_PHASES = 16;
+
+struct InputEvent {
+  uint8_t button;   // InputButton
+  bool down;        // Press, or release
+  uint32_t timeMs;  // millis() when it happened
+};
+
+// Queue an edge (game task); counted and dropped if the queue is full
+void input_events_push(uint8_t button, bool down, uint32_t timeMs);
+
+// Input for the tick covering (endMs - tickMs, endMs]: consumes every
+// queued edge up to endMs. Edges older than the window (ticks dropped by
+// the scheduler's clamp) land here too, at phase 0. Later edges stay
+// queued for the tick that covers them.
+InputState input_events_tick(uint32_t endMs, uint16_t tickMs);
+
+// Consume edges up to endMs without handing them to a tick (no game is
+// ticking: an effect is playing, or a new timeline starts). Button levels
+// still follow them.
+void input_events_skip(uint32_t endMs);
+
+// Drop every queued edge and release all buttons
+void input_events_clear();
+
+// Edges lost to a full queue since boot
+uint32_t input_events_dropped();
+
+#endif // INPUT_EVENTS_H
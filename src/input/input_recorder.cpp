@@ -0,0 +1,164 @@
+// Input recorder implementation
+
+#include "input_recorder.h"
+#include "input_rle.h"
+#include <string.h>
+#include <atomic>
+
+enum RecorderMode : uint8_t {
+  MODE_IDLE,        // Live input, not recording (buffer full or replay done)
+  MODE_RECORDING,
+  MODE_REPLAYING
+};
+
+// One buffer serves both directions: the run being recorded, or the
+// recording being replayed
+static InputRecording current;
+static RecorderMode mode = MODE_IDLE;
+static InputRleWriter writer;
+static InputRleReader reader;
+
+// Export requested by another task (nullptr = none or already taken)
+static std::atomic<InputRecording*> pendingExport{nullptr};
+static std::atomic<bool> exportDone{false};
+
+static inline uint32_t packButton(const ButtonState& b, uint8_t bit) {
+  return (uint32_t)((b.pressed << bit) | (b.justPressed << (bit + 4)) | (b.justReleased << (bit + 8))) |
+         (uint32_t)(b.pressPhase & 0xF) << (12 + bit * 4);
+}
+
+static inline ButtonState unpackButton(uint32_t packed, uint8_t bit) {
+  ButtonState b;
+  b.pressed = (packed >> bit) & 1;
+  b.justPressed = (packed >> (bit + 4)) & 1;
+  b.justReleased = (packed >> (bit + 8)) & 1;
+  b.pressPhase = (uint8_t)((packed >> (12 + bit * 4)) & 0xF);
+  return b;
+}
+
+uint32_t input_recorder_pack(const InputState& state) {
+  return packButton(state.left, 0) | packButton(state.right, 1) |
+         packButton(state.action, 2) | packButton(state.alt, 3);
+}
+
+InputState input_recorder_unpack(uint32_t packed) {
+  InputState state;
+  state.left = unpackButton(packed, 0);
+  state.right = unpackButton(packed, 1);
+  state.action = unpackButton(packed, 2);
+  state.alt = unpackButton(packed, 3);
+  return state;
+}
+
+void input_recorder_begin(uint8_t gameId, uint32_t seed) {
+  if (mode == MODE_REPLAYING) {
+    input_rle_open(reader, current.data, current.length);
+    return;
+  }
+
+  current.gameId = gameId;
+  current.seed = seed;
+  current.ticks = 0;
+  current.length = 0;
+  current.truncated = false;
+  input_rle_begin(writer, current.data, INPUT_RECORDING_BYTES);
+  mode = MODE_RECORDING;
+}
+
+void input_recorder_tick() {
+  if (mode == MODE_RECORDING) {
+    if (input_rle_push(writer, input_recorder_pack(touch_input_get_tick()))) {
+      current.ticks++;
+      current.length = writer.length;
+    } else {
+      // The run that did not fit is lost; keep ticks matching the stream
+      current.ticks -= writer.runTicks;
+      current.truncated = true;
+      mode = MODE_IDLE;
+    }
+  } else if (mode == MODE_REPLAYING) {
+    uint32_t packed;
+    if (input_rle_next(reader, packed)) {
+      touch_input_set(input_recorder_unpack(packed));
+    } else {
+      mode = MODE_IDLE;
+    }
+  }
+}
+
+void input_recorder_replay(const InputRecording& recording) {
+  current = recording;
+  mode = MODE_REPLAYING;
+  input_rle_open(reader, current.data, current.length);
+}
+
+void input_recorder_stop() {
+  if (mode == MODE_REPLAYING) {
+    mode = MODE_IDLE;
+  }
+}
+
+void input_recorder_discard(uint8_t gameId) {
+  current.gameId = gameId;
+  current.seed = 0;
+  current.ticks = 0;
+  current.length = 0;
+  current.truncated = true;
+  mode = MODE_IDLE;
+}
+
+bool input_recorder_is_replaying() {
+  return mode == MODE_REPLAYING;
+}
+
+uint32_t input_recorder_get_replay_seed() {
+  return current.seed;
+}
+
+void input_recorder_export(InputRecording& out) {
+  out.gameId = current.gameId;
+  out.seed = current.seed;
+  out.ticks = current.ticks;
+  out.truncated = current.truncated;
+  out.length = current.length;
+  memcpy(out.data, current.data, current.length);
+
+  // The run still being extended lives in the writer; close it in the copy
+  if (mode == MODE_RECORDING && writer.runTicks > 0) {
+    uint8_t run[INPUT_RLE_MAX_RUN_BYTES];
+    uint8_t n = input_rle_encode_run(run, writer.runState, writer.runTicks);
+    if (out.length + n <= INPUT_RECORDING_BYTES) {
+      memcpy(out.data + out.length, run, n);
+      out.length += n;
+    } else {
+      out.truncated = true;
+    }
+  }
+}
+
+bool input_recorder_request_export(InputRecording& out, uint32_t timeoutMs) {
+  exportDone.store(false, std::memory_order_relaxed);
+  pendingExport.store(&out, std::memory_order_release);
+
+  uint32_t start = millis();
+  while (!exportDone.load(std::memory_order_acquire)) {
+    if (millis() - start >= timeoutMs) {
+      // Withdraw the request unless the game task already took it (then
+      // the copy is under way and finishes shortly)
+      InputRecording* expected = &out;
+      if (pendingExport.compare_exchange_strong(expected, nullptr)) {
+        return false;
+      }
+    }
+    delay(1);
+  }
+  return true;
+}
+
+void input_recorder_service() {
+  InputRecording* out = pendingExport.exchange(nullptr, std::memory_order_acquire);
+  if (out) {
+    input_recorder_export(*out);
+    exportDone.store(true, std::memory_order_release);
+  }
+}
@@ -0,0 +1,68 @@
+// Input recorder
+// Records the input every game tick sees, plus the PRNG seed the run started
+// from, as a run-length-encoded stream. Replaying the stream into
+// touch_input re-simulates the run tick for tick.
+
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <stdint.h>
+#include "touch_input.h"
+
+// Encoded stream capacity (a run is usually 2-3 bytes)
+#define INPUT_RECORDING_BYTES 2048
+
+// Packed per-tick state:
+//   bits 0-3  pressed       (left, right, action, alt)
+//   bits 4-7  justPressed
+//   bits 8-11 justReleased
+//   bits 12-27 pressPhase, 4 bits per button from bit 12 (left)
+uint32_t input_recorder_pack(const InputState& state);
+InputState input_recorder_unpack(uint32_t packed);
+
+struct InputRecording {
+  uint8_t gameId;
+  uint32_t seed;       // game_random seed the run started from
+  uint32_t ticks;      // Ticks recorded
+  uint16_t length;     // Bytes used in data
+  bool truncated;      // Buffer filled up; the run continued unrecorded
+  uint8_t data[INPUT_RECORDING_BYTES];
+};
+
+// Start a run (called by game_manager_setup): records from here, or rewinds
+// the loaded replay if one is active
+void input_recorder_begin(uint8_t gameId, uint32_t seed);
+
+// Called before every game tick: records the current input, or feeds the
+// next recorded state into touch_input while replaying
+void input_recorder_tick();
+
+// Load a recording to replay; the next input_recorder_begin() rewinds it.
+// Live input returns once the stream is exhausted.
+void input_recorder_replay(const InputRecording& recording);
+
+// Drop a loaded replay (live input returns); the next
+// input_recorder_begin() starts a new recording
+void input_recorder_stop();
+
+// Start a run that cannot be replayed from a seed (a game resumed from a
+// snapshot): nothing is recorded, and the export is empty and truncated
+void input_recorder_discard(uint8_t gameId);
+
+// Check if a replay is feeding input
+bool input_recorder_is_replaying();
+
+// Seed of the loaded replay
+uint32_t input_recorder_get_replay_seed();
+
+// Copy the current recording into out (game task only)
+void input_recorder_export(InputRecording& out);
+
+// Copy the current recording from another task: the game task fills out at
+// its next input_recorder_service(). Returns false on timeout.
+bool input_recorder_request_export(InputRecording& out, uint32_t timeoutMs);
+
+// Complete pending export requests (game task, once per frame)
+void input_recorder_service();
+
+#endif // INPUT_RECORDER_H
@@ -0,0 +1,131 @@
+// Run-length encoding of per-tick input states
+// A state is a small bitmask (see input_recorder.h for the bit layout).
+// The stream is a sequence of runs, each two LEB128 varints:
+//   state, tick count
+// Idle stretches are one run, so a typical run costs two or three bytes.
+
+#ifndef INPUT_RLE_H
+#define INPUT_RLE_H
+
+#include <stdint.h>
+
+// Worst case for one run: 5-byte state + 5-byte count
+static constexpr uint8_t INPUT_RLE_MAX_RUN_BYTES = 10;
+
+struct InputRleWriter {
+  uint8_t* buf;
+  uint16_t capacity;
+  uint16_t length;      // Bytes of closed runs
+  uint32_t runState;    // Run still being extended (not yet in buf)
+  uint32_t runTicks;
+  bool overflow;        // A run did not fit; later ticks were dropped
+};
+
+struct InputRleReader {
+  const uint8_t* buf;
+  uint16_t length;
+  uint16_t pos;
+  uint32_t runState;
+  uint32_t runLeft;
+};
+
+inline uint8_t input_rle_put_varint(uint8_t* out, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+// Encode one run into out (at least INPUT_RLE_MAX_RUN_BYTES); returns bytes used
+inline uint8_t input_rle_encode_run(uint8_t* out, uint32_t state, uint32_t ticks) {
+  uint8_t n = input_rle_put_varint(out, state);
+  return n + input_rle_put_varint(out + n, ticks);
+}
+
+inline void input_rle_begin(InputRleWriter& w, uint8_t* buf, uint16_t capacity) {
+  w.buf = buf;
+  w.capacity = capacity;
+  w.length = 0;
+  w.runState = 0;
+  w.runTicks = 0;
+  w.overflow = false;
+}
+
+// Close the open run into buf
+inline bool input_rle_flush(InputRleWriter& w) {
+  if (w.runTicks == 0) {
+    return true;
+  }
+  uint8_t run[INPUT_RLE_MAX_RUN_BYTES];
+  uint8_t n = input_rle_encode_run(run, w.runState, w.runTicks);
+  if (w.length + n > w.capacity) {
+    w.overflow = true;
+    return false;
+  }
+  for (uint8_t i = 0; i < n; i++) {
+    w.buf[w.length + i] = run[i];
+  }
+  w.length += n;
+  w.runTicks = 0;
+  return true;
+}
+
+// Append one tick; false once the buffer is full
+inline bool input_rle_push(InputRleWriter& w, uint32_t state) {
+  if (w.overflow) {
+    return false;
+  }
+  if (w.runTicks > 0 && state == w.runState && w.runTicks < 0xFFFFFFFFu) {
+    w.runTicks++;
+    return true;
+  }
+  if (!input_rle_flush(w)) {
+    return false;
+  }
+  w.runState = state;
+  w.runTicks = 1;
+  return true;
+}
+
+inline void input_rle_open(InputRleReader& r, const uint8_t* buf, uint16_t length) {
+  r.buf = buf;
+  r.length = length;
+  r.pos = 0;
+  r.runState = 0;
+  r.runLeft = 0;
+}
+
+inline bool input_rle_get_varint(InputRleReader& r, uint32_t& v) {
+  v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (r.pos >= r.length) {
+      return false;
+    }
+    uint8_t b = r.buf[r.pos++];
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Next tick's state; false at the end of the stream
+inline bool input_rle_next(InputRleReader& r, uint32_t& state) {
+  while (r.runLeft == 0) {
+    uint32_t s, ticks;
+    if (!input_rle_get_varint(r, s) || !input_rle_get_varint(r, ticks)) {
+      return false;
+    }
+    r.runState = s;
+    r.runLeft = ticks;
+  }
+  r.runLeft--;
+  state = r.runState;
+  return true;
+}
+
+#endif // INPUT_RLE_H
@@ -0,0 +1,68 @@
+// Lock-free single-producer single-consumer queue
+// Fixed capacity ring for handing events from an interrupt handler (or one
+// task) to the main loop. Neither side blocks: a push to a full queue is
+// dropped and counted, a pop from an empty one returns false.
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Kept inline so push() can be called from IRAM interrupt handlers
+#define SPSC_INLINE inline __attribute__((always_inline))
+
+template <typename T, uint32_t N>
+struct SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+  T items[N];
+  std::atomic<uint32_t> head{0};     // Pushes so far (producer writes)
+  std::atomic<uint32_t> tail{0};     // Pops so far (consumer writes)
+  std::atomic<uint32_t> dropped{0};  // Pushes lost to a full queue
+
+  // Producer: append item; false (and counted) if the queue is full
+  SPSC_INLINE bool push(const T& item) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == N) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    items[h & (N - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer: take the oldest item; false if the queue is empty
+  SPSC_INLINE bool pop(T& out) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == t) {
+      return false;
+    }
+    out = items[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer: the oldest item without taking it; nullptr if empty
+  SPSC_INLINE const T* peek() const {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == t) {
+      return nullptr;
+    }
+    return &items[t & (N - 1)];
+  }
+
+  // Either side: items waiting (a snapshot; the other side may move it)
+  uint32_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+};
+
+#undef SPSC_INLINE
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,63 @@
+// Adaptive touch baseline
+// A capacitive pad's untouched reading drifts with humidity, temperature,
+// wiring length and grounding, so a fixed threshold either misses presses
+// or sees phantom ones. Each pad instead tracks its own baseline: seeded by
+// a startup calibration, then followed by an integer IIR low-pass filter
+//   baseline += (raw - baseline) / 2^shift
+// fed only while the pad is untouched, so a long hold is not learned as the
+// new normal. A touch lowers the reading on the ESP32; the pad counts as
+// touched once it reads pressPercent below the baseline, and a touched pad
+// is released only above releasePercent below it (hysteresis).
+// Header-only so it tests without hardware.
+
+#ifndef TOUCH_BASELINE_H
+#define TOUCH_BASELINE_H
+
+#include <stdint.h>
+
+// Fraction bits of the filtered baseline: enough that small steps still
+// move it instead of rounding away
+static constexpr uint8_t TOUCH_BASELINE_FRAC_BITS = 8;
+
+struct TouchBaseline {
+  uint32_t filtered;  // Baseline in 1/2^TOUCH_BASELINE_FRAC_BITS counts
+  uint16_t raw;       // Latest reading
+};
+
+// Start over from a known untouched level (startup calibration)
+inline void touch_baseline_reset(TouchBaseline& b, uint16_t level) {
+  b.filtered = (uint32_t)level << TOUCH_BASELINE_FRAC_BITS;
+  b.raw = level;
+}
+
+// Baseline in whole counts, rounded
+inline uint16_t touch_baseline_get(const TouchBaseline& b) {
+  return (uint16_t)((b.filtered + (1u << (TOUCH_BASELINE_FRAC_BITS - 1))) >> TOUCH_BASELINE_FRAC_BITS);
+}
+
+// How far the latest reading is towards touched (negative above the baseline)
+inline int32_t touch_baseline_delta(const TouchBaseline& b) {
+  return (int32_t)touch_baseline_get(b) - b.raw;
+}
+
+// Reading below which the pad counts as touched, percent below the baseline
+inline uint16_t touch_baseline_level(const TouchBaseline& b, uint8_t percent) {
+  uint32_t baseline = touch_baseline_get(b);
+  return (uint16_t)(baseline - baseline * percent / 100);
+}
+
+// Threshold with hysteresis: a pad that is down stays down until it reads
+// back above the (higher) release level
+inline bool touch_baseline_is_touched(const TouchBaseline& b, uint16_t raw, bool wasDown,
+                                      uint8_t pressPercent, uint8_t releasePercent) {
+  return raw < touch_baseline_level(b, wasDown ? releasePercent : pressPercent);
+}
+
+// One filter step towards raw: the time constant is 2^shift steps. Call
+// only for untouched readings
+inline void touch_baseline_track(TouchBaseline& b, uint16_t raw, uint8_t shift) {
+  int32_t error = ((int32_t)raw << TOUCH_BASELINE_FRAC_BITS) - (int32_t)b.filtered;
+  b.filtered = (uint32_t)((int32_t)b.filtered + (error >> shift));
+}
+
+#endif // TOUCH_BASELINE_H
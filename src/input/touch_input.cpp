@@ -1,146 +1,375 @@
 // Touch input implementation
 
 #include "touch_input.h"
+#include "input_events.h"
+#include "button_debounce.h"
+#include "touch_baseline.h"
+#include "../status/input_latency.h"
+#if TOUCH_USE_INTERRUPTS
+#include "spsc_queue.h"
+#endif
 
-static InputState inputState;
+// Pads are indexed by InputButton
+static constexpr uint8_t PAD_COUNT = INPUT_BUTTON_COUNT;
+
+static const uint8_t PAD_PINS[PAD_COUNT] = {
+  TOUCH_PIN_LEFT,
+  TOUCH_PIN_RIGHT,
+  TOUCH_PIN_ACTION,
+  TOUCH_PIN_ALT
+};
+
+static InputState inputState;  // Live, from the pads
+static InputState tickState;   // What game ticks see
 static uint32_t lastUpdate = 0;
 
-// Previous states for edge detection
-static bool prevLeft = false;
-static bool prevRight = false;
-static bool prevAction = false;
-static bool prevAlt = false;
+static ButtonDebounce debounce[PAD_COUNT];
+static ButtonHold holds[PAD_COUNT];
+
+static TouchBaseline baselines[PAD_COUNT];
+static uint32_t lastBaselineMs = 0;
+
+static uint16_t pressLevel(uint8_t pad) {
+  return touch_baseline_level(baselines[pad], TOUCH_PRESS_PERCENT);
+}
+
+// Startup calibration: average a few readings of each (untouched) pad
+static void calibrateBaselines() {
+  uint32_t sums[PAD_COUNT] = {};
+  for (uint8_t i = 0; i < TOUCH_CALIBRATION_SAMPLES; i++) {
+    for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+      sums[pad] += touchRead(PAD_PINS[pad]);
+    }
+  }
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    touch_baseline_reset(baselines[pad], (uint16_t)(sums[pad] / TOUCH_CALIBRATION_SAMPLES));
+  }
+}
+
+// Drift compensation: one filter step for a pad that is up and reads
+// untouched (a hold must not become the baseline)
+static void trackBaseline(uint8_t pad, uint16_t raw) {
+  TouchBaseline& b = baselines[pad];
+  if (!button_debounce_is_down(debounce[pad]) &&
+      !touch_baseline_is_touched(b, raw, false, TOUCH_PRESS_PERCENT, TOUCH_RELEASE_PERCENT)) {
+    touch_baseline_track(b, raw, TOUCH_BASELINE_SHIFT);
+  }
+}
+
+#if TOUCH_USE_INTERRUPTS
+
+// A pad went from quiet to touched (the FSM has no release interrupt)
+struct TouchEdge {
+  uint8_t pad;
+  uint32_t timeMs;
+};
+
+static SpscQueue<TouchEdge, TOUCH_EDGE_QUEUE_SIZE> edges;
+static std::atomic<uint32_t> lastTouchMs[PAD_COUNT];  // Latest interrupt per pad
+static bool padDown[PAD_COUNT];                        // Main loop's view
+static uint32_t padEdgeMs[PAD_COUNT];                  // When this update's change happened
+static uint16_t armedLevel[PAD_COUNT];                 // FSM threshold per pad
+static uint8_t samplePad = 0;                          // Next baseline sample
+
+// Runs on every measurement below threshold while the pad is held
+static void IRAM_ATTR onPadTouched(uint8_t pad) {
+  uint32_t now = millis();
+  uint32_t prev = lastTouchMs[pad].exchange(now, std::memory_order_relaxed);
+  if (now - prev > TOUCH_RELEASE_MS) {
+    edges.push({pad, now});
+  }
+}
+
+static void IRAM_ATTR onLeftTouched() { onPadTouched(INPUT_LEFT); }
+static void IRAM_ATTR onRightTouched() { onPadTouched(INPUT_RIGHT); }
+static void IRAM_ATTR onActionTouched() { onPadTouched(INPUT_ACTION); }
+static void IRAM_ATTR onAltTouched() { onPadTouched(INPUT_ALT); }
+
+static void (* const PAD_HANDLERS[PAD_COUNT])() = {
+  onLeftTouched,
+  onRightTouched,
+  onActionTouched,
+  onAltTouched
+};
 
-// Last press times for debouncing
-static uint32_t lastLeftPress = 0;
-static uint32_t lastRightPress = 0;
-static uint32_t lastActionPress = 0;
-static uint32_t lastAltPress = 0;
+// Apply queued presses, then release pads whose interrupts stopped
+static void drainEdges(uint32_t now) {
+  bool pressedNow[PAD_COUNT] = {};
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    padEdgeMs[pad] = now;
+  }
+  TouchEdge edge;
+  while (edges.pop(edge)) {
+    padDown[edge.pad] = true;
+    padEdgeMs[edge.pad] = edge.timeMs;
+    pressedNow[edge.pad] = true;
+  }
+
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    // A tap shorter than a slow frame still reads as pressed once
+    if (padDown[pad] && !pressedNow[pad] &&
+        now - lastTouchMs[pad].load(std::memory_order_relaxed) > TOUCH_RELEASE_MS) {
+      padDown[pad] = false;
+      padEdgeMs[pad] = lastTouchMs[pad].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+static bool padTouched(uint8_t pad) {
+  return padDown[pad];
+}
+
+// Interrupt time of a change seen by this update (else now)
+static uint32_t edgeTimeMs(uint8_t pad, uint32_t now) {
+  (void)now;
+  return padEdgeMs[pad];
+}
+
+// Point the pad's FSM threshold at its baseline's press level
+static void armPad(uint8_t pad) {
+  uint16_t level = pressLevel(pad);
+  if (level != armedLevel[pad]) {
+    touchAttachInterrupt(PAD_PINS[pad], PAD_HANDLERS[pad], level);
+    armedLevel[pad] = level;
+  }
+}
+
+// The FSM takes no readings the baselines can use, so they sample on their
+// own: one pad at a time, each every TOUCH_BASELINE_SAMPLE_MS, re-arming its
+// threshold as the baseline moves
+static void sampleBaselines(uint32_t now) {
+#if TOUCH_DRIFT_COMPENSATION
+  if (now - lastBaselineMs < TOUCH_BASELINE_SAMPLE_MS / PAD_COUNT) {
+    return;
+  }
+  lastBaselineMs = now;
+  uint8_t pad = samplePad;
+  samplePad = (samplePad + 1) % PAD_COUNT;
+  baselines[pad].raw = touchRead(PAD_PINS[pad]);
+  trackBaseline(pad, baselines[pad].raw);
+  armPad(pad);
+#else
+  (void)now;
+#endif
+}
+
+#else
 
-// Read touch pin with threshold
-static bool readTouchPin(int pin, uint32_t threshold) {
-  int touchValue = touchRead(pin);
-  return touchValue < threshold;
+// Read the pad against its baseline, with hysteresis while it is down
+static bool padTouched(uint8_t pad) {
+  TouchBaseline& b = baselines[pad];
+  b.raw = touchRead(PAD_PINS[pad]);
+  return touch_baseline_is_touched(b, b.raw, button_debounce_is_down(debounce[pad]),
+                                   TOUCH_PRESS_PERCENT, TOUCH_RELEASE_PERCENT);
+}
+
+// Polling only knows the pad changed since the last update
+static uint32_t edgeTimeMs(uint8_t pad, uint32_t now) {
+  (void)pad;
+  return now;
+}
+
+// Drift compensation feeds on the readings this update already took
+static void sampleBaselines(uint32_t now) {
+#if TOUCH_DRIFT_COMPENSATION
+  if (now - lastBaselineMs < TOUCH_BASELINE_SAMPLE_MS) {
+    return;
+  }
+  lastBaselineMs = now;
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    trackBaseline(pad, baselines[pad].raw);
+  }
+#else
+  (void)now;
+#endif
 }
 
+#endif
+
 void touch_input_init() {
   // Touch pins don't need pinMode, but we can set them up
   // touchRead() works directly on touch-capable pins
 
   // Initialize state
-  inputState.left = {false, false, false};
-  inputState.right = {false, false, false};
-  inputState.action = {false, false, false};
-  inputState.alt = {false, false, false};
+  inputState.left = {false, false, false, 0};
+  inputState.right = {false, false, false, 0};
+  inputState.action = {false, false, false, 0};
+  inputState.alt = {false, false, false, 0};
+  tickState = inputState;
+  input_events_clear();
+
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    button_debounce_reset(debounce[pad]);
+  }
+  touch_input_reset_holds();
 
-  prevLeft = prevRight = prevAction = prevAlt = false;
-  lastLeftPress = lastRightPress = lastActionPress = lastAltPress = 0;
+#if TOUCH_USE_INTERRUPTS
+  // Readings scale with the measure time, so set it before calibrating
+  touchSetCycles(TOUCH_MEASURE_CYCLES, TOUCH_SLEEP_CYCLES);
+#endif
+  calibrateBaselines();
   lastUpdate = millis();
+  lastBaselineMs = lastUpdate;
 
+#if TOUCH_USE_INTERRUPTS
+  // Forget edges from before a re-init, then hand measuring to the FSM
+  TouchEdge stale;
+  while (edges.pop(stale)) {
+  }
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    padDown[pad] = false;
+    lastTouchMs[pad].store(lastUpdate - TOUCH_RELEASE_MS - 1, std::memory_order_relaxed);
+  }
+  samplePad = 0;
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    armedLevel[pad] = 0;
+    armPad(pad);
+  }
+#endif
+
+  static const char* const PAD_NAMES[PAD_COUNT] = {"Left", "Right", "Action", "Alt"};
   Serial.println("Touch input initialized");
-  Serial.print("Left: GPIO "); Serial.println(TOUCH_PIN_LEFT);
-  Serial.print("Right: GPIO "); Serial.println(TOUCH_PIN_RIGHT);
-  Serial.print("Action: GPIO "); Serial.println(TOUCH_PIN_ACTION);
-  Serial.print("Alt: GPIO "); Serial.println(TOUCH_PIN_ALT);
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    Serial.print(PAD_NAMES[pad]); Serial.print(": GPIO "); Serial.print(PAD_PINS[pad]);
+    Serial.print(", baseline "); Serial.println(touch_baseline_get(baselines[pad]));
+  }
 }
 
 void touch_input_update() {
   uint32_t now = millis();
 
-  // Read touch pins with debouncing
-  bool leftPressed = false;
-  bool rightPressed = false;
-  bool actionPressed = false;
-  bool altPressed = false;
+#if TOUCH_USE_INTERRUPTS
+  drainEdges(now);
+#endif
 
-  if (readTouchPin(TOUCH_PIN_LEFT, TOUCH_THRESHOLD)) {
-    if (now - lastLeftPress > TOUCH_DEBOUNCE_MS) {
-      leftPressed = true;
-      lastLeftPress = now;
-    }
-  }
+  for (uint8_t pad = 0; pad < PAD_COUNT; pad++) {
+    ButtonDebounce& d = debounce[pad];
+    ButtonEdge edge = button_debounce_update(d, padTouched(pad), edgeTimeMs(pad, now), now, TOUCH_DEBOUNCE_MS);
 
-  if (readTouchPin(TOUCH_PIN_RIGHT, TOUCH_THRESHOLD)) {
-    if (now - lastRightPress > TOUCH_DEBOUNCE_MS) {
-      rightPressed = true;
-      lastRightPress = now;
-    }
-  }
+    ButtonState& b = input_state_button(inputState, pad);
+    b.pressed = button_debounce_is_down(d);
+    b.justPressed = edge == BUTTON_EDGE_PRESS;
+    b.justReleased = edge == BUTTON_EDGE_RELEASE;
 
-  if (readTouchPin(TOUCH_PIN_ACTION, TOUCH_THRESHOLD)) {
-    if (now - lastActionPress > TOUCH_DEBOUNCE_MS) {
-      actionPressed = true;
-      lastActionPress = now;
+    // Hand the edge to the tick that covers its time
+    if (edge != BUTTON_EDGE_NONE) {
+      input_events_push(pad, b.justPressed, d.sinceMs);
+      if (b.justPressed) {
+        input_latency_pressed(pad, d.sinceMs);
+      }
     }
   }
+  sampleBaselines(now);
 
-  if (readTouchPin(TOUCH_PIN_ALT, TOUCH_THRESHOLD)) {
-    if (now - lastAltPress > TOUCH_DEBOUNCE_MS) {
-      altPressed = true;
-      lastAltPress = now;
-    }
+  lastUpdate = now;
+}
+
+InputState touch_input_get() {
+  return inputState;
+}
+
+InputState touch_input_get_tick() {
+  return tickState;
+}
+
+void touch_input_set(const InputState& state) {
+  tickState = state;
+}
+
+uint8_t touch_input_press_phase(uint8_t button) {
+  return input_state_button(tickState, button).pressPhase;
+}
+
+void touch_input_tick(uint16_t tickMs) {
+  for (uint8_t button = 0; button < PAD_COUNT; button++) {
+    const ButtonState& b = input_state_button(tickState, button);
+    button_hold_tick(holds[button], b.justPressed, b.pressed, tickMs,
+                     TOUCH_LONG_PRESS_MS, TOUCH_REPEAT_DELAY_MS, TOUCH_REPEAT_MS);
   }
+}
 
-  // Update left button state
-  inputState.left.pressed = leftPressed;
-  inputState.left.justPressed = leftPressed && !prevLeft;
-  inputState.left.justReleased = !leftPressed && prevLeft;
-  prevLeft = leftPressed;
+void touch_input_reset_holds() {
+  for (uint8_t button = 0; button < PAD_COUNT; button++) {
+    button_hold_reset(holds[button]);
+  }
+}
 
-  // Update right button state
-  inputState.right.pressed = rightPressed;
-  inputState.right.justPressed = rightPressed && !prevRight;
-  inputState.right.justReleased = !rightPressed && prevRight;
-  prevRight = rightPressed;
+uint32_t touch_input_held_ms(uint8_t button) {
+  return button < PAD_COUNT ? holds[button].heldMs : 0;
+}
 
-  // Update action button state
-  inputState.action.pressed = actionPressed;
-  inputState.action.justPressed = actionPressed && !prevAction;
-  inputState.action.justReleased = !actionPressed && prevAction;
-  prevAction = actionPressed;
+bool touch_input_long_pressed(uint8_t button) {
+  return button < PAD_COUNT && holds[button].longPressed;
+}
 
-  // Update alt button state
-  inputState.alt.pressed = altPressed;
-  inputState.alt.justPressed = altPressed && !prevAlt;
-  inputState.alt.justReleased = !altPressed && prevAlt;
-  prevAlt = altPressed;
+bool touch_input_repeated(uint8_t button) {
+  return button < PAD_COUNT && holds[button].repeated;
+}
 
-  lastUpdate = now;
+TouchPadReading touch_input_get_pad(uint8_t button) {
+  TouchPadReading reading = {0, 0, 0, 0};
+  if (button < PAD_COUNT) {
+    const TouchBaseline& b = baselines[button];
+    reading.raw = b.raw;
+    reading.baseline = touch_baseline_get(b);
+    reading.threshold = pressLevel(button);
+    reading.delta = (int16_t)touch_baseline_delta(b);
+  }
+  return reading;
 }
 
-InputState touch_input_get() {
-  return inputState;
+uint32_t touch_input_dropped_edges() {
+#if TOUCH_USE_INTERRUPTS
+  return edges.dropped.load(std::memory_order_relaxed);
+#else
+  return 0;
+#endif
 }
 
 bool touch_left_pressed() {
-  return inputState.left.pressed;
+  return tickState.left.pressed;
 }
 
 bool touch_left_just_pressed() {
-  return inputState.left.justPressed;
+  return tickState.left.justPressed;
 }
 
 bool touch_right_pressed() {
-  return inputState.right.pressed;
+  return tickState.right.pressed;
 }
 
 bool touch_right_just_pressed() {
-  return inputState.right.justPressed;
+  return tickState.right.justPressed;
 }
 
 bool touch_action_pressed() {
-  return inputState.action.pressed;
+  return tickState.action.pressed;
 }
 
 bool touch_action_just_pressed() {
-  return inputState.action.justPressed;
+  return tickState.action.justPressed;
 }
 
 bool touch_alt_pressed() {
-  return inputState.alt.pressed;
+  return tickState.alt.pressed;
 }
 
 bool touch_alt_just_pressed() {
-  return inputState.alt.justPressed;
+  return tickState.alt.justPressed;
+}
+
+bool touch_left_repeated() {
+  return holds[INPUT_LEFT].repeated;
 }
 
+bool touch_right_repeated() {
+  return holds[INPUT_RIGHT].repeated;
+}
+
+bool touch_action_repeated() {
+  return holds[INPUT_ACTION].repeated;
+}
+
+bool touch_alt_repeated() {
+  return holds[INPUT_ALT].repeated;
+}
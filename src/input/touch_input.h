@@ -14,18 +14,85 @@
 #define TOUCH_PIN_ACTION 13  // Touch4
 #define TOUCH_PIN_ALT    12  // Touch5
 
-// Touch threshold (lower = more sensitive)
-// Typical values: 20-80, adjust based on your setup
-#define TOUCH_THRESHOLD  40
+// Adaptive threshold (touch_baseline.h): each pad tracks its untouched
+// reading and counts as touched once it reads this many percent below it.
+// A held pad is released only above TOUCH_RELEASE_PERCENT below, so a
+// reading hovering around the threshold does not flicker
+#ifndef TOUCH_PRESS_PERCENT
+#define TOUCH_PRESS_PERCENT   35
+#endif
+#ifndef TOUCH_RELEASE_PERCENT
+#define TOUCH_RELEASE_PERCENT 25
+#endif
 
-// Debounce time in milliseconds
-#define TOUCH_DEBOUNCE_MS 50
+// Startup calibration: readings averaged per pad for the first baseline
+// (keep the pads untouched while booting)
+#define TOUCH_CALIBRATION_SAMPLES 16
+
+// Drift compensation: every TOUCH_BASELINE_SAMPLE_MS each untouched pad's
+// baseline takes one filter step towards its reading, with a time constant
+// of 2^TOUCH_BASELINE_SHIFT steps (32 x 100ms = ~3s). 0 keeps the startup
+// calibration for good
+#ifndef TOUCH_DRIFT_COMPENSATION
+#define TOUCH_DRIFT_COMPENSATION 1
+#endif
+#define TOUCH_BASELINE_SAMPLE_MS 100
+#define TOUCH_BASELINE_SHIFT 5
+
+// Debounce time in milliseconds: letting go of a pad only counts once it
+// has lasted this long (touching again sooner continues the press)
+#define TOUCH_DEBOUNCE_MS 30
+
+// Hold tracking, in game tick time: a long press fires once the button has
+// been held this long
+#ifndef TOUCH_LONG_PRESS_MS
+#define TOUCH_LONG_PRESS_MS 600
+#endif
+
+// Auto-repeat: after the press, repeats start once held this long and
+// follow every TOUCH_REPEAT_MS (0 disables repeats)
+#ifndef TOUCH_REPEAT_DELAY_MS
+#define TOUCH_REPEAT_DELAY_MS 400
+#endif
+#ifndef TOUCH_REPEAT_MS
+#define TOUCH_REPEAT_MS 120
+#endif
+
+// Sensing mode: 0 polls touchRead() on every update, which blocks for a
+// full measurement per pad; 1 lets the touch peripheral's FSM measure in
+// the background and only drains the edges its threshold interrupts queue
+#ifndef TOUCH_USE_INTERRUPTS
+#define TOUCH_USE_INTERRUPTS 0
+#endif
+
+// Interrupt mode: FSM measure time (8MHz cycles) and sleep between
+// measurements (150kHz cycles, 0x300 = ~5ms)
+#define TOUCH_MEASURE_CYCLES 0x1000
+#define TOUCH_SLEEP_CYCLES   0x0300
+
+// Interrupt mode: the FSM interrupts on every measurement below threshold
+// and never on release, so a pad is released once it has been quiet this long
+#define TOUCH_RELEASE_MS 20
+
+// Interrupt mode: press edges queued between two updates
+#define TOUCH_EDGE_QUEUE_SIZE 16
+
+// Buttons in InputState order
+enum InputButton : uint8_t {
+  INPUT_LEFT,
+  INPUT_RIGHT,
+  INPUT_ACTION,
+  INPUT_ALT,
+  INPUT_BUTTON_COUNT
+};
 
 // Button states
 struct ButtonState {
   bool pressed;
   bool justPressed;
   bool justReleased;
+  uint8_t pressPhase;  // Tick input, if justPressed: when in the tick its first
+                       // press came, 0 (start) to INPUT_PRESS_PHASES - 1 (end)
 };
 
 // Input state
@@ -36,16 +103,61 @@ struct InputState {
   ButtonState alt;
 };
 
+// Button of state by InputButton
+inline ButtonState& input_state_button(InputState& state, uint8_t button) {
+  switch (button) {
+    case INPUT_LEFT: return state.left;
+    case INPUT_RIGHT: return state.right;
+    case INPUT_ACTION: return state.action;
+    default: return state.alt;
+  }
+}
+
 // Initialize touch input
 void touch_input_init();
 
-// Update input state (call in loop)
+// Read the pads (call in loop): refreshes the live state and queues each
+// debounced edge with its time (input_events.h)
 void touch_input_update();
 
-// Get current input state
+// Get the live input state, as of the last touch_input_update()
 InputState touch_input_get();
 
-// Helper functions for individual buttons
+// Get the input the current game tick sees
+InputState touch_input_get_tick();
+
+// Set the input for the next game tick (game manager, input replay)
+void touch_input_set(const InputState& state);
+
+// Tick input's pressPhase for button (InputButton): sub-tick timing of its
+// first press
+uint8_t touch_input_press_phase(uint8_t button);
+
+// Advance hold tracking for a tick of tickMs that sees the tick input (game
+// manager, after any replay has set it)
+void touch_input_tick(uint16_t tickMs);
+
+// Forget holds in progress (a new game timeline starts)
+void touch_input_reset_holds();
+
+// Hold tracking for the current tick (button: InputButton)
+uint32_t touch_input_held_ms(uint8_t button);    // 0 on the press tick and when up
+bool touch_input_long_pressed(uint8_t button);   // Tick the hold reached TOUCH_LONG_PRESS_MS
+bool touch_input_repeated(uint8_t button);       // Press tick, then every auto-repeat
+
+// A pad's sensing, for tuning installs (button: InputButton)
+struct TouchPadReading {
+  uint16_t raw;        // Latest reading (interrupt mode: latest baseline sample)
+  uint16_t baseline;   // Tracked untouched reading
+  uint16_t threshold;  // Press below this
+  int16_t delta;       // baseline - raw: how far towards touched
+};
+TouchPadReading touch_input_get_pad(uint8_t button);
+
+// Press edges lost to a full queue (interrupt mode; always 0 when polling)
+uint32_t touch_input_dropped_edges();
+
+// Helper functions for individual buttons (tick input)
 bool touch_left_pressed();
 bool touch_left_just_pressed();
 bool touch_right_pressed();
@@ -54,6 +166,10 @@ bool touch_action_pressed();
 bool touch_action_just_pressed();
 bool touch_alt_pressed();
 bool touch_alt_just_pressed();
+bool touch_left_repeated();
+bool touch_right_repeated();
+bool touch_action_repeated();
+bool touch_alt_repeated();
 
 #endif // TOUCH_INPUT_H
 
@@ -1,36 +1,45 @@
 #include <Arduino.h>
 #include <FastLED.h>
+#include "config/led_config.h"
 #include "input/touch_input.h"
 #include "games/game_manager.h"
+#include "render/led_output.h"
+#include "status/frame_timing.h"
 
 // Enable networking (comment out to disable)
 #define ENABLE_NETWORKING
 
+// Run networking on its own task on core 0, game on core 1 (comment out for single loop)
+#define ENABLE_DUAL_CORE
+
 #ifdef ENABLE_NETWORKING
 #include "status/status_monitor.h"
 #include "network/wifi_manager.h"
 #include "network/web_server.h"
 #include "network/mqtt_client.h"
+#include "network/network_task.h"
 #include "config/wifi_config.h"
 #include "config/mqtt_config.h"
-#include <ArduinoJson.h>
 #include <FastLED.h>  // For CRGB access
 #endif
 
-#define LED_PIN     16
-#define NUM_LEDS    8
 #define BRIGHTNESS  10
 #define LED_TYPE    WS2812B
 #define COLOR_ORDER GRB
 
+// Back buffer: games render here
 CRGB leds[NUM_LEDS];
 
+// Front buffer: registered with FastLED, streamed out by led_output
+static CRGB frontLeds[NUM_LEDS];
+
 void setup() {
   Serial.begin(115200);
   delay(200);
 
-  FastLED.addLeds<LED_TYPE, LED_PIN, COLOR_ORDER>(leds, NUM_LEDS);
+  FastLED.addLeds<LED_TYPE, LED_PIN, COLOR_ORDER>(frontLeds, NUM_LEDS);
   FastLED.setBrightness(BRIGHTNESS);
+  led_output_init((uint8_t*)frontLeds, NUM_LEDS);
 
   touch_input_init();
 
@@ -51,6 +60,11 @@ void setup() {
   // Initialize web server
   web_server_init();
 
+#ifdef ENABLE_DUAL_CORE
+  // WiFi/web on core 0; loop() (game, input, LEDs) stays on core 1
+  network_task_start();
+#endif
+
   // MQTT is disabled when using AP mode (no internet connection)
   // Uncomment below if you want to enable MQTT with a different network setup
   // mqtt_client_init();
@@ -61,24 +75,32 @@ void setup() {
   // }
 #endif
 
-  // Setup the current game (loaded from EEPROM or default)
-  game_manager_setup();
+  // Start the current game (loaded from EEPROM or default), resuming it if
+  // a warm reboot interrupted it
+  game_manager_start();
 }
 
 void loop() {
+  frame_timing_begin();
+
   static uint32_t last = millis();
   uint32_t now = millis();
   uint32_t dt = now - last;
   last = now;
 
   touch_input_update();
+  frame_timing_lap(PERF_TOUCH);
 
 #ifdef ENABLE_NETWORKING
-  // Update network services
-  wifi_manager_update();
-  web_server_update();
-  // MQTT disabled in AP mode (no internet connection)
-  // mqtt_client_update();
+  // Update network services (unless the network task owns them)
+  if (!network_task_is_running()) {
+    wifi_manager_update();
+    frame_timing_lap(PERF_WIFI);
+    web_server_update();
+    frame_timing_lap(PERF_WEB);
+    // MQTT disabled in AP mode (no internet connection)
+    // mqtt_client_update();
+  }
 
   // Update status monitor with input state
   InputState input = touch_input_get();
@@ -88,51 +110,33 @@ void loop() {
     input.action.pressed,
     input.alt.pressed
   );
+  for (uint8_t pad = 0; pad < INPUT_BUTTON_COUNT; pad++) {
+    TouchPadReading touch = touch_input_get_pad(pad);
+    status_monitor_update_touch(pad, touch.raw, touch.baseline, touch.threshold);
+  }
+  frame_timing_lap(PERF_STATUS);
 #endif
 
   game_manager_loop(dt);
+  frame_timing_lap(PERF_GAME);
 
 #ifdef ENABLE_NETWORKING
   // Update status monitor with LED state AFTER game_loop (so we capture the rendered state)
-  LEDColor ledColors[8];
-  for (int i = 0; i < NUM_LEDS; i++) {
-    ledColors[i].r = leds[i].r;
-    ledColors[i].g = leds[i].g;
-    ledColors[i].b = leds[i].b;
-  }
-  status_monitor_update_leds(ledColors, NUM_LEDS);
-
-  // Always send status updates (LEDs change every frame, not just on status changes)
-  GameStatus status = status_monitor_get();
-
-  // Publish full status as JSON (increased size for LED array)
-  StaticJsonDocument<768> doc;
-  doc["gameName"] = status.gameName;
-  doc["score"] = status.score;
-  doc["state"] = status.state;
-  doc["leftPressed"] = status.leftPressed;
-  doc["rightPressed"] = status.rightPressed;
-  doc["actionPressed"] = status.actionPressed;
-  doc["altPressed"] = status.altPressed;
-  doc["timestamp"] = status.timestamp;
-
-    // Add LED array - ensure all 8 LEDs are included
-    JsonArray ledsArray = doc.createNestedArray("leds");
-    for (int i = 0; i < 8; i++) {
-      JsonObject led = ledsArray.createNestedObject();
-      led["r"] = (int)status.leds[i].r;
-      led["g"] = (int)status.leds[i].g;
-      led["b"] = (int)status.leds[i].b;
-    }
-
-  // MQTT publishing disabled in AP mode (no internet connection)
-  // Status is available via web server at /status endpoint
-  if (status_monitor_has_changed()) {
-    // Status changes are automatically available via web server
-    status_monitor_clear_changed();
-  }
+  static_assert(sizeof(CRGB) == sizeof(LEDColor), "CRGB and LEDColor are both r, g, b bytes");
+  status_monitor_update_leds(reinterpret_cast<const LEDColor*>(leds), NUM_LEDS);
+
+  // Stalls are detected at the end of an iteration, so this reports up to the last one
+  const StallRecord* stall = frame_timing_get_last_stall();
+  status_monitor_update_stalls(frame_timing_get_stall_count(), stall ? stall->durationUs : 0);
+
+  // Hand the finished frame's status to the network task (only if it
+  // changed); consumers serialize it on demand (network/status_json.h)
+  status_monitor_publish();
+  frame_timing_lap(PERF_STATUS);
 #endif
+
+  frame_timing_end(game_manager_get_current_game());
 }
 
 // All games are compiled separately by PlatformIO
-// Game manager uses wrapper functions (game_XX_setup, game_XX_loop) to call them
+// Game manager uses wrapper functions (game_XX_setup, game_XX_update, game_XX_render) to call them
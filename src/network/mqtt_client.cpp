@@ -4,12 +4,16 @@
 #include <WiFi.h>
 #include <PubSubClient.h>
 #include "../config/mqtt_config.h"
+#include "../status/status_monitor.h"
+#include "status_json.h"
 #include <ArduinoJson.h>
 
 static WiFiClient wifiClient;
 static PubSubClient* mqttClient = nullptr;
 static bool mqttConnected = false;
 static uint32_t lastReconnectAttempt = 0;
+static uint32_t lastStatusMs = 0;
+static uint32_t lastStatusVersion = 0;
 
 void mqtt_callback(char* topic, byte* payload, unsigned int length) {
   // Handle incoming messages (optional - for remote control)
@@ -37,6 +41,7 @@ bool mqtt_reconnect() {
   if (connected) {
     Serial.println(" connected");
     mqttConnected = true;
+    lastStatusVersion = 0;  // Resend every field: the broker keeps no state
 
     // Subscribe to command topic (optional)
     String cmdTopic = String(MQTT_TOPIC_PREFIX) + "/command";
@@ -57,6 +62,7 @@ void mqtt_client_init() {
 
   mqttClient = new PubSubClient(wifiClient);
   mqttClient->setCallback(mqtt_callback);
+  mqttClient->setBufferSize(STATUS_JSON_BYTES + 128);  // Status plus topic and header
   mqttConnected = false;
 }
 
@@ -69,6 +75,22 @@ bool mqtt_client_connect(const char* broker, uint16_t port, const char* username
   return mqtt_reconnect();
 }
 
+// Subscriber side of the status: when there is a new version, send only the
+// fields that changed since the last one sent (all of them after a reconnect)
+static void publishStatusIfChanged() {
+  uint32_t now = millis();
+  if (now - lastStatusMs < MQTT_STATUS_INTERVAL_MS ||
+      status_monitor_version() == lastStatusVersion) {
+    return;
+  }
+  lastStatusMs = now;
+
+  size_t length;
+  const char* json = status_json_get_delta(lastStatusVersion, length, lastStatusVersion);
+  String topic = String(MQTT_TOPIC_PREFIX) + "/status";
+  mqttClient->publish(topic.c_str(), (const uint8_t*)json, length);
+}
+
 void mqtt_client_update() {
   if (mqttClient == nullptr) {
     return;
@@ -83,6 +105,7 @@ void mqtt_client_update() {
     }
   } else {
     mqttClient->loop();
+    publishStatusIfChanged();
   }
 }
 
@@ -0,0 +1,57 @@
+// Network task implementation
+
+#include "network_task.h"
+#include "wifi_manager.h"
+#include "web_server.h"
+#include "mqtt_client.h"
+#include "../status/perf_probe.h"
+
+static TaskHandle_t taskHandle = nullptr;
+
+static void networkTask(void* param) {
+  for (;;) {
+    {
+      PerfProbe probe(PERF_WIFI);
+      wifi_manager_update();
+    }
+    {
+      PerfProbe probe(PERF_WEB);
+      web_server_update();
+    }
+    // MQTT disabled in AP mode (no internet connection)
+    // mqtt_client_update();
+
+    // Yield so the core 0 idle task (and its watchdog) still gets to run
+    vTaskDelay(1);
+  }
+}
+
+bool network_task_start() {
+  if (taskHandle != nullptr) {
+    return true;
+  }
+
+  BaseType_t result = xTaskCreatePinnedToCore(
+    networkTask,
+    "network",
+    NETWORK_TASK_STACK,
+    nullptr,
+    NETWORK_TASK_PRIORITY,
+    &taskHandle,
+    NETWORK_TASK_CORE
+  );
+
+  if (result != pdPASS) {
+    taskHandle = nullptr;
+    Serial.println("Network task creation failed");
+    return false;
+  }
+
+  Serial.print("Network task started on core ");
+  Serial.println(NETWORK_TASK_CORE);
+  return true;
+}
+
+bool network_task_is_running() {
+  return taskHandle != nullptr;
+}
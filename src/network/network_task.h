@@ -0,0 +1,22 @@
+// Network task
+// Services WiFi and the web server on its own FreeRTOS task (core 0), so a
+// slow HTTP client can no longer delay game ticks on core 1
+
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <Arduino.h>
+
+// Core the network task is pinned to (WiFi stack also runs on core 0)
+#define NETWORK_TASK_CORE 0
+#define NETWORK_TASK_STACK 8192
+#define NETWORK_TASK_PRIORITY 1
+
+// Start the network task (call once, after wifi_manager and web_server init)
+// Returns true if the task was created
+bool network_task_start();
+
+// Check if the network task is running
+bool network_task_is_running();
+
+#endif // NETWORK_TASK_H
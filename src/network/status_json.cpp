@@ -0,0 +1,125 @@
+// Status JSON implementation
+
+#include "status_json.h"
+#include "../status/status_monitor.h"
+#include <ArduinoJson.h>
+#include <stdio.h>
+
+// The full document, or the latest delta that carried the LEDs
+static char json[STATUS_JSON_BYTES];
+static size_t jsonLength = 0;
+static uint32_t jsonVersion = 0;
+static bool jsonValid = false;
+
+// Deltas without the LEDs differ per consumer and are small: they share
+// one uncached buffer
+static char deltaJson[STATUS_JSON_FIELDS_BYTES];
+
+// Room the LEDs take after the other fields: ,"numLeds":N,"leds":"..."}
+static constexpr size_t LED_FIELDS_BYTES = NUM_LEDS * 6 + 32;
+
+// Serialize the given fields (STATUS_BIT mask) of status into out
+static size_t writeFields(const GameStatus& status, uint32_t fields, char* out, size_t size) {
+  StaticJsonDocument<768> doc;
+  doc["version"] = status.version;
+  doc["timestamp"] = status.timestamp;
+  if (fields & STATUS_BIT(STATUS_FIELD_NAME)) {
+    doc["gameName"] = status.gameName;
+  }
+  if (fields & STATUS_BIT(STATUS_FIELD_SCORE)) {
+    doc["score"] = status.score;
+  }
+  if (fields & STATUS_BIT(STATUS_FIELD_STATE)) {
+    doc["state"] = status.state;
+  }
+  if (fields & STATUS_BIT(STATUS_FIELD_INPUT)) {
+    doc["leftPressed"] = status.leftPressed;
+    doc["rightPressed"] = status.rightPressed;
+    doc["actionPressed"] = status.actionPressed;
+    doc["altPressed"] = status.altPressed;
+  }
+  if (fields & STATUS_BIT(STATUS_FIELD_STALLS)) {
+    doc["stallCount"] = status.stallCount;
+    doc["lastStallUs"] = status.lastStallUs;
+  }
+
+  // Touch pads in button order; delta is how far towards touched
+  if (fields & STATUS_BIT(STATUS_FIELD_TOUCH)) {
+    JsonArray touch = doc.createNestedArray("touch");
+    for (const TouchPadStatus& pad : status.touch) {
+      JsonObject t = touch.createNestedObject();
+      t["raw"] = pad.raw;
+      t["baseline"] = pad.baseline;
+      t["threshold"] = pad.threshold;
+      t["delta"] = (int)pad.baseline - (int)pad.raw;
+    }
+  }
+
+  size_t length = serializeJson(doc, out, size);
+  if (!(fields & STATUS_BIT(STATUS_FIELD_LEDS)) || length == 0 ||
+      length + LED_FIELDS_BYTES > size) {
+    return length;
+  }
+
+  // LEDs go out as one "rrggbb..." hex string, written straight after the
+  // other fields in place of the closing brace
+  char* hex = out + length - 1;
+  hex += sprintf(hex, ",\"numLeds\":%d,\"leds\":\"", NUM_LEDS);
+  for (int i = 0; i < NUM_LEDS; i++) {
+    const LEDColor& c = status.leds[i];
+    hex = status_json_append_hex(hex, c.r);
+    hex = status_json_append_hex(hex, c.g);
+    hex = status_json_append_hex(hex, c.b);
+  }
+  *hex++ = '"';
+  *hex++ = '}';
+  *hex = '\0';
+  return hex - out;
+}
+
+// A build run against the published status (status_monitor_view())
+struct Build {
+  uint32_t since;  // Deltas only
+  bool delta;
+  const char* out;
+  size_t length;
+  uint32_t version;
+};
+
+static void build(const GameStatus& status, void* arg) {
+  Build& b = *(Build*)arg;
+  uint32_t fields = b.delta ? status_changed_since(status, b.since) : STATUS_ALL_FIELDS;
+  if (fields & STATUS_BIT(STATUS_FIELD_LEDS)) {
+    b.length = writeFields(status, fields, json, sizeof(json));
+    b.out = json;
+  } else {
+    b.length = writeFields(status, fields, deltaJson, sizeof(deltaJson));
+    b.out = deltaJson;
+  }
+  b.version = status.version;
+}
+
+const char* status_json_get(size_t& length, uint32_t& version) {
+  if (!jsonValid || status_monitor_version() != jsonVersion) {
+    Build b = {0, false, nullptr, 0, 0};
+    status_monitor_view(build, &b);
+    jsonLength = b.length;
+    // The status may be newer than the version that triggered the build
+    jsonVersion = b.version;
+    jsonValid = true;
+  }
+  length = jsonLength;
+  version = jsonVersion;
+  return json;
+}
+
+const char* status_json_get_delta(uint32_t since, size_t& length, uint32_t& version) {
+  Build b = {since, true, nullptr, 0, 0};
+  status_monitor_view(build, &b);
+  if (b.out == json) {
+    jsonValid = false;
+  }
+  length = b.length;
+  version = b.version;
+  return b.out;
+}
@@ -0,0 +1,40 @@
+// Status JSON
+// Serializes the published GameStatus (status_monitor.h) only when a
+// consumer asks for it (GET /status, MQTT) and keeps the result until the
+// status version moves on, so an idle loop() pays nothing for JSON and any
+// number of readers of one version share a single build. Readers that
+// keep their own copy can ask for just the fields that changed instead.
+// Network side only: the cache is not shared between tasks.
+
+#ifndef STATUS_JSON_H
+#define STATUS_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../config/led_config.h"
+
+// Every field but the LEDs
+#define STATUS_JSON_FIELDS_BYTES 1024
+
+// The document with every LED as six hex digits
+#define STATUS_JSON_BYTES (NUM_LEDS * 6 + STATUS_JSON_FIELDS_BYTES)
+
+// Latest status as NUL-terminated JSON, rebuilt only if the status changed
+// since the previous call. Sets length and the status version it shows
+const char* status_json_get(size_t& length, uint32_t& version);
+
+// Latest status with only the fields that changed after version since
+// (plus "version" and "timestamp"), for consumers that already hold that
+// version. Built on every call into a buffer the next call of either
+// function may reuse; a delta with the LEDs replaces the cached document
+const char* status_json_get_delta(uint32_t since, size_t& length, uint32_t& version);
+
+// Write one byte as two lowercase hex digits; returns the next write position
+inline char* status_json_append_hex(char* out, uint8_t b) {
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  *out++ = HEX_DIGITS[b >> 4];
+  *out++ = HEX_DIGITS[b & 0x0F];
+  return out;
+}
+
+#endif // STATUS_JSON_H
@@ -2,13 +2,26 @@
 
 #include "web_server.h"
 #include "../status/status_monitor.h"
+#include "../status/perf_probe.h"
+#include "../status/frame_timing.h"
+#include "../status/input_latency.h"
 #include "../games/game_manager.h"
+#include "../input/input_recorder.h"
+#include "../render/frame_output.h"
+#include "network_task.h"
+#include "status_json.h"
 #include <ArduinoJson.h>
 #include <WiFi.h>
+#include <memory>
+#include <new>
 
 static WebServer* server = nullptr;
 static bool serverRunning = false;
 
+// Status ETags are "<boot>-<version>": versions restart at every boot, so a
+// browser holding an older boot's tag never matches the new one
+static uint32_t statusBootTag = 0;
+
 // HTML dashboard
 static const char* html_dashboard = R"html(
 <!DOCTYPE html>
@@ -31,8 +44,10 @@ static const char* html_dashboard = R"html(
         button { background: #2196F3; color: white; border: none; padding: 10px 20px; border-radius: 4px; cursor: pointer; margin: 5px; }
         button:hover { background: #1976D2; }
         #refreshStatus { color: #4CAF50; font-size: 14px; margin-left: 10px; }
-        .led-strip { display: flex; gap: 5px; margin: 20px 0; padding: 10px; background: #1a1a1a; border-radius: 8px; }
+        .led-strip { display: flex; flex-wrap: wrap; gap: 5px; margin: 20px 0; padding: 10px; background: #1a1a1a; border-radius: 8px; }
+        .led-strip.dense { gap: 1px; }
         .led-pixel { width: 40px; height: 40px; border-radius: 4px; border: 2px solid #333; transition: all 0.1s; }
+        .led-strip.dense .led-pixel { width: 6px; height: 12px; border-radius: 1px; border: none; transition: none; }
         .led-label { font-size: 10px; text-align: center; color: #888; margin-top: 5px; }
         .game-selector { display: grid; grid-template-columns: repeat(auto-fill, minmax(120px, 1fr)); gap: 10px; margin: 10px 0; }
         .game-button { background: #333; color: white; border: 2px solid #555; padding: 10px; border-radius: 4px; cursor: pointer; text-align: center; }
@@ -52,38 +67,7 @@ static const char* html_dashboard = R"html(
         <div class="card">
             <h3>LED Strip Simulation</h3>
             <div class="led-strip" id="ledStrip">
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led0" style="background: #000;"></div>
-                    <div class="led-label">0</div>
-                </div>
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led1" style="background: #000;"></div>
-                    <div class="led-label">1</div>
-                </div>
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led2" style="background: #000;"></div>
-                    <div class="led-label">2</div>
-                </div>
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led3" style="background: #000;"></div>
-                    <div class="led-label">3</div>
-                </div>
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led4" style="background: #000;"></div>
-                    <div class="led-label">4</div>
-                </div>
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led5" style="background: #000;"></div>
-                    <div class="led-label">5</div>
-                </div>
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led6" style="background: #000;"></div>
-                    <div class="led-label">6</div>
-                </div>
-                <div style="display: flex; flex-direction: column; align-items: center;">
-                    <div class="led-pixel" id="led7" style="background: #000;"></div>
-                    <div class="led-label">7</div>
-                </div>
+                <!-- Pixels are created by JavaScript to match numLeds -->
             </div>
         </div>
         <div class="card">
@@ -112,11 +96,40 @@ static const char* html_dashboard = R"html(
     <script>
         let autoRefreshInterval = null;
 
-        function rgbToHex(r, g, b) {
-            return '#' + [r, g, b].map(x => {
-                const hex = x.toString(16);
-                return hex.length === 1 ? '0' + hex : hex;
-            }).join('');
+        // Longer strips are drawn as compact unlabelled pixels
+        const MAX_LABELLED_LEDS = 16;
+        let ledPixels = [];
+
+        function buildStrip(count) {
+            if (ledPixels.length === count) {
+                return ledPixels;
+            }
+
+            const strip = document.getElementById('ledStrip');
+            const labelled = count <= MAX_LABELLED_LEDS;
+            strip.innerHTML = '';
+            strip.className = 'led-strip' + (labelled ? '' : ' dense');
+            ledPixels = [];
+
+            for (let i = 0; i < count; i++) {
+                const pixel = document.createElement('div');
+                pixel.className = 'led-pixel';
+                pixel.style.background = '#000';
+                if (labelled) {
+                    const cell = document.createElement('div');
+                    cell.style.cssText = 'display: flex; flex-direction: column; align-items: center;';
+                    const label = document.createElement('div');
+                    label.className = 'led-label';
+                    label.textContent = i;
+                    cell.appendChild(pixel);
+                    cell.appendChild(label);
+                    strip.appendChild(cell);
+                } else {
+                    strip.appendChild(pixel);
+                }
+                ledPixels.push(pixel);
+            }
+            return ledPixels;
         }
 
         function updateStatus(data) {
@@ -132,23 +145,19 @@ static const char* html_dashboard = R"html(
             document.getElementById('gameState').textContent = 'State: ' + states[data.state];
 
             // Update LED strip
-            if (data.leds && Array.isArray(data.leds)) {
-                for (let i = 0; i < 8; i++) {
-                    const led = document.getElementById('led' + i);
-                    if (led) {
-                        if (data.leds[i] && typeof data.leds[i] === 'object') {
-                            const r = parseInt(data.leds[i].r) || 0;
-                            const g = parseInt(data.leds[i].g) || 0;
-                            const b = parseInt(data.leds[i].b) || 0;
-                            led.style.background = rgbToHex(r, g, b);
-                            // Add brightness effect
-                            const brightness = Math.max(r, g, b);
-                            led.style.boxShadow = brightness > 0 ? `0 0 ${brightness / 10}px ${rgbToHex(r, g, b)}` : 'none';
-                        } else {
-                            // Fallback if LED data is missing
-                            led.style.background = '#000';
-                            led.style.boxShadow = 'none';
-                        }
+            if (typeof data.leds === 'string') {
+                const count = data.numLeds || data.leds.length / 6;
+                const pixels = buildStrip(count);
+                for (let i = 0; i < count; i++) {
+                    const hex = '#' + (data.leds.substr(i * 6, 6) || '000000');
+                    pixels[i].style.background = hex;
+                    if (count <= MAX_LABELLED_LEDS) {
+                        // Add brightness effect
+                        const brightness = Math.max(
+                            parseInt(hex.substr(1, 2), 16),
+                            parseInt(hex.substr(3, 2), 16),
+                            parseInt(hex.substr(5, 2), 16)) || 0;
+                        pixels[i].style.boxShadow = brightness > 0 ? `0 0 ${brightness / 10}px ${hex}` : 'none';
                     }
                 }
             }
@@ -270,29 +279,211 @@ static const char* html_dashboard = R"html(
 </html>
 )html";
 
-// JSON status endpoint
+static void formatStatusETag(char* out, size_t size, uint32_t version) {
+  snprintf(out, size, "\"%08lx-%lx\"", (unsigned long)statusBootTag, (unsigned long)version);
+}
+
+// JSON status endpoint: the cached serialization of the latest status, or
+// 304 Not Modified (no body, no serialization) if the client already has it.
+// ?since=<version> answers with only the fields changed after that version
 void handleStatus() {
-  GameStatus status = status_monitor_get();
+  size_t length;
+  uint32_t version;
+  if (server->hasArg("since")) {
+    uint32_t since = strtoul(server->arg("since").c_str(), nullptr, 10);
+    const char* delta = status_json_get_delta(since, length, version);
+    server->sendHeader("Cache-Control", "no-store");
+    server->send_P(200, "application/json", delta, length);
+    return;
+  }
 
-  // Increased size to accommodate LED array (8 LEDs * ~20 bytes each = 160 bytes, plus other fields)
-  StaticJsonDocument<768> doc;
-  doc["gameName"] = status.gameName;
-  doc["score"] = status.score;
-  doc["state"] = status.state;
-  doc["leftPressed"] = status.leftPressed;
-  doc["rightPressed"] = status.rightPressed;
-  doc["actionPressed"] = status.actionPressed;
-  doc["altPressed"] = status.altPressed;
-  doc["timestamp"] = status.timestamp;
-
-  // Add LED array - ensure all 8 LEDs are included
-  JsonArray ledsArray = doc.createNestedArray("leds");
-  for (int i = 0; i < 8; i++) {
-    JsonObject led = ledsArray.createNestedObject();
-    led["r"] = (int)status.leds[i].r;
-    led["g"] = (int)status.leds[i].g;
-    led["b"] = (int)status.leds[i].b;
+  char etag[24];
+  formatStatusETag(etag, sizeof(etag), status_monitor_version());
+  // Browsers revalidate every poll instead of trusting a stale copy
+  server->sendHeader("Cache-Control", "no-cache");
+
+  if (server->hasHeader("If-None-Match") && server->header("If-None-Match").indexOf(etag) >= 0) {
+    server->sendHeader("ETag", etag);
+    server->send(304);
+    return;
+  }
+
+  const char* json = status_json_get(length, version);
+  formatStatusETag(etag, sizeof(etag), version);
+  server->sendHeader("ETag", etag);
+  server->send_P(200, "application/json", json, length);
+}
+
+// Input recording of the current run (RLE stream as hex, see input_rle.h)
+void handleRecording() {
+  // A debug endpoint: borrow the heap for the request (as /frametime)
+  std::unique_ptr<InputRecording> copy(new (std::nothrow) InputRecording);
+  std::unique_ptr<char[]> dataHex(new (std::nothrow) char[INPUT_RECORDING_BYTES * 2 + 1]);
+  if (!copy || !dataHex) {
+    server->send(503, "text/plain", "Service Unavailable: Out of memory");
+    return;
   }
+  InputRecording& recording = *copy;
+
+  // The recorder belongs to the game task; ask it for a copy between frames
+  if (network_task_is_running()) {
+    if (!input_recorder_request_export(recording, 200)) {
+      server->send(503, "text/plain", "Service Unavailable: Game task busy");
+      return;
+    }
+  } else {
+    input_recorder_export(recording);
+  }
+
+  char* out = dataHex.get();
+  for (uint16_t i = 0; i < recording.length; i++) {
+    out = status_json_append_hex(out, recording.data[i]);
+  }
+  *out = '\0';
+
+  StaticJsonDocument<256> doc;
+  doc["gameId"] = recording.gameId;
+  doc["seed"] = recording.seed;
+  doc["ticks"] = recording.ticks;
+  doc["truncated"] = recording.truncated;
+  doc["data"] = (const char*)dataHex.get();
+
+  String response;
+  serializeJson(doc, response);
+
+  server->send(200, "application/json", response);
+}
+
+// Loop phase timings: last closed window per phase (see perf_probe.h)
+void handleMetrics() {
+  StaticJsonDocument<1280> doc;
+  doc["windowMs"] = PERF_WINDOW_MS;
+  doc["cpuMhz"] = perf_probe_cycles_per_us();
+  JsonArray phases = doc.createNestedArray("phases");
+
+  uint32_t now = millis();
+  for (uint8_t i = 0; i < PERF_PHASE_COUNT; i++) {
+    PerfSummary s;
+    if (!perf_probe_get((PerfPhase)i, s)) {
+      continue;  // Phase not running in this configuration
+    }
+    JsonObject phase = phases.createNestedObject();
+    phase["phase"] = perf_probe_phase_name((PerfPhase)i);
+    phase["count"] = s.count;
+    phase["minNs"] = s.minNs;
+    phase["avgNs"] = s.avgNs;
+    phase["maxNs"] = s.maxNs;
+    phase["p99Ns"] = s.p99Ns;
+    phase["ageMs"] = now - s.windowEndMs;
+  }
+
+  // Strip frames since boot: show() calls saved by unchanged frames
+  FrameOutputStats frames = frame_output_get_stats();
+  JsonObject output = doc.createNestedObject("frames");
+  output["sent"] = frames.sent;
+  output["skipped"] = frames.skipped;
+  output["deferred"] = frames.deferred;
+
+  String response;
+  serializeJson(doc, response);
+
+  server->send(200, "application/json", response);
+}
+
+static void addHistogram(JsonObject out, const FrameHistogram& h) {
+  out["count"] = h.count;
+  out["maxUs"] = h.maxUs;
+  JsonArray buckets = out.createNestedArray("buckets");
+  for (uint8_t i = 0; i < FRAME_HIST_BUCKETS; i++) {
+    buckets.add(h.buckets[i]);
+  }
+}
+
+// Loop time and tick latency histograms (bucket i: [2^i, 2^(i+1)) us) and
+// the stall log
+void handleFrameTiming() {
+  // Rarely requested and too large for the network task's stack: borrow
+  // the heap for the request instead of reserving RAM for the whole uptime
+  std::unique_ptr<FrameTimingSnapshot> snapshot(new (std::nothrow) FrameTimingSnapshot);
+  DynamicJsonDocument doc(8192);
+  if (!snapshot || doc.capacity() == 0) {
+    server->send(503, "text/plain", "Service Unavailable: Out of memory");
+    return;
+  }
+  frame_timing_get(*snapshot);
+  const FrameTimingSnapshot& timing = *snapshot;
+
+  doc["stallThresholdUs"] = FRAME_STALL_US;
+  addHistogram(doc.createNestedObject("loop"), timing.loop);
+
+  JsonArray ticks = doc.createNestedArray("tickLatency");
+  for (uint8_t id = 0; id < game_manager_get_game_count() && id < FRAME_TIMING_MAX_GAMES; id++) {
+    if (timing.tickLatency[id].count == 0) {
+      continue;  // Not played since boot
+    }
+    JsonObject game = ticks.createNestedObject();
+    game["gameId"] = id;
+    addHistogram(game, timing.tickLatency[id]);
+  }
+
+  doc["stallCount"] = timing.stallCount;
+  JsonArray stalls = doc.createNestedArray("stalls");
+  for (uint32_t n = frame_timing_first_logged(timing); n < timing.stallCount; n++) {
+    const StallRecord& r = timing.stalls[n % FRAME_STALL_LOG];
+    JsonObject stall = stalls.createNestedObject();
+    stall["timestamp"] = r.timestampMs;
+    stall["gameId"] = r.gameId;
+    stall["phase"] = perf_probe_phase_name(r.phase);
+    stall["durationUs"] = r.durationUs;
+    stall["phaseUs"] = r.phaseUs;
+  }
+
+  String response;
+  serializeJson(doc, response);
+
+  server->send(200, "application/json", response);
+}
+
+static void addPercentiles(JsonObject out, const LogHistogram& h) {
+  out["count"] = h.total;
+  out["p50Us"] = log_histogram_percentile(h, 50);
+  out["p90Us"] = log_histogram_percentile(h, 90);
+  out["p99Us"] = log_histogram_percentile(h, 99);
+  out["maxUs"] = h.max;
+}
+
+// Touch-to-photon latency per game, and where it goes (see input_latency.h);
+// percentiles are log-linear bucket bounds, within 25%
+void handleInputLatency() {
+  // Request-scoped like /frametime: nothing stays reserved between requests
+  std::unique_ptr<InputLatencySnapshot> snapshot(new (std::nothrow) InputLatencySnapshot);
+  DynamicJsonDocument doc(4096);
+  if (!snapshot || doc.capacity() == 0) {
+    server->send(503, "text/plain", "Service Unavailable: Out of memory");
+    return;
+  }
+  input_latency_get(*snapshot);
+  const InputLatencySnapshot& latency = *snapshot;
+
+  doc["enabled"] = INPUT_LATENCY_TRACE != 0;
+  doc["skipped"] = latency.skipped;
+
+  JsonArray games = doc.createNestedArray("games");
+  for (uint8_t id = 0; id < game_manager_get_game_count() && id < FRAME_TIMING_MAX_GAMES; id++) {
+    const InputLatencyGame& g = latency.games[id];
+    if (g.latency.total == 0 && g.unanswered == 0) {
+      continue;
+    }
+    JsonObject game = games.createNestedObject();
+    game["gameId"] = id;
+    addPercentiles(game, g.latency);
+    game["unanswered"] = g.unanswered;
+  }
+
+  JsonObject stages = doc.createNestedObject("stages");
+  addPercentiles(stages.createNestedObject("toTick"), latency.toTick);
+  addPercentiles(stages.createNestedObject("toFrame"), latency.toFrame);
+  addPercentiles(stages.createNestedObject("toShow"), latency.toShow);
 
   String response;
   serializeJson(doc, response);
@@ -359,12 +550,13 @@ void handleGameSelect() {
     return;
   }
 
+  // Handlers may run on the network task: the game task applies the switch
   uint8_t gameId = doc["gameId"];
-  if (game_manager_set_game(gameId)) {
+  if (game_manager_request_game(gameId)) {
     StaticJsonDocument<256> responseDoc;
     responseDoc["success"] = true;
     responseDoc["gameId"] = gameId;
-    responseDoc["gameName"] = game_manager_get_current_game_name();
+    responseDoc["gameName"] = game_manager_get_game_info(gameId)->name;
 
     String response;
     serializeJson(responseDoc, response);
@@ -390,6 +582,11 @@ void web_server_init() {
   }
 
   server = new WebServer(80);
+  statusBootTag = esp_random();
+
+  // WebServer drops request headers it was not told to keep
+  static const char* collectedHeaders[] = {"If-None-Match"};
+  server->collectHeaders(collectedHeaders, 1);
 
   // Register handlers with explicit HTTP methods
   server->on("/", HTTP_GET, handleRoot);
@@ -397,6 +594,10 @@ void web_server_init() {
   server->on("/games", HTTP_GET, handleGames);
   server->on("/game/current", HTTP_GET, handleGameCurrent);
   server->on("/game/select", HTTP_POST, handleGameSelect);
+  server->on("/recording", HTTP_GET, handleRecording);
+  server->on("/metrics", HTTP_GET, handleMetrics);
+  server->on("/frametime", HTTP_GET, handleFrameTiming);
+  server->on("/latency", HTTP_GET, handleInputLatency);
   server->onNotFound(handleNotFound);
 
   server->begin();
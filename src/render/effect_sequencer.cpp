@@ -0,0 +1,70 @@
+// Effect sequencer implementation
+
+#include "effect_sequencer.h"
+#include "frame_output.h"
+#include <FastLED.h>
+#include "../config/led_config.h"
+
+extern CRGB leds[];
+
+static FlashEffect currentEffect = {0, 0, 0, 0, 0};
+static EffectDoneFunc doneFunc = nullptr;
+static uint32_t elapsed = 0;
+static bool active = false;
+
+// Last colour painted, so the strip is only refilled on keyframe edges
+static uint32_t shownColor = 0;
+static bool shown = false;
+
+static void paint(uint32_t color) {
+  if (!shown || color != shownColor) {
+    fill_solid(leds, NUM_LEDS, CRGB(color));
+    shownColor = color;
+    shown = true;
+  }
+  // Unchanged frames are skipped; a deferred edge is retried next frame
+  frame_output_show();
+}
+
+bool effect_sequencer_play(const FlashEffect& effect, EffectDoneFunc onDone) {
+  if (active) {
+    return false;
+  }
+
+  currentEffect = effect;
+  doneFunc = onDone;
+  elapsed = 0;
+  shown = false;
+  active = true;
+  return true;
+}
+
+bool effect_sequencer_is_active() {
+  return active;
+}
+
+void effect_sequencer_cancel() {
+  active = false;
+  doneFunc = nullptr;
+}
+
+bool effect_sequencer_update(uint32_t dt) {
+  if (!active) {
+    return false;
+  }
+
+  if (elapsed >= flash_effect_duration_ms(currentEffect)) {
+    // Clear state first: the callback may start a new effect
+    EffectDoneFunc done = doneFunc;
+    active = false;
+    doneFunc = nullptr;
+    if (done) {
+      done();
+    }
+    return active;
+  }
+
+  paint(flash_effect_color_at(currentEffect, elapsed));
+  elapsed += dt;
+  return true;
+}
@@ -0,0 +1,49 @@
+// Non-blocking LED effect sequencer
+// Plays short full-strip effects (game over / win flashes) frame by frame
+// instead of spinning in delay(), so loop() keeps servicing input and HTTP
+
+#ifndef EFFECT_SEQUENCER_H
+#define EFFECT_SEQUENCER_H
+
+#include <stdint.h>
+
+// Flash effect keyframes: `count` x (onMs lit, offMs dark), then holdMs dark
+struct FlashEffect {
+  uint32_t color;   // 0xRRGGBB (CRGB::HTMLColorCode values work directly)
+  uint8_t count;
+  uint16_t onMs;
+  uint16_t offMs;
+  uint16_t holdMs;
+};
+
+// Called once when an effect runs to completion (not when cancelled)
+typedef void (*EffectDoneFunc)();
+
+// Total effect length in milliseconds
+inline uint32_t flash_effect_duration_ms(const FlashEffect& effect) {
+  return (uint32_t)effect.count * (effect.onMs + effect.offMs) + effect.holdMs;
+}
+
+// Strip colour `elapsed` ms into the effect (0 = dark)
+inline uint32_t flash_effect_color_at(const FlashEffect& effect, uint32_t elapsed) {
+  uint32_t period = (uint32_t)effect.onMs + effect.offMs;
+  if (period == 0 || elapsed >= (uint32_t)effect.count * period) {
+    return 0;
+  }
+  return (elapsed % period) < effect.onMs ? effect.color : 0;
+}
+
+// Start an effect. Returns false (and ignores the request) if one is already playing
+bool effect_sequencer_play(const FlashEffect& effect, EffectDoneFunc onDone);
+
+// Check if an effect currently owns the strip
+bool effect_sequencer_is_active();
+
+// Stop the current effect without calling its completion callback
+void effect_sequencer_cancel();
+
+// Advance the current effect by dt (call once per frame)
+// Returns true while the effect owns the strip this frame
+bool effect_sequencer_update(uint32_t dt);
+
+#endif // EFFECT_SEQUENCER_H
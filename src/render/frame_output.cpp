@@ -0,0 +1,42 @@
+// Frame output implementation
+
+#include "frame_output.h"
+#include "led_output.h"
+#include <FastLED.h>
+#include "../config/led_config.h"
+#include "../status/input_latency.h"
+
+extern CRGB leds[];
+
+static uint32_t lastHash = 0;
+static bool valid = false;
+static FrameOutputStats stats = {0, 0, 0};
+
+bool frame_output_show() {
+  uint32_t hash = frame_hash((const uint8_t*)leds, NUM_LEDS * sizeof(CRGB));
+
+  if (valid && hash == lastHash) {
+    stats.skipped++;
+    return false;
+  }
+
+  // Driver still sending the previous frame: keep this one for next time
+  if (!led_output_show((const uint8_t*)leds)) {
+    stats.deferred++;
+    return false;
+  }
+
+  lastHash = hash;
+  valid = true;
+  stats.sent++;
+  input_latency_frame_sent(led_output_get_stats().framesSent);
+  return true;
+}
+
+void frame_output_invalidate() {
+  valid = false;
+}
+
+FrameOutputStats frame_output_get_stats() {
+  return stats;
+}
@@ -0,0 +1,39 @@
+// Frame output stage
+// Pushes leds[] to the strip only when the framebuffer changed since the
+// last transmission (WS2812B show() costs ~30us per LED with interrupts held)
+
+#ifndef FRAME_OUTPUT_H
+#define FRAME_OUTPUT_H
+
+#include <stdint.h>
+
+// Frames pushed to the strip vs. frames skipped as unchanged
+struct FrameOutputStats {
+  uint32_t sent;
+  uint32_t skipped;
+  uint32_t deferred;  // Changed, but the previous frame was still sending
+};
+
+// FNV-1a hash of a framebuffer
+inline uint32_t frame_hash(const uint8_t* data, uint32_t len) {
+  uint32_t hash = 2166136261u;
+  for (uint32_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Show leds[] if it differs from the last frame sent
+// Returns true if the frame was handed to the LED output stage
+// (false if unchanged, or deferred because the previous frame is still sending)
+bool frame_output_show();
+
+// Force the next frame_output_show() to transmit (e.g. after a brightness change)
+void frame_output_invalidate();
+
+// Get sent/skipped/deferred counters since boot (safe from any task;
+// GET /metrics reports them)
+FrameOutputStats frame_output_get_stats();
+
+#endif // FRAME_OUTPUT_H
@@ -0,0 +1,105 @@
+// LED output implementation
+// FastLED's ESP32 RMT driver refills the peripheral from its interrupt and
+// parks the calling task on a semaphore until the frame is out, so calling
+// show() from a dedicated task frees loop() for the whole transfer
+
+#include "led_output.h"
+#include "../status/perf_probe.h"
+#include <FastLED.h>
+#include <atomic>
+
+#define LED_OUTPUT_TASK_CORE 1
+#define LED_OUTPUT_TASK_STACK 2048
+#define LED_OUTPUT_TASK_PRIORITY 2  // Above loop() so a frame starts immediately
+
+static LedOutput output;
+static TaskHandle_t outputTask = nullptr;
+static std::atomic<bool> transmitting{false};
+static std::atomic<uint32_t> framesDone{0};
+static std::atomic<uint32_t> lastDoneUs{0};
+
+// Output task (or loop() with the blocking fallback), after show() returns
+static void frameDone() {
+  lastDoneUs.store(micros(), std::memory_order_relaxed);
+  framesDone.fetch_add(1, std::memory_order_release);
+}
+
+static void outputTaskFn(void* param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    {
+      PerfProbe probe(PERF_SHOW);
+      FastLED.show();
+    }
+    frameDone();
+    transmitting.store(false, std::memory_order_release);
+  }
+}
+
+static void rmtTransmit(const uint8_t* front, uint16_t numLeds) {
+  transmitting.store(true, std::memory_order_release);
+  xTaskNotifyGive(outputTask);
+}
+
+static bool rmtIsBusy() {
+  return transmitting.load(std::memory_order_acquire);
+}
+
+// Fallback if the output task cannot be created: blocking show()
+static void syncTransmit(const uint8_t* front, uint16_t numLeds) {
+  {
+    PerfProbe probe(PERF_SHOW);
+    FastLED.show();
+  }
+  frameDone();
+}
+
+static bool syncIsBusy() {
+  return false;
+}
+
+static const LedDriver RMT_TASK_DRIVER = {rmtTransmit, rmtIsBusy};
+static const LedDriver SYNC_DRIVER = {syncTransmit, syncIsBusy};
+
+void led_output_init(uint8_t* front, uint16_t numLeds) {
+  framesDone.store(0, std::memory_order_relaxed);
+  BaseType_t result = xTaskCreatePinnedToCore(
+    outputTaskFn,
+    "led_output",
+    LED_OUTPUT_TASK_STACK,
+    nullptr,
+    LED_OUTPUT_TASK_PRIORITY,
+    &outputTask,
+    LED_OUTPUT_TASK_CORE
+  );
+
+  if (result == pdPASS) {
+    led_output_setup(output, front, numLeds, &RMT_TASK_DRIVER);
+  } else {
+    outputTask = nullptr;
+    led_output_setup(output, front, numLeds, &SYNC_DRIVER);
+    Serial.println("LED output task creation failed, using blocking show()");
+  }
+}
+
+void led_output_init_with_driver(uint8_t* front, uint16_t numLeds, const LedDriver* driver) {
+  framesDone.store(0, std::memory_order_relaxed);
+  led_output_setup(output, front, numLeds, driver);
+}
+
+bool led_output_show(const uint8_t* back) {
+  return led_output_submit(output, back);
+}
+
+LedOutputStats led_output_get_stats() {
+  return output.stats;
+}
+
+LedOutputDone led_output_get_done() {
+  // Only the caller's task submits frames, so no newer frame can finish
+  // between the two loads once this one has
+  LedOutputDone done;
+  done.frames = framesDone.load(std::memory_order_acquire);
+  done.us = lastDoneUs.load(std::memory_order_relaxed);
+  return done;
+}
@@ -0,0 +1,85 @@
+// Asynchronous LED output stage
+// Games render into the back buffer (leds[]); at a frame boundary the
+// finished frame is copied into the front buffer and streamed out by the
+// driver while the next frame is simulated. The back buffer is copied rather
+// than pointer-swapped because games fade the previous frame (trails).
+
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <stdint.h>
+#include <string.h>
+
+// WS2812B wire time: 24 bits x 1.25us per LED, plus >=50us reset latch
+static constexpr uint32_t WS2812B_US_PER_LED = 30;
+static constexpr uint32_t WS2812B_LATCH_US = 50;
+
+// Wire time for one frame in microseconds
+inline uint32_t led_frame_tx_us(uint16_t numLeds) {
+  return (uint32_t)numLeds * WS2812B_US_PER_LED + WS2812B_LATCH_US;
+}
+
+// Transport behind the output stage (RMT task on device, mock on native)
+struct LedDriver {
+  void (*transmit)(const uint8_t* front, uint16_t numLeds);  // Start sending, must not block
+  bool (*isBusy)();                                           // Previous frame still on the wire
+};
+
+struct LedOutputStats {
+  uint32_t framesSent;      // Frames copied to the front buffer and started
+  uint32_t framesDeferred;  // Frame boundaries that found the driver still busy
+  uint32_t txMicros;        // Wire time handed off to the driver (not spent in loop())
+};
+
+struct LedOutput {
+  uint8_t* front;       // numLeds * 3 bytes, owned by the driver while busy
+  uint16_t numLeds;
+  const LedDriver* driver;
+  LedOutputStats stats;
+};
+
+inline void led_output_setup(LedOutput& out, uint8_t* front, uint16_t numLeds, const LedDriver* driver) {
+  out.front = front;
+  out.numLeds = numLeds;
+  out.driver = driver;
+  out.stats = {0, 0, 0};
+}
+
+// Swap in the finished back buffer and start sending it
+// Returns false if the previous frame is still on the wire; the caller keeps
+// the frame and offers it again at the next frame boundary
+inline bool led_output_submit(LedOutput& out, const uint8_t* back) {
+  if (out.driver->isBusy()) {
+    out.stats.framesDeferred++;
+    return false;
+  }
+
+  memcpy(out.front, back, (size_t)out.numLeds * 3);
+  out.driver->transmit(out.front, out.numLeds);
+  out.stats.framesSent++;
+  out.stats.txMicros += led_frame_tx_us(out.numLeds);
+  return true;
+}
+
+// Device output stage: front buffer must be the array registered with FastLED.addLeds()
+void led_output_init(uint8_t* front, uint16_t numLeds);
+
+// Same, over the given driver instead of FastLED (host tests that need the
+// wire busy on cue)
+void led_output_init_with_driver(uint8_t* front, uint16_t numLeds, const LedDriver* driver);
+
+// Submit the back buffer (see led_output_submit)
+bool led_output_show(const uint8_t* back);
+
+// Get output counters
+LedOutputStats led_output_get_stats();
+
+// Frames that have left FastLED.show() since init, and micros() when the
+// latest one did (frame n is done once frames >= n, counting framesSent)
+struct LedOutputDone {
+  uint32_t frames;
+  uint32_t us;
+};
+LedOutputDone led_output_get_done();
+
+#endif // LED_OUTPUT_H
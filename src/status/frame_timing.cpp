@@ -0,0 +1,106 @@
+// Frame timing implementation
+
+#include "frame_timing.h"
+#include "snapshot_buffer.h"
+#include <Arduino.h>
+
+static FrameTimingSnapshot live;
+static SnapshotBuffer<FrameTimingSnapshot> published;
+static uint32_t lastPublishMs = 0;
+
+// Current iteration
+static uint32_t iterStartUs = 0;
+static uint32_t iterStartCycles = 0;
+static uint32_t markCycles = 0;
+static uint32_t phaseCycles[PERF_PHASE_COUNT];
+static bool phaseRan[PERF_PHASE_COUNT];
+
+static void publish() {
+  published.back() = live;
+  published.publish();
+  lastPublishMs = millis();
+}
+
+void frame_timing_begin() {
+  iterStartUs = micros();
+  iterStartCycles = perf_probe_cycles();
+  markCycles = iterStartCycles;
+  for (uint8_t i = 0; i < PERF_PHASE_COUNT; i++) {
+    phaseCycles[i] = 0;
+    phaseRan[i] = false;
+  }
+}
+
+void frame_timing_lap(PerfPhase phase) {
+  uint32_t now = perf_probe_cycles();
+  if (phase < PERF_PHASE_COUNT) {
+    phaseCycles[phase] += now - markCycles;
+    phaseRan[phase] = true;
+  }
+  markCycles = now;
+}
+
+void frame_timing_end(uint8_t gameId) {
+  uint32_t durationUs = micros() - iterStartUs;
+  uint32_t loopCycles = perf_probe_cycles() - iterStartCycles;
+  frame_hist_add(live.loop, durationUs);
+
+  // One probe sample per phase per iteration; PERF_LOOP gets the whole
+  // loop() pass (perf_probe.h). Only the stall blame below uses the time
+  // no phase lapped
+  uint32_t lapped = 0;
+  PerfPhase longest = PERF_LOOP;
+  for (uint8_t i = 0; i < PERF_PHASE_COUNT; i++) {
+    if (phaseRan[i]) {
+      perf_probe_record((PerfPhase)i, phaseCycles[i]);
+      lapped += phaseCycles[i];
+      if (longest == PERF_LOOP || phaseCycles[i] > phaseCycles[longest]) {
+        longest = (PerfPhase)i;
+      }
+    }
+  }
+  perf_probe_record(PERF_LOOP, loopCycles);
+
+  bool stalled = durationUs >= FRAME_STALL_US;
+  if (stalled) {
+    uint32_t unlapped = loopCycles - lapped;
+    uint32_t blamed = longest == PERF_LOOP ? 0 : phaseCycles[longest];
+    if (unlapped > blamed) {
+      longest = PERF_LOOP;
+      blamed = unlapped;
+    }
+
+    StallRecord& r = live.stalls[live.stallCount % FRAME_STALL_LOG];
+    r.timestampMs = millis();
+    r.durationUs = durationUs;
+    r.phaseUs = blamed / perf_probe_cycles_per_us();
+    r.gameId = gameId;
+    r.phase = longest;
+    live.stallCount++;
+  }
+
+  if (stalled || millis() - lastPublishMs >= FRAME_TIMING_PUBLISH_MS) {
+    publish();
+  }
+}
+
+void frame_timing_record_tick_latency(uint8_t gameId, uint32_t us) {
+  if (gameId < FRAME_TIMING_MAX_GAMES) {
+    frame_hist_add(live.tickLatency[gameId], us);
+  }
+}
+
+uint32_t frame_timing_get_stall_count() {
+  return live.stallCount;
+}
+
+const StallRecord* frame_timing_get_last_stall() {
+  if (live.stallCount == 0) {
+    return nullptr;
+  }
+  return &live.stalls[(live.stallCount - 1) % FRAME_STALL_LOG];
+}
+
+void frame_timing_get(FrameTimingSnapshot& out) {
+  published.read(out);
+}
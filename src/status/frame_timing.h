@@ -0,0 +1,91 @@
+// Frame timing and stall detection
+// loop() iteration time and per-game tick latency go into fixed log2
+// histograms; an iteration longer than FRAME_STALL_US is logged with the
+// game and the loop phase that took longest. loop() marks its phases with
+// frame_timing_lap(), which also feeds the per-phase probes (perf_probe.h).
+// Written by the game task; other tasks read the copy published every
+// FRAME_TIMING_PUBLISH_MS and on every stall.
+
+#ifndef FRAME_TIMING_H
+#define FRAME_TIMING_H
+
+#include <stdint.h>
+#include "perf_probe.h"
+
+// Bucket i counts [2^i, 2^(i+1)) us (bucket 0 also takes 0 and 1us); the
+// last one is open-ended, from 2^19us (~0.5s) up
+#define FRAME_HIST_BUCKETS 20
+
+// Iterations at least this long are stalls (~3 frames at 60fps)
+#define FRAME_STALL_US 50000
+
+// Stalls kept in the log (most recent)
+#define FRAME_STALL_LOG 16
+
+// Tick latency is kept for game IDs below this
+#define FRAME_TIMING_MAX_GAMES 16
+
+#define FRAME_TIMING_PUBLISH_MS 1000
+
+struct FrameHistogram {
+  uint32_t buckets[FRAME_HIST_BUCKETS];
+  uint32_t count;
+  uint32_t maxUs;
+};
+
+inline uint8_t frame_hist_bucket(uint32_t us) {
+  if (us < 2) {
+    return 0;
+  }
+  uint8_t msb = 31 - __builtin_clz(us);
+  return msb < FRAME_HIST_BUCKETS ? msb : FRAME_HIST_BUCKETS - 1;
+}
+
+inline void frame_hist_add(FrameHistogram& h, uint32_t us) {
+  h.buckets[frame_hist_bucket(us)]++;
+  h.count++;
+  if (us > h.maxUs) {
+    h.maxUs = us;
+  }
+}
+
+struct StallRecord {
+  uint32_t timestampMs;  // millis() at the end of the iteration
+  uint32_t durationUs;   // Whole iteration
+  uint32_t phaseUs;      // Time spent in phase
+  uint8_t gameId;
+  PerfPhase phase;       // Longest phase (PERF_LOOP: time outside any lap)
+};
+
+struct FrameTimingSnapshot {
+  FrameHistogram loop;
+  FrameHistogram tickLatency[FRAME_TIMING_MAX_GAMES];
+  StallRecord stalls[FRAME_STALL_LOG];  // Ring: entry n is stalls[n % FRAME_STALL_LOG]
+  uint32_t stallCount;                  // Since boot
+};
+
+// Oldest logged stall's sequence number (entries run up to stallCount - 1)
+inline uint32_t frame_timing_first_logged(const FrameTimingSnapshot& s) {
+  return s.stallCount > FRAME_STALL_LOG ? s.stallCount - FRAME_STALL_LOG : 0;
+}
+
+// Start of a loop() iteration
+void frame_timing_begin();
+
+// The time since the previous mark was spent in phase (may repeat per iteration)
+void frame_timing_lap(PerfPhase phase);
+
+// End of the iteration: histogram, stall check, per-phase probe samples
+void frame_timing_end(uint8_t gameId);
+
+// How late the oldest tick run this frame was (called by game_manager)
+void frame_timing_record_tick_latency(uint8_t gameId, uint32_t us);
+
+// Game task: stalls so far and the latest one (nullptr if none)
+uint32_t frame_timing_get_stall_count();
+const StallRecord* frame_timing_get_last_stall();
+
+// Any task: latest published copy
+void frame_timing_get(FrameTimingSnapshot& out);
+
+#endif // FRAME_TIMING_H
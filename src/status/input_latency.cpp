@@ -0,0 +1,163 @@
+// Input latency implementation
+
+#include "input_latency.h"
+#include <string.h>
+
+#if INPUT_LATENCY_TRACE
+
+#include "snapshot_buffer.h"
+#include "../render/led_output.h"
+#include <Arduino.h>
+
+enum TraceStage : uint8_t {
+  TRACE_FREE,
+  TRACE_QUEUED,  // Waiting in the input event queue
+  TRACE_TICKED,  // Consumed; waiting for a frame to be handed over
+  TRACE_SENT     // Frame handed over; waiting for show() to finish it
+};
+
+struct LatencyTrace {
+  uint8_t stage;     // TraceStage
+  uint8_t button;
+  uint8_t gameId;
+  uint32_t eventMs;  // Input event time, to find the press in the queue
+  uint32_t seenUs;   // touch_input_update() queued it
+  uint32_t tickUs;   // Its tick ran
+  uint32_t sentUs;   // Its frame was handed to the LED output
+  uint32_t frame;    // That frame's number
+};
+
+static LatencyTrace traces[INPUT_LATENCY_MAX_TRACES];
+static InputLatencySnapshot live;
+static SnapshotBuffer<InputLatencySnapshot> published;
+static uint8_t tickGameId = 0;
+static bool dirty = false;    // live changed since the last publish
+static bool started = false;  // live's histograms are cleared
+
+static void publish() {
+  published.back() = live;
+  published.publish();
+  dirty = false;
+}
+
+static void clearStats() {
+  for (InputLatencyGame& g : live.games) {
+    log_histogram_clear(g.latency);
+    g.unanswered = 0;
+  }
+  log_histogram_clear(live.toTick);
+  log_histogram_clear(live.toFrame);
+  log_histogram_clear(live.toShow);
+  live.skipped = 0;
+  started = true;
+}
+
+static LatencyTrace* findTrace(uint8_t stage, uint8_t button, uint32_t eventMs) {
+  for (LatencyTrace& t : traces) {
+    if (t.stage == stage && t.button == button && t.eventMs == eventMs) {
+      return &t;
+    }
+  }
+  return nullptr;
+}
+
+void input_latency_pressed(uint8_t button, uint32_t eventMs) {
+  for (LatencyTrace& t : traces) {
+    if (t.stage == TRACE_FREE) {
+      t = {TRACE_QUEUED, button, 0, eventMs, micros(), 0, 0, 0};
+      return;
+    }
+  }
+  live.skipped++;
+  dirty = true;
+}
+
+void input_latency_ticked(uint8_t button, uint32_t eventMs) {
+  LatencyTrace* t = findTrace(TRACE_QUEUED, button, eventMs);
+  if (t) {
+    t->stage = TRACE_TICKED;
+    t->gameId = tickGameId;
+    t->tickUs = micros();
+  }
+}
+
+void input_latency_skipped(uint8_t button, uint32_t eventMs) {
+  LatencyTrace* t = findTrace(TRACE_QUEUED, button, eventMs);
+  if (t) {
+    t->stage = TRACE_FREE;
+    live.skipped++;
+    dirty = true;
+  }
+}
+
+void input_latency_frame_sent(uint32_t frame) {
+  uint32_t now = micros();
+  for (LatencyTrace& t : traces) {
+    if (t.stage == TRACE_TICKED) {
+      t.stage = TRACE_SENT;
+      t.sentUs = now;
+      t.frame = frame;
+    }
+  }
+}
+
+static void finish(LatencyTrace& t, uint32_t showUs) {
+  if (t.gameId < FRAME_TIMING_MAX_GAMES) {
+    log_histogram_add(live.games[t.gameId].latency, showUs - t.seenUs);
+  }
+  log_histogram_add(live.toTick, t.tickUs - t.seenUs);
+  log_histogram_add(live.toFrame, t.sentUs - t.tickUs);
+  log_histogram_add(live.toShow, showUs - t.sentUs);
+  t.stage = TRACE_FREE;
+  dirty = true;
+}
+
+// A trace with no frame out in time
+static void giveUp(LatencyTrace& t) {
+  if (t.stage == TRACE_QUEUED) {
+    live.skipped++;
+  } else if (t.gameId < FRAME_TIMING_MAX_GAMES) {
+    live.games[t.gameId].unanswered++;
+  }
+  t.stage = TRACE_FREE;
+  dirty = true;
+}
+
+void input_latency_update(uint8_t gameId) {
+  if (!started) {
+    clearStats();
+  }
+  tickGameId = gameId;
+  LedOutputDone done = led_output_get_done();
+  uint32_t now = micros();
+
+  for (LatencyTrace& t : traces) {
+    if (t.stage == TRACE_SENT && (int32_t)(done.frames - t.frame) >= 0) {
+      finish(t, done.us);
+    } else if (t.stage != TRACE_FREE && now - t.seenUs > INPUT_LATENCY_TIMEOUT_MS * 1000u) {
+      giveUp(t);
+    }
+  }
+
+  if (dirty) {
+    publish();
+  }
+}
+
+void input_latency_clear() {
+  memset(traces, 0, sizeof(traces));
+  clearStats();
+  publish();
+}
+
+void input_latency_get(InputLatencySnapshot& out) {
+  published.read(out);
+}
+
+#else
+
+void input_latency_get(InputLatencySnapshot& out) {
+  memset(&out, 0, sizeof(out));
+}
+
+#endif
@@ -0,0 +1,80 @@
+// Touch-to-photon latency
+// An instrumentation mode (INPUT_LATENCY_TRACE) that follows every press
+// from the touch_input_update() that saw it, through the game tick that
+// consumes it (input_events.h), to the first frame handed to the LED output
+// after that tick, and records when that frame leaves FastLED.show(). The
+// frame is the first changed one, which is the earliest the press can show
+// (an animation may change it anyway, so this is a lower bound per press).
+// Presses no tick consumes (an effect playing, a game switch) are counted
+// as skipped, and consumed presses with no changed frame within
+// INPUT_LATENCY_TIMEOUT_MS as unanswered.
+// Written by the game task; other tasks read the copy published by the
+// next input_latency_update() after anything changed.
+
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <stdint.h>
+#include "frame_timing.h"
+#include "log_histogram.h"
+
+// Off by default: the hooks below compile to nothing
+#ifndef INPUT_LATENCY_TRACE
+#define INPUT_LATENCY_TRACE 0
+#endif
+
+// Presses followed at once; more are counted as skipped
+#define INPUT_LATENCY_MAX_TRACES 8
+
+// A press still unanswered after this long is given up on
+#define INPUT_LATENCY_TIMEOUT_MS 1000
+
+// Latencies in us, to within 25% (log_histogram.h)
+struct InputLatencyGame {
+  LogHistogram latency;  // Press seen to its frame out of FastLED.show()
+  uint32_t unanswered;   // Consumed, but no frame changed in time
+};
+
+struct InputLatencySnapshot {
+  InputLatencyGame games[FRAME_TIMING_MAX_GAMES];
+  LogHistogram toTick;   // All games: press seen until its tick ran
+  LogHistogram toFrame;  // Tick until the frame was handed to the output
+  LogHistogram toShow;   // Handed over until it left FastLED.show()
+  uint32_t skipped;      // Never consumed by a tick
+};
+
+#if INPUT_LATENCY_TRACE
+
+// A press edge queued with input event time eventMs (touch_input_update())
+void input_latency_pressed(uint8_t button, uint32_t eventMs);
+
+// The press queued at eventMs reaches a game tick (input_events_tick()), or
+// is consumed without one (input_events_skip())
+void input_latency_ticked(uint8_t button, uint32_t eventMs);
+void input_latency_skipped(uint8_t button, uint32_t eventMs);
+
+// A frame was handed to the LED output as frame number frame (frame_output_show())
+void input_latency_frame_sent(uint32_t frame);
+
+// Once per frame, before any tick: finishes traces whose frame is out and
+// gives up on stale ones; later ticks belong to gameId (game manager)
+void input_latency_update(uint8_t gameId);
+
+// Forget traces in flight and all statistics
+void input_latency_clear();
+
+#else
+
+inline void input_latency_pressed(uint8_t, uint32_t) {}
+inline void input_latency_ticked(uint8_t, uint32_t) {}
+inline void input_latency_skipped(uint8_t, uint32_t) {}
+inline void input_latency_frame_sent(uint32_t) {}
+inline void input_latency_update(uint8_t) {}
+inline void input_latency_clear() {}
+
+#endif
+
+// Any task: latest published copy (all zero unless INPUT_LATENCY_TRACE)
+void input_latency_get(InputLatencySnapshot& out);
+
+#endif // INPUT_LATENCY_H
@@ -0,0 +1,92 @@
+// Log-linear histogram
+// Each power of two is split into 4 linear steps, so any uint32_t value
+// lands in one of 124 buckets with at most 25% relative error. Adding a
+// sample is a count-leading-zeros and an increment; percentiles read back
+// as the upper bound of the bucket they fall in.
+
+#ifndef LOG_HISTOGRAM_H
+#define LOG_HISTOGRAM_H
+
+#include <stdint.h>
+
+static constexpr uint8_t LOG_HISTOGRAM_SUB_BITS = 2;
+static constexpr uint8_t LOG_HISTOGRAM_SUB = 1 << LOG_HISTOGRAM_SUB_BITS;
+static constexpr uint8_t LOG_HISTOGRAM_BUCKETS = (32 - LOG_HISTOGRAM_SUB_BITS + 1) << LOG_HISTOGRAM_SUB_BITS;
+
+struct LogHistogram {
+  uint32_t counts[LOG_HISTOGRAM_BUCKETS];
+  uint32_t total;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+};
+
+// Values below LOG_HISTOGRAM_SUB get exact buckets
+inline uint8_t log_histogram_bucket(uint32_t value) {
+  if (value < LOG_HISTOGRAM_SUB) {
+    return (uint8_t)value;
+  }
+  uint8_t msb = 31 - __builtin_clz(value);
+  uint8_t step = (value >> (msb - LOG_HISTOGRAM_SUB_BITS)) & (LOG_HISTOGRAM_SUB - 1);
+  return (uint8_t)(((msb - LOG_HISTOGRAM_SUB_BITS + 1) << LOG_HISTOGRAM_SUB_BITS) | step);
+}
+
+// Smallest and largest value that map to bucket
+inline uint32_t log_histogram_lower(uint8_t bucket) {
+  if (bucket < LOG_HISTOGRAM_SUB) {
+    return bucket;
+  }
+  uint8_t shift = (bucket >> LOG_HISTOGRAM_SUB_BITS) - 1;
+  return (uint32_t)(LOG_HISTOGRAM_SUB | (bucket & (LOG_HISTOGRAM_SUB - 1))) << shift;
+}
+
+inline uint32_t log_histogram_upper(uint8_t bucket) {
+  if (bucket < LOG_HISTOGRAM_SUB) {
+    return bucket;
+  }
+  uint8_t shift = (bucket >> LOG_HISTOGRAM_SUB_BITS) - 1;
+  return log_histogram_lower(bucket) + ((1u << shift) - 1);
+}
+
+inline void log_histogram_clear(LogHistogram& h) {
+  for (uint8_t i = 0; i < LOG_HISTOGRAM_BUCKETS; i++) {
+    h.counts[i] = 0;
+  }
+  h.total = 0;
+  h.min = 0xFFFFFFFF;
+  h.max = 0;
+  h.sum = 0;
+}
+
+inline void log_histogram_add(LogHistogram& h, uint32_t value) {
+  h.counts[log_histogram_bucket(value)]++;
+  h.total++;
+  h.sum += value;
+  if (value < h.min) h.min = value;
+  if (value > h.max) h.max = value;
+}
+
+// Value at or below which pct percent of samples fall (0 if empty),
+// clamped to the observed range
+inline uint32_t log_histogram_percentile(const LogHistogram& h, uint8_t pct) {
+  if (h.total == 0) {
+    return 0;
+  }
+  uint32_t rank = (uint32_t)(((uint64_t)h.total * pct + 99) / 100);
+  if (rank == 0) {
+    rank = 1;
+  }
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < LOG_HISTOGRAM_BUCKETS; i++) {
+    seen += h.counts[i];
+    if (seen >= rank) {
+      uint32_t v = log_histogram_upper(i);
+      if (v > h.max) return h.max;
+      if (v < h.min) return h.min;
+      return v;
+    }
+  }
+  return h.max;
+}
+
+#endif // LOG_HISTOGRAM_H
@@ -0,0 +1,98 @@
+// Hot-path timing probe implementation
+
+#include "perf_probe.h"
+#include "log_histogram.h"
+#include "snapshot_buffer.h"
+#include <Arduino.h>
+#ifndef ARDUINO_ARCH_ESP32
+#include <chrono>
+#endif
+
+struct PhaseWindow {
+  LogHistogram cycles;
+  uint32_t startCycles;
+  uint32_t lengthCycles;  // PERF_WINDOW_MS at the clock rate when it opened
+  uint32_t startMs;
+  bool started;
+};
+
+static const char* const PHASE_NAMES[PERF_PHASE_COUNT] = {
+  "loop", "touch", "wifi", "web", "game", "show", "status"
+};
+
+static PhaseWindow windows[PERF_PHASE_COUNT];
+static SnapshotBuffer<PerfSummary> summaries[PERF_PHASE_COUNT];
+
+uint32_t perf_probe_cycles() {
+#ifdef ARDUINO_ARCH_ESP32
+  return ESP.getCycleCount();  // CCOUNT of the calling core
+#else
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint32_t perf_probe_cycles_per_us() {
+#ifdef ARDUINO_ARCH_ESP32
+  return getCpuFrequencyMhz();
+#else
+  return 1000;
+#endif
+}
+
+static uint32_t toNs(uint64_t cycles, uint32_t cyclesPerUs) {
+  uint64_t ns = cycles * 1000 / cyclesPerUs;
+  return ns > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)ns;
+}
+
+static void closeWindow(PerfPhase phase, PhaseWindow& w) {
+  const LogHistogram& h = w.cycles;
+  uint32_t cyclesPerUs = perf_probe_cycles_per_us();
+  uint32_t now = millis();
+
+  PerfSummary& s = summaries[phase].back();
+  s.windowEndMs = now;
+  s.windowMs = now - w.startMs;
+  s.count = h.total;
+  s.minNs = toNs(h.min, cyclesPerUs);
+  s.avgNs = toNs(h.sum / h.total, cyclesPerUs);
+  s.maxNs = toNs(h.max, cyclesPerUs);
+  s.p99Ns = toNs(log_histogram_percentile(h, 99), cyclesPerUs);
+  summaries[phase].publish();
+}
+
+void perf_probe_record(PerfPhase phase, uint32_t cycles) {
+  if (phase >= PERF_PHASE_COUNT) {
+    return;
+  }
+  PhaseWindow& w = windows[phase];
+  uint32_t now = perf_probe_cycles();
+
+  if (!w.started) {
+    log_histogram_clear(w.cycles);
+    w.startCycles = now;
+    // 1s is 240M cycles at 240MHz, well inside 32 bits
+    w.lengthCycles = (uint32_t)PERF_WINDOW_MS * 1000 * perf_probe_cycles_per_us();
+    w.startMs = millis();
+    w.started = true;
+  }
+
+  log_histogram_add(w.cycles, cycles);
+
+  if (now - w.startCycles >= w.lengthCycles) {
+    closeWindow(phase, w);
+    w.started = false;
+  }
+}
+
+bool perf_probe_get(PerfPhase phase, PerfSummary& out) {
+  if (phase >= PERF_PHASE_COUNT || summaries[phase].seq.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  summaries[phase].read(out);
+  return true;
+}
+
+const char* perf_probe_phase_name(PerfPhase phase) {
+  return phase < PERF_PHASE_COUNT ? PHASE_NAMES[phase] : "unknown";
+}
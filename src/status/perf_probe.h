@@ -0,0 +1,61 @@
+// Hot-path timing probes
+// Per-phase timings from the CPU cycle counter: CCOUNT on device,
+// steady_clock on native. loop() phases are measured by frame_timing's
+// laps; work on other tasks uses scoped PerfProbes. Each phase has a
+// single writer task, which folds its samples into a summary every
+// PERF_WINDOW_MS; any task can read the latest summary without blocking
+// the writer.
+
+#ifndef PERF_PROBE_H
+#define PERF_PROBE_H
+
+#include <stdint.h>
+
+#define PERF_WINDOW_MS 1000
+
+enum PerfPhase : uint8_t {
+  PERF_LOOP,    // Whole loop() pass
+  PERF_TOUCH,   // touch_input_update()
+  PERF_WIFI,    // wifi_manager_update()
+  PERF_WEB,     // web_server_update(), including request handlers
+  PERF_GAME,    // game_manager_loop(): ticks, render, frame output
+  PERF_SHOW,    // FastLED.show()
+  PERF_STATUS,  // Status snapshot and JSON in loop()
+  PERF_PHASE_COUNT
+};
+
+// One window of samples for a phase
+struct PerfSummary {
+  uint32_t windowEndMs;  // millis() when the window closed
+  uint32_t windowMs;
+  uint32_t count;
+  uint32_t minNs;
+  uint32_t avgNs;
+  uint32_t maxNs;
+  uint32_t p99Ns;
+};
+
+// Current cycle count (wraps; only differences are meaningful)
+uint32_t perf_probe_cycles();
+
+// Cycle counter rate
+uint32_t perf_probe_cycles_per_us();
+
+// Add one sample (writer task of the phase only)
+void perf_probe_record(PerfPhase phase, uint32_t cycles);
+
+// Latest closed window; false if the phase has not completed one yet
+bool perf_probe_get(PerfPhase phase, PerfSummary& out);
+
+const char* perf_probe_phase_name(PerfPhase phase);
+
+// Times its own scope
+struct PerfProbe {
+  PerfPhase phase;
+  uint32_t start;
+
+  explicit PerfProbe(PerfPhase p) : phase(p), start(perf_probe_cycles()) {}
+  ~PerfProbe() { perf_probe_record(phase, perf_probe_cycles() - start); }
+};
+
+#endif // PERF_PROBE_H
@@ -0,0 +1,55 @@
+// Lock-free double-buffered snapshot
+// One writer task publishes whole values; reader tasks copy out the latest
+// complete one without blocking the writer (seqlock over two slots)
+
+#ifndef SNAPSHOT_BUFFER_H
+#define SNAPSHOT_BUFFER_H
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T>
+struct SnapshotBuffer {
+  T slots[2];
+  std::atomic<uint32_t> seq{0};  // Publish count; slots[seq & 1] is the latest
+
+  // Writer: slot to fill for the next publish (never the one readers see)
+  T& back() {
+    return slots[(seq.load(std::memory_order_relaxed) + 1) & 1];
+  }
+
+  // Writer: make back() the latest snapshot
+  void publish() {
+    seq.fetch_add(1, std::memory_order_release);
+  }
+
+  // Reader: copy the latest snapshot
+  // Retries whenever the writer published during the copy (the slot being
+  // copied may then be the next back() and be overwritten mid-copy)
+  void read(T& out) const {
+    for (;;) {
+      uint32_t before = seq.load(std::memory_order_acquire);
+      out = slots[before & 1];
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq.load(std::memory_order_relaxed) == before) {
+        return;
+      }
+    }
+  }
+
+  // Reader: call fn on the latest snapshot in place instead of copying it,
+  // repeating the call whenever the writer published during it (as read())
+  template <typename F>
+  void view(F fn) const {
+    for (;;) {
+      uint32_t before = seq.load(std::memory_order_acquire);
+      fn(slots[before & 1]);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq.load(std::memory_order_relaxed) == before) {
+        return;
+      }
+    }
+  }
+};
+
+#endif // SNAPSHOT_BUFFER_H
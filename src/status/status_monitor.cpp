@@ -1,8 +1,9 @@
 // Status monitor implementation
 
 #include "status_monitor.h"
+#include "snapshot_buffer.h"
 
-static GameStatus currentStatus = {
+static const GameStatus INITIAL_STATUS = {
   .gameName = "Unknown",
   .score = 0,
   .state = GAME_STATE_PLAYING,
@@ -10,102 +11,131 @@ static GameStatus currentStatus = {
   .rightPressed = false,
   .actionPressed = false,
   .altPressed = false,
-  .leds = {{0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}},
+  .leds = {},
   .timestamp = 0,
-  .hasChanged = false
+  .stallCount = 0,
+  .lastStallUs = 0,
+  .touch = {},
+  .version = 0,
+  .fieldVersion = {}
 };
 
-static GameStatus previousStatus = currentStatus;
+static GameStatus currentStatus = INITIAL_STATUS;
+
+// Fields changed since the last publish (STATUS_BIT mask)
+static uint32_t dirtyFields = 0;
+
+// Written by the game task, read by the network task
+static SnapshotBuffer<GameStatus> published;
+static uint32_t lastTouchChangeMs = 0;
+
+static void markDirty(StatusField field) {
+  dirtyFields |= STATUS_BIT(field);
+}
 
 void status_monitor_init() {
-  currentStatus = {
-    .gameName = "Unknown",
-    .score = 0,
-    .state = GAME_STATE_PLAYING,
-    .leftPressed = false,
-    .rightPressed = false,
-    .actionPressed = false,
-    .altPressed = false,
-    .leds = {{0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}, {0,0,0}},
-    .timestamp = 0,
-    .hasChanged = false
-  };
-  previousStatus = currentStatus;
+  currentStatus = INITIAL_STATUS;
+  dirtyFields = STATUS_ALL_FIELDS;
+  status_monitor_publish();
 }
 
 void status_monitor_update_leds(const LEDColor* leds, int count) {
-  int maxCount = (count > 8) ? 8 : count;
+  int maxCount = (count > NUM_LEDS) ? NUM_LEDS : count;
+  size_t bytes = maxCount * sizeof(LEDColor);
 
-  // Always update LED state (LEDs change every frame)
-  for (int i = 0; i < maxCount; i++) {
-    currentStatus.leds[i] = leds[i];
+  // A still frame (idle game, paused animation) is not a change
+  if (memcmp(currentStatus.leds, leds, bytes) != 0) {
+    memcpy(currentStatus.leds, leds, bytes);
+    markDirty(STATUS_FIELD_LEDS);
   }
+}
 
-  // LEDs always trigger a change (for web server updates)
-  currentStatus.hasChanged = true;
-  currentStatus.timestamp = millis();
+void status_monitor_update_stalls(uint32_t count, uint32_t lastStallUs) {
+  if (currentStatus.stallCount != count) {
+    currentStatus.stallCount = count;
+    currentStatus.lastStallUs = lastStallUs;
+    markDirty(STATUS_FIELD_STALLS);
+  }
+}
+
+void status_monitor_update_touch(uint8_t pad, uint16_t raw, uint16_t baseline, uint16_t threshold) {
+  if (pad >= 4) {
+    return;
+  }
+  TouchPadStatus& t = currentStatus.touch[pad];
+  if (t.raw == raw && t.baseline == baseline && t.threshold == threshold) {
+    return;
+  }
+  t = {raw, baseline, threshold};
+
+  uint32_t now = millis();
+  if (now - lastTouchChangeMs >= STATUS_TOUCH_REFRESH_MS) {
+    lastTouchChangeMs = now;
+    markDirty(STATUS_FIELD_TOUCH);
+  }
 }
 
 void status_monitor_update_game_name(const char* name) {
   if (name != nullptr && strcmp(currentStatus.gameName, name) != 0) {
     currentStatus.gameName = name;
-    currentStatus.hasChanged = true;
+    markDirty(STATUS_FIELD_NAME);
   }
-  currentStatus.timestamp = millis();
 }
 
 void status_monitor_update_score(uint32_t score) {
   if (currentStatus.score != score) {
     currentStatus.score = score;
-    currentStatus.hasChanged = true;
+    markDirty(STATUS_FIELD_SCORE);
   }
-  currentStatus.timestamp = millis();
+}
+
+uint32_t status_monitor_get_score() {
+  return currentStatus.score;
 }
 
 void status_monitor_update_state(GameState state) {
   if (currentStatus.state != state) {
     currentStatus.state = state;
-    currentStatus.hasChanged = true;
+    markDirty(STATUS_FIELD_STATE);
   }
-  currentStatus.timestamp = millis();
 }
 
 void status_monitor_update_input(bool left, bool right, bool action, bool alt) {
-  bool changed = false;
-
-  if (currentStatus.leftPressed != left) {
+  if (currentStatus.leftPressed != left || currentStatus.rightPressed != right ||
+      currentStatus.actionPressed != action || currentStatus.altPressed != alt) {
     currentStatus.leftPressed = left;
-    changed = true;
-  }
-  if (currentStatus.rightPressed != right) {
     currentStatus.rightPressed = right;
-    changed = true;
-  }
-  if (currentStatus.actionPressed != action) {
     currentStatus.actionPressed = action;
-    changed = true;
-  }
-  if (currentStatus.altPressed != alt) {
     currentStatus.altPressed = alt;
-    changed = true;
+    markDirty(STATUS_FIELD_INPUT);
   }
+}
 
-  if (changed) {
-    currentStatus.hasChanged = true;
+void status_monitor_publish() {
+  if (dirtyFields == 0) {
+    return;
   }
+  uint32_t version = published.seq.load(std::memory_order_relaxed) + 1;
+  currentStatus.version = version;
   currentStatus.timestamp = millis();
+  for (uint8_t f = 0; f < STATUS_FIELD_COUNT; f++) {
+    if (dirtyFields & STATUS_BIT(f)) {
+      currentStatus.fieldVersion[f] = version;
+    }
+  }
+  dirtyFields = 0;
+  published.back() = currentStatus;
+  published.publish();
 }
 
-GameStatus status_monitor_get() {
-  return currentStatus;
+void status_monitor_get(GameStatus& out) {
+  published.read(out);
 }
 
-bool status_monitor_has_changed() {
-  return currentStatus.hasChanged;
+void status_monitor_view(void (*fn)(const GameStatus& status, void* arg), void* arg) {
+  published.view([=](const GameStatus& status) { fn(status, arg); });
 }
 
-void status_monitor_clear_changed() {
-  previousStatus = currentStatus;
-  currentStatus.hasChanged = false;
+uint32_t status_monitor_version() {
+  return published.seq.load(std::memory_order_acquire);
 }
-
@@ -1,11 +1,18 @@
 // Status monitoring abstraction
-// Tracks game status and only reports changes
+// Tracks game status and only reports changes: each field group has its
+// own dirty bit, set only when an update really changes it. The game task
+// publishes a snapshot only when some bit is set, and each publish bumps
+// the status version and stamps the dirty fields with it. Consumers build
+// their output (JSON, see network/status_json.h) when they need it, reuse
+// it while the version stays the same, and can send only the fields that
+// changed since the version they last sent (status_changed_since()).
 
 #ifndef STATUS_MONITOR_H
 #define STATUS_MONITOR_H
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "../config/led_config.h"
 
 // Game state enumeration
 enum GameState {
@@ -22,6 +29,32 @@ struct LEDColor {
   uint8_t b;
 };
 
+// Touch readings change on every read: they mark the status changed at
+// most this often
+#define STATUS_TOUCH_REFRESH_MS 500
+
+// Touch pad sensing, for tuning installs remotely (touch_input_get_pad())
+struct TouchPadStatus {
+  uint16_t raw;
+  uint16_t baseline;
+  uint16_t threshold;
+};
+
+// Field groups, one dirty bit each
+enum StatusField : uint8_t {
+  STATUS_FIELD_NAME,
+  STATUS_FIELD_SCORE,
+  STATUS_FIELD_STATE,
+  STATUS_FIELD_INPUT,   // left/right/action/altPressed
+  STATUS_FIELD_LEDS,
+  STATUS_FIELD_STALLS,  // stallCount and lastStallUs
+  STATUS_FIELD_TOUCH,
+  STATUS_FIELD_COUNT
+};
+
+#define STATUS_BIT(field) (1u << (field))
+#define STATUS_ALL_FIELDS (STATUS_BIT(STATUS_FIELD_COUNT) - 1)
+
 // Status structure
 struct GameStatus {
   const char* gameName;
@@ -31,11 +64,30 @@ struct GameStatus {
   bool rightPressed;
   bool actionPressed;
   bool altPressed;
-  LEDColor leds[8];  // LED strip state
-  uint32_t timestamp;
-  bool hasChanged;
+  LEDColor leds[NUM_LEDS];  // LED strip state
+  uint32_t timestamp;       // millis() of the latest change
+  uint32_t stallCount;   // loop() stalls since boot (see frame_timing.h)
+  uint32_t lastStallUs;  // Duration of the latest one
+  TouchPadStatus touch[4];  // Left, right, action, alt
+  uint32_t version;         // Publishes since boot (status_monitor_version())
+  uint32_t fieldVersion[STATUS_FIELD_COUNT];  // Version each field last changed in
 };
 
+// Fields (STATUS_BIT mask) that changed after version since, e.g. the one a
+// consumer last sent; 0 or a version from before a reboot gives every field
+inline uint32_t status_changed_since(const GameStatus& status, uint32_t since) {
+  if (since > status.version) {
+    return STATUS_ALL_FIELDS;
+  }
+  uint32_t fields = 0;
+  for (uint8_t f = 0; f < STATUS_FIELD_COUNT; f++) {
+    if (status.fieldVersion[f] > since) {
+      fields |= STATUS_BIT(f);
+    }
+  }
+  return fields;
+}
+
 // Initialize status monitor
 void status_monitor_init();
 
@@ -45,15 +97,28 @@ void status_monitor_update_score(uint32_t score);
 void status_monitor_update_state(GameState state);
 void status_monitor_update_input(bool left, bool right, bool action, bool alt);
 void status_monitor_update_leds(const LEDColor* leds, int count);
+void status_monitor_update_stalls(uint32_t count, uint32_t lastStallUs);
+void status_monitor_update_touch(uint8_t pad, uint16_t raw, uint16_t baseline, uint16_t threshold);
+
+// Current score (game task only; other tasks use status_monitor_get())
+uint32_t status_monitor_get_score();
+
+// Publish the current status for other tasks if it changed since the last
+// publish (call once per frame from the game task)
+void status_monitor_publish();
 
-// Get current status
-GameStatus status_monitor_get();
+// Copy the last published status (safe from any task)
+void status_monitor_get(GameStatus& out);
 
-// Check if status has changed (and clear the flag)
-bool status_monitor_has_changed();
+// Call fn on the last published status where it lies, for readers that
+// only need it briefly and cannot spare a GameStatus (safe from any task).
+// fn runs again if the game task published meanwhile, so it may only
+// write its own output and must not act on a run until view returns
+void status_monitor_view(void (*fn)(const GameStatus& status, void* arg), void* arg);
 
-// Reset change flag
-void status_monitor_clear_changed();
+// Version of the last published status: changes whenever the status does
+// (safe from any task, costs no copy)
+uint32_t status_monitor_version();
 
 #endif // STATUS_MONITOR_H
 
@@ -0,0 +1,147 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/input/button_debounce.h"
+
+// Test the debounce state machine and tick-time hold tracking
+
+static constexpr uint32_t RELEASE_MS = 30;
+
+static ButtonEdge feed(ButtonDebounce& b, bool touched, uint32_t nowMs) {
+  return button_debounce_update(b, touched, nowMs, nowMs, RELEASE_MS);
+}
+
+void test_press_is_immediate() {
+  ButtonDebounce b;
+  button_debounce_reset(b);
+  TEST_ASSERT_EQUAL(BUTTON_EDGE_NONE, feed(b, false, 100));
+  TEST_ASSERT_EQUAL(BUTTON_EDGE_PRESS, feed(b, true, 101));
+  TEST_ASSERT_EQUAL(101, b.sinceMs);
+  TEST_ASSERT_TRUE(button_debounce_is_down(b));
+}
+
+void test_held_pad_stays_down() {
+  // The old debounce flickered a held pad; one press for the whole hold
+  ButtonDebounce b;
+  button_debounce_reset(b);
+  uint32_t presses = 0;
+  for (uint32_t t = 0; t < 2000; t++) {
+    presses += feed(b, true, t) == BUTTON_EDGE_PRESS;
+    TEST_ASSERT_TRUE(button_debounce_is_down(b));
+  }
+  TEST_ASSERT_EQUAL(1, presses);
+}
+
+void test_release_waits_for_debounce() {
+  ButtonDebounce b;
+  button_debounce_reset(b);
+  feed(b, true, 0);
+  for (uint32_t t = 100; t < 100 + RELEASE_MS; t++) {
+    TEST_ASSERT_EQUAL(BUTTON_EDGE_NONE, feed(b, false, t));
+    TEST_ASSERT_TRUE(button_debounce_is_down(b));
+  }
+  TEST_ASSERT_EQUAL(BUTTON_EDGE_RELEASE, feed(b, false, 100 + RELEASE_MS));
+  TEST_ASSERT_EQUAL(100, b.sinceMs);  // Timed when the letting go began
+  TEST_ASSERT_FALSE(button_debounce_is_down(b));
+}
+
+void test_flicker_produces_no_edges() {
+  ButtonDebounce b;
+  button_debounce_reset(b);
+  feed(b, true, 0);
+  for (uint32_t t = 1; t < 500; t++) {
+    bool touched = (t / 7) % 2 == 0;  // 7ms dropouts, shorter than RELEASE_MS
+    TEST_ASSERT_EQUAL(BUTTON_EDGE_NONE, feed(b, touched, t));
+  }
+}
+
+void test_edge_time_from_reading() {
+  ButtonDebounce b;
+  button_debounce_reset(b);
+  TEST_ASSERT_EQUAL(BUTTON_EDGE_PRESS, button_debounce_update(b, true, 95, 100, RELEASE_MS));
+  TEST_ASSERT_EQUAL(95, b.sinceMs);
+  button_debounce_update(b, false, 190, 200, RELEASE_MS);
+  TEST_ASSERT_EQUAL(BUTTON_EDGE_RELEASE, button_debounce_update(b, false, 190, 220, RELEASE_MS));
+  TEST_ASSERT_EQUAL(190, b.sinceMs);
+}
+
+static constexpr uint16_t TICK = 50;
+static constexpr uint32_t LONG_MS = 600;
+static constexpr uint32_t DELAY_MS = 400;
+static constexpr uint32_t REPEAT_MS = 100;
+
+void test_hold_tracks_duration_and_long_press() {
+  ButtonHold h;
+  button_hold_reset(h);
+  button_hold_tick(h, true, true, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+  TEST_ASSERT_EQUAL(0, h.heldMs);
+
+  uint32_t longPresses = 0;
+  for (uint32_t i = 1; i <= 20; i++) {
+    button_hold_tick(h, false, true, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+    TEST_ASSERT_EQUAL(i * TICK, h.heldMs);
+    if (h.longPressed) {
+      TEST_ASSERT_EQUAL(LONG_MS, h.heldMs);
+      longPresses++;
+    }
+  }
+  TEST_ASSERT_EQUAL(1, longPresses);
+
+  button_hold_tick(h, false, false, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+  TEST_ASSERT_EQUAL(0, h.heldMs);
+  TEST_ASSERT_FALSE(h.longPressed);
+}
+
+void test_auto_repeat_schedule() {
+  ButtonHold h;
+  button_hold_reset(h);
+  button_hold_tick(h, true, true, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+  TEST_ASSERT_TRUE(h.repeated);  // The press itself
+
+  // Repeats at 400, 500, 600... ms held
+  for (uint32_t i = 1; i <= 14; i++) {
+    button_hold_tick(h, false, true, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+    bool expected = h.heldMs >= DELAY_MS && (h.heldMs - DELAY_MS) % REPEAT_MS == 0;
+    TEST_ASSERT_EQUAL(expected, h.repeated);
+  }
+}
+
+void test_repeat_disabled() {
+  ButtonHold h;
+  button_hold_reset(h);
+  button_hold_tick(h, true, true, TICK, LONG_MS, DELAY_MS, 0);
+  TEST_ASSERT_TRUE(h.repeated);
+  for (uint32_t i = 0; i < 40; i++) {
+    button_hold_tick(h, false, true, TICK, LONG_MS, DELAY_MS, 0);
+    TEST_ASSERT_FALSE(h.repeated);
+  }
+}
+
+void test_new_press_restarts_hold() {
+  ButtonHold h;
+  button_hold_reset(h);
+  button_hold_tick(h, true, true, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+  for (uint32_t i = 0; i < 10; i++) {
+    button_hold_tick(h, false, true, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+  }
+  // Released and pressed again within one tick
+  button_hold_tick(h, true, true, TICK, LONG_MS, DELAY_MS, REPEAT_MS);
+  TEST_ASSERT_EQUAL(0, h.heldMs);
+  TEST_ASSERT_EQUAL(DELAY_MS, h.nextRepeatMs);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_press_is_immediate);
+  RUN_TEST(test_held_pad_stays_down);
+  RUN_TEST(test_release_waits_for_debounce);
+  RUN_TEST(test_flicker_produces_no_edges);
+  RUN_TEST(test_edge_time_from_reading);
+  RUN_TEST(test_hold_tracks_duration_and_long_press);
+  RUN_TEST(test_auto_repeat_schedule);
+  RUN_TEST(test_repeat_disabled);
+  RUN_TEST(test_new_press_restarts_hold);
+  return UNITY_END();
+}
@@ -0,0 +1,140 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include "../../src/games/occupancy_layer.h"
+
+// Benchmark: occupancy-layer collisions vs the per-pair position scans the
+// games used before, at long strips and high entity counts. Both sides
+// include the cost of moving entities; results must agree exactly.
+
+static constexpr int STEPS = 2000;
+
+struct Mover {
+  uint16_t pos;
+  int8_t dir;
+};
+
+static uint32_t rngState = 1;
+static uint32_t nextRand() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+template <uint16_t CELLS>
+static void step(Mover* m, int count) {
+  for (int i = 0; i < count; i++) {
+    int p = m[i].pos + m[i].dir;
+    if (p < 0 || p >= CELLS) {
+      m[i].dir = -m[i].dir;
+      p = m[i].pos + m[i].dir;
+    }
+    m[i].pos = (uint16_t)p;
+  }
+}
+
+template <uint16_t CELLS>
+static void seed(Mover* m, int count) {
+  for (int i = 0; i < count; i++) {
+    m[i].pos = nextRand() % CELLS;
+    m[i].dir = (nextRand() & 1) ? 1 : -1;
+  }
+}
+
+// Bullets sharing a cell with at least one enemy, summed over all steps
+template <uint16_t CELLS, uint16_t COUNT>
+static uint64_t runScan(Mover* bullets, Mover* enemies) {
+  uint64_t hits = 0;
+  for (int s = 0; s < STEPS; s++) {
+    step<CELLS>(bullets, COUNT);
+    step<CELLS>(enemies, COUNT);
+    for (int b = 0; b < COUNT; b++) {
+      for (int e = 0; e < COUNT; e++) {
+        if (enemies[e].pos == bullets[b].pos) {
+          hits++;
+          break;
+        }
+      }
+    }
+  }
+  return hits;
+}
+
+template <uint16_t CELLS, uint16_t COUNT>
+static uint64_t runLayer(Mover* bullets, Mover* enemies) {
+  static OccupancyLayer<CELLS, COUNT> bulletCells;
+  static OccupancyLayer<CELLS, COUNT> enemyCells;
+  bulletCells.clear();
+  enemyCells.clear();
+  for (uint16_t i = 0; i < COUNT; i++) {
+    bulletCells.insert(i, bullets[i].pos);
+    enemyCells.insert(i, enemies[i].pos);
+  }
+
+  uint64_t hits = 0;
+  for (int s = 0; s < STEPS; s++) {
+    step<CELLS>(bullets, COUNT);
+    step<CELLS>(enemies, COUNT);
+    for (uint16_t i = 0; i < COUNT; i++) {
+      bulletCells.move(i, bullets[i].pos);
+      enemyCells.move(i, enemies[i].pos);
+    }
+
+    uint16_t c = occupancy_next_overlap(bulletCells, enemyCells);
+    while (c != OCCUPANCY_NONE) {
+      for (uint16_t id = bulletCells.first(c); id != OCCUPANCY_NONE; id = bulletCells.next[id]) {
+        hits++;
+      }
+      c = occupancy_next_overlap(bulletCells, enemyCells, c + 1);
+    }
+    bulletCells.endStep();
+    enemyCells.endStep();
+  }
+  return hits;
+}
+
+template <uint16_t CELLS, uint16_t COUNT>
+static void bench() {
+  static Mover bullets[COUNT], enemies[COUNT];
+  static Mover bullets2[COUNT], enemies2[COUNT];
+
+  rngState = 12345;
+  seed<CELLS>(bullets, COUNT);
+  seed<CELLS>(enemies, COUNT);
+  for (int i = 0; i < COUNT; i++) {
+    bullets2[i] = bullets[i];
+    enemies2[i] = enemies[i];
+  }
+
+  auto t0 = std::chrono::steady_clock::now();
+  uint64_t scanHits = runScan<CELLS, COUNT>(bullets, enemies);
+  auto t1 = std::chrono::steady_clock::now();
+  uint64_t layerHits = runLayer<CELLS, COUNT>(bullets2, enemies2);
+  auto t2 = std::chrono::steady_clock::now();
+
+  double scanNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / STEPS;
+  double layerNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / STEPS;
+  printf("collision_bench cells=%u entities=%u scan_ns_per_step=%.0f layer_ns_per_step=%.0f speedup=%.1fx hits=%llu\n",
+         CELLS, COUNT, scanNs, layerNs, scanNs / layerNs, (unsigned long long)layerHits);
+
+  TEST_ASSERT_EQUAL_UINT64(scanHits, layerHits);
+}
+
+void test_bench_60_leds_8_entities() { bench<60, 8>(); }
+void test_bench_300_leds_64_entities() { bench<300, 64>(); }
+void test_bench_1000_leds_64_entities() { bench<1000, 64>(); }
+void test_bench_1000_leds_256_entities() { bench<1000, 256>(); }
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_60_leds_8_entities);
+  RUN_TEST(test_bench_300_leds_64_entities);
+  RUN_TEST(test_bench_1000_leds_64_entities);
+  RUN_TEST(test_bench_1000_leds_256_entities);
+  return UNITY_END();
+}
@@ -0,0 +1,89 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/render/effect_sequencer.h"
+
+// Test flash effect keyframe timing (pure helpers, no FastLED needed)
+
+static const uint32_t RED = 0xFF0000;
+static const FlashEffect GAME_OVER_FLASH = {RED, 3, 150, 150, 0};
+static const FlashEffect WIN_HOLD_FLASH = {0x00FF00, 3, 150, 150, 1000};
+
+// Test total duration
+void test_duration_without_hold() {
+  TEST_ASSERT_EQUAL(900, flash_effect_duration_ms(GAME_OVER_FLASH));
+}
+
+void test_duration_with_hold() {
+  TEST_ASSERT_EQUAL(1900, flash_effect_duration_ms(WIN_HOLD_FLASH));
+}
+
+// Test on/off keyframes
+void test_lit_at_start() {
+  TEST_ASSERT_EQUAL(RED, flash_effect_color_at(GAME_OVER_FLASH, 0));
+  TEST_ASSERT_EQUAL(RED, flash_effect_color_at(GAME_OVER_FLASH, 149));
+}
+
+void test_dark_in_off_phase() {
+  TEST_ASSERT_EQUAL(0, flash_effect_color_at(GAME_OVER_FLASH, 150));
+  TEST_ASSERT_EQUAL(0, flash_effect_color_at(GAME_OVER_FLASH, 299));
+}
+
+void test_lit_on_later_flash() {
+  TEST_ASSERT_EQUAL(RED, flash_effect_color_at(GAME_OVER_FLASH, 300));
+  TEST_ASSERT_EQUAL(RED, flash_effect_color_at(GAME_OVER_FLASH, 600));
+}
+
+void test_dark_after_last_flash() {
+  TEST_ASSERT_EQUAL(0, flash_effect_color_at(GAME_OVER_FLASH, 900));
+  TEST_ASSERT_EQUAL(0, flash_effect_color_at(WIN_HOLD_FLASH, 1500));
+}
+
+// Test single flash with no off phase (Pulse Warrior hit)
+void test_single_flash_no_off_phase() {
+  FlashEffect hit = {0x00FF00, 1, 50, 0, 0};
+  TEST_ASSERT_EQUAL(50, flash_effect_duration_ms(hit));
+  TEST_ASSERT_EQUAL(0x00FF00, flash_effect_color_at(hit, 49));
+  TEST_ASSERT_EQUAL(0, flash_effect_color_at(hit, 50));
+}
+
+// Test degenerate effect never lights
+void test_empty_effect() {
+  FlashEffect none = {RED, 0, 0, 0, 0};
+  TEST_ASSERT_EQUAL(0, flash_effect_duration_ms(none));
+  TEST_ASSERT_EQUAL(0, flash_effect_color_at(none, 0));
+}
+
+// Test frame-by-frame playback covers every keyframe (16ms frames)
+void test_frame_stepping_sees_all_flashes() {
+  uint32_t duration = flash_effect_duration_ms(GAME_OVER_FLASH);
+  uint32_t prev = 0;
+  int edges = 0;
+  for (uint32_t t = 0; t < duration; t += 16) {
+    uint32_t color = flash_effect_color_at(GAME_OVER_FLASH, t);
+    if (color != prev && color == RED) edges++;
+    prev = color;
+  }
+  TEST_ASSERT_EQUAL(3, edges);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main() {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_duration_without_hold);
+  RUN_TEST(test_duration_with_hold);
+  RUN_TEST(test_lit_at_start);
+  RUN_TEST(test_dark_in_off_phase);
+  RUN_TEST(test_lit_on_later_flash);
+  RUN_TEST(test_dark_after_last_flash);
+  RUN_TEST(test_single_flash_no_off_phase);
+  RUN_TEST(test_empty_effect);
+  RUN_TEST(test_frame_stepping_sees_all_flashes);
+
+  return UNITY_END();
+}
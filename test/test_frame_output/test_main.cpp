@@ -0,0 +1,45 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/render/frame_output.h"
+
+// Test dirty-frame detection (hash logic, no FastLED needed); showing and
+// skipping through the real output stage is in test_sim_frame_output
+
+// Test hash stability
+void test_hash_same_content() {
+  uint8_t a[24] = {0};
+  uint8_t b[24] = {0};
+  TEST_ASSERT_EQUAL(frame_hash(a, sizeof(a)), frame_hash(b, sizeof(b)));
+}
+
+void test_hash_single_channel_change() {
+  uint8_t a[24] = {0};
+  uint8_t b[24] = {0};
+  b[23] = 1;  // Last LED, blue channel
+  TEST_ASSERT_NOT_EQUAL(frame_hash(a, sizeof(a)), frame_hash(b, sizeof(b)));
+}
+
+void test_hash_swapped_pixels() {
+  // Moving a dot one LED over must count as a change
+  uint8_t a[24] = {0};
+  uint8_t b[24] = {0};
+  a[3] = 255;
+  b[6] = 255;
+  TEST_ASSERT_NOT_EQUAL(frame_hash(a, sizeof(a)), frame_hash(b, sizeof(b)));
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main() {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_hash_same_content);
+  RUN_TEST(test_hash_single_channel_change);
+  RUN_TEST(test_hash_swapped_pixels);
+
+  return UNITY_END();
+}
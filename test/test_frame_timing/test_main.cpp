@@ -0,0 +1,71 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/status/frame_timing.h"
+#include "../../src/games/tick_scheduler.h"
+
+// Test the loop-time histogram buckets, stall log indexing and tick lateness
+
+void test_bucket_is_log2_of_us() {
+  TEST_ASSERT_EQUAL(0, frame_hist_bucket(0));
+  TEST_ASSERT_EQUAL(0, frame_hist_bucket(1));
+  TEST_ASSERT_EQUAL(1, frame_hist_bucket(2));
+  TEST_ASSERT_EQUAL(1, frame_hist_bucket(3));
+  TEST_ASSERT_EQUAL(9, frame_hist_bucket(1000));     // 1ms: [512, 1024)
+  TEST_ASSERT_EQUAL(14, frame_hist_bucket(16667));   // 60fps frame
+  TEST_ASSERT_EQUAL(15, frame_hist_bucket(FRAME_STALL_US));
+}
+
+void test_last_bucket_open_ended() {
+  TEST_ASSERT_EQUAL(FRAME_HIST_BUCKETS - 1, frame_hist_bucket(1u << 19));
+  TEST_ASSERT_EQUAL(FRAME_HIST_BUCKETS - 1, frame_hist_bucket(5000000));
+  TEST_ASSERT_EQUAL(FRAME_HIST_BUCKETS - 1, frame_hist_bucket(0xFFFFFFFF));
+}
+
+void test_histogram_counts_and_max() {
+  FrameHistogram h = {};
+  frame_hist_add(h, 900);
+  frame_hist_add(h, 1000);
+  frame_hist_add(h, 120000);
+  TEST_ASSERT_EQUAL(3, h.count);
+  TEST_ASSERT_EQUAL(120000, h.maxUs);
+  TEST_ASSERT_EQUAL(2, h.buckets[9]);
+  TEST_ASSERT_EQUAL(1, h.buckets[16]);
+}
+
+void test_stall_log_window() {
+  FrameTimingSnapshot s = {};
+  TEST_ASSERT_EQUAL(0, frame_timing_first_logged(s));
+  s.stallCount = 5;
+  TEST_ASSERT_EQUAL(0, frame_timing_first_logged(s));
+  s.stallCount = FRAME_STALL_LOG + 7;
+  TEST_ASSERT_EQUAL(7, frame_timing_first_logged(s));
+}
+
+void test_tick_lateness() {
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 50);
+
+  // Not due yet
+  TEST_ASSERT_EQUAL(0, tick_scheduler_lateness(sched, 30));
+  tick_scheduler_advance(sched, 30);
+
+  // Due exactly now
+  TEST_ASSERT_EQUAL(0, tick_scheduler_lateness(sched, 20));
+  tick_scheduler_advance(sched, 20);
+
+  // A 200ms stall: the oldest owed tick has waited 150ms
+  TEST_ASSERT_EQUAL(150, tick_scheduler_lateness(sched, 200));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bucket_is_log2_of_us);
+  RUN_TEST(test_last_bucket_open_ended);
+  RUN_TEST(test_histogram_counts_and_max);
+  RUN_TEST(test_stall_log_window);
+  RUN_TEST(test_tick_lateness);
+  return UNITY_END();
+}
@@ -1,6 +1,7 @@
 #include <unity.h>
 #include <cstdint>
 #include <cstring>
+#include "../../src/games/tick_scheduler.h"
 
 // Mock EEPROM for testing
 static uint8_t mock_eeprom[256] = {0};
@@ -29,27 +30,43 @@ extern "C" {
 
 // Mock game wrapper functions (these would normally be in game files)
 static bool game_00_setup_called = false;
-static bool game_00_loop_called = false;
+static bool game_00_update_called = false;
 static bool game_01_setup_called = false;
-static bool game_01_loop_called = false;
-static uint32_t last_loop_dt = 0;
+static bool game_01_update_called = false;
+static uint32_t tick_count = 0;
+static uint32_t render_count = 0;
 
 void game_00_setup() {
   game_00_setup_called = true;
 }
 
-void game_00_loop(uint32_t dt) {
-  game_00_loop_called = true;
-  last_loop_dt = dt;
+void game_00_update() {
+  game_00_update_called = true;
+  tick_count++;
+}
+
+void game_00_render() {
+  render_count++;
 }
 
 void game_01_setup() {
   game_01_setup_called = true;
 }
 
-void game_01_loop(uint32_t dt) {
-  game_01_loop_called = true;
-  last_loop_dt = dt;
+void game_01_update() {
+  game_01_update_called = true;
+  tick_count++;
+}
+
+void game_01_render() {
+  render_count++;
+}
+
+// Mirrors game_manager_loop(): update per owed tick, render once if any ran
+static void run_frame(TickScheduler& sched, uint32_t dt) {
+  uint8_t ticks = tick_scheduler_advance(sched, dt);
+  for (uint8_t i = 0; i < ticks; i++) game_00_update();
+  if (ticks > 0) game_00_render();
 }
 
 // Include game_manager implementation (we'll need to modify it slightly for testing)
@@ -133,15 +150,15 @@ void test_game_setup_called() {
   TEST_ASSERT_TRUE(true); // Placeholder
 }
 
-// Test game loop is called
+// Test game update is called
 void test_game_loop_called() {
-  // When calling game_manager_loop, the current game's loop should be called
-  // In real: game_00_loop_called = false;
-  // game_manager_set_game(0);
-  // game_manager_loop(33);
-  // TEST_ASSERT_TRUE(game_00_loop_called);
-  // TEST_ASSERT_EQUAL(33, last_loop_dt);
-  TEST_ASSERT_TRUE(true); // Placeholder
+  // When calling game_manager_loop, the current game's update should run once per owed tick
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 33);
+  uint8_t ticks = tick_scheduler_advance(sched, 33);
+  for (uint8_t i = 0; i < ticks; i++) game_00_update();
+  TEST_ASSERT_TRUE(game_00_update_called);
+  TEST_ASSERT_EQUAL(1, tick_count);
 }
 
 // Test game switching
@@ -156,15 +173,95 @@ void test_game_switching() {
   TEST_ASSERT_TRUE(true); // Placeholder
 }
 
+// Test fixed-timestep scheduler
+void test_scheduler_no_tick_before_step() {
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 50);
+  TEST_ASSERT_EQUAL(0, tick_scheduler_advance(sched, 49));
+  TEST_ASSERT_EQUAL(1, tick_scheduler_advance(sched, 1));
+}
+
+void test_scheduler_keeps_remainder() {
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 50);
+  TEST_ASSERT_EQUAL(2, tick_scheduler_advance(sched, 120));
+  TEST_ASSERT_EQUAL(20, sched.accum);
+  TEST_ASSERT_EQUAL(1, tick_scheduler_advance(sched, 30));
+  TEST_ASSERT_EQUAL(0, sched.accum);
+}
+
+void test_scheduler_clamps_catch_up() {
+  // A 1 second stall at 50ms/tick owes 20 ticks, but only MAX_TICKS_PER_FRAME run
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 50);
+  TEST_ASSERT_EQUAL(MAX_TICKS_PER_FRAME, tick_scheduler_advance(sched, 1000));
+  TEST_ASSERT_EQUAL(20 - MAX_TICKS_PER_FRAME, sched.dropped);
+
+  // Backlog is gone: the next short frame runs no extra ticks
+  TEST_ASSERT_EQUAL(0, tick_scheduler_advance(sched, 10));
+}
+
+void test_scheduler_reset_on_switch() {
+  // Switching games must not carry accumulated time into the new game
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 100);
+  tick_scheduler_advance(sched, 90);
+  tick_scheduler_reset(sched, 30);
+  TEST_ASSERT_EQUAL(0, sched.accum);
+  TEST_ASSERT_EQUAL(30, sched.tickMs);
+  TEST_ASSERT_EQUAL(0, tick_scheduler_advance(sched, 29));
+}
+
+void test_scheduler_alpha() {
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 100);
+  TEST_ASSERT_EQUAL(0, tick_scheduler_alpha(sched));
+  tick_scheduler_advance(sched, 50);
+  TEST_ASSERT_EQUAL(128, tick_scheduler_alpha(sched));
+  tick_scheduler_advance(sched, 49);
+  TEST_ASSERT_EQUAL(253, tick_scheduler_alpha(sched));
+}
+
+void test_scheduler_zero_step_is_idle() {
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 0);
+  TEST_ASSERT_EQUAL(0, tick_scheduler_advance(sched, 1000));
+  TEST_ASSERT_EQUAL(0, tick_scheduler_alpha(sched));
+}
+
+// Test update/render split
+void test_render_once_after_catch_up() {
+  // Three ticks owed in one frame still render only once
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 50);
+  run_frame(sched, 150);
+  TEST_ASSERT_EQUAL(3, tick_count);
+  TEST_ASSERT_EQUAL(1, render_count);
+}
+
+void test_no_render_without_tick() {
+  // Frames faster than the tick rate leave the framebuffer alone
+  TickScheduler sched;
+  tick_scheduler_reset(sched, 50);
+  run_frame(sched, 10);
+  run_frame(sched, 10);
+  TEST_ASSERT_EQUAL(0, tick_count);
+  TEST_ASSERT_EQUAL(0, render_count);
+  run_frame(sched, 30);
+  TEST_ASSERT_EQUAL(1, tick_count);
+  TEST_ASSERT_EQUAL(1, render_count);
+}
+
 void setUp(void) {
   // Reset mocks
   memset(mock_eeprom, 0, sizeof(mock_eeprom));
   eeprom_initialized = false;
   game_00_setup_called = false;
-  game_00_loop_called = false;
+  game_00_update_called = false;
   game_01_setup_called = false;
-  game_01_loop_called = false;
-  last_loop_dt = 0;
+  game_01_update_called = false;
+  tick_count = 0;
+  render_count = 0;
 }
 
 void tearDown(void) {
@@ -185,6 +282,14 @@ int main() {
   RUN_TEST(test_game_setup_called);
   RUN_TEST(test_game_loop_called);
   RUN_TEST(test_game_switching);
+  RUN_TEST(test_scheduler_no_tick_before_step);
+  RUN_TEST(test_scheduler_keeps_remainder);
+  RUN_TEST(test_scheduler_clamps_catch_up);
+  RUN_TEST(test_scheduler_reset_on_switch);
+  RUN_TEST(test_scheduler_alpha);
+  RUN_TEST(test_scheduler_zero_step_is_idle);
+  RUN_TEST(test_render_once_after_catch_up);
+  RUN_TEST(test_no_render_without_tick);
 
   return UNITY_END();
 }
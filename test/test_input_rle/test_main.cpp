@@ -0,0 +1,153 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include "../../src/input/input_rle.h"
+
+// Test the run-length input stream used by the input recorder
+
+static uint8_t buf[2048];
+
+static uint32_t decodeAll(const uint8_t* data, uint16_t length, uint32_t* out, uint32_t max) {
+  InputRleReader r;
+  input_rle_open(r, data, length);
+  uint32_t n = 0;
+  uint32_t state;
+  while (n < max && input_rle_next(r, state)) {
+    out[n++] = state;
+  }
+  return n;
+}
+
+void test_empty_stream() {
+  InputRleWriter w;
+  input_rle_begin(w, buf, sizeof(buf));
+  TEST_ASSERT_TRUE(input_rle_flush(w));
+  TEST_ASSERT_EQUAL(0, w.length);
+
+  InputRleReader r;
+  input_rle_open(r, buf, 0);
+  uint32_t state;
+  TEST_ASSERT_FALSE(input_rle_next(r, state));
+}
+
+void test_roundtrip_sequence() {
+  // Up to 28 bits: the top 16 are the per-button press phases
+  const uint32_t ticks[] = {0, 0, 0, 0x011, 0x001, 0x001, 0x100, 0, 0x0FF, 0xFFF, 0xFFF, 0xF00F0F0, 0xFFFFFFF, 0};
+  const uint32_t n = sizeof(ticks) / sizeof(ticks[0]);
+
+  InputRleWriter w;
+  input_rle_begin(w, buf, sizeof(buf));
+  for (uint32_t i = 0; i < n; i++) {
+    TEST_ASSERT_TRUE(input_rle_push(w, ticks[i]));
+  }
+  TEST_ASSERT_TRUE(input_rle_flush(w));
+
+  uint32_t out[32];
+  TEST_ASSERT_EQUAL(n, decodeAll(buf, w.length, out, 32));
+  for (uint32_t i = 0; i < n; i++) {
+    TEST_ASSERT_EQUAL_UINT32(ticks[i], out[i]);
+  }
+}
+
+void test_idle_run_is_compact() {
+  InputRleWriter w;
+  input_rle_begin(w, buf, sizeof(buf));
+  for (int i = 0; i < 100000; i++) {
+    input_rle_push(w, 0);
+  }
+  input_rle_flush(w);
+  // State 0 (1 byte) + 100000 as a varint (3 bytes)
+  TEST_ASSERT_EQUAL(4, w.length);
+}
+
+void test_open_run_not_in_buffer_until_flush() {
+  InputRleWriter w;
+  input_rle_begin(w, buf, sizeof(buf));
+  input_rle_push(w, 5);
+  input_rle_push(w, 5);
+  TEST_ASSERT_EQUAL(0, w.length);
+  input_rle_push(w, 6);  // Closes the run of 5s
+  TEST_ASSERT_EQUAL(2, w.length);
+}
+
+void test_overflow_stops_cleanly() {
+  uint8_t small[6];
+  InputRleWriter w;
+  input_rle_begin(w, small, sizeof(small));
+
+  // Alternating states: every tick is a 2-byte run
+  bool ok = true;
+  int pushed = 0;
+  while (ok && pushed < 100) {
+    ok = input_rle_push(w, (uint32_t)(pushed & 1));
+    if (ok) pushed++;
+  }
+  TEST_ASSERT_TRUE(w.overflow);
+  TEST_ASSERT_LESS_OR_EQUAL(6, w.length);
+  TEST_ASSERT_FALSE(input_rle_push(w, 0));
+
+  // Everything that was closed still decodes
+  uint32_t out[8];
+  uint32_t n = decodeAll(small, w.length, out, 8);
+  TEST_ASSERT_EQUAL(3, n);
+  for (uint32_t i = 0; i < n; i++) {
+    TEST_ASSERT_EQUAL_UINT32(i & 1, out[i]);
+  }
+}
+
+void test_truncated_varint_ends_stream() {
+  const uint8_t bad[] = {0x01, 0x80};  // Count varint cut short
+  uint32_t out[4];
+  TEST_ASSERT_EQUAL(0, decodeAll(bad, sizeof(bad), out, 4));
+}
+
+// Replay decode must be far faster than the game's tick rate
+void test_decode_throughput() {
+  InputRleWriter w;
+  input_rle_begin(w, buf, sizeof(buf));
+  uint32_t x = 1;
+  uint32_t ticks = 0;
+  while (true) {
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    uint32_t state = (x % 8 == 0) ? (x >> 4) & 0xFFFFFFF : 0;
+    if (!input_rle_push(w, state)) break;
+    ticks++;
+  }
+
+  const int PASSES = 200;
+  uint64_t decoded = 0;
+  uint32_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int p = 0; p < PASSES; p++) {
+    InputRleReader r;
+    input_rle_open(r, buf, w.length);
+    uint32_t state;
+    while (input_rle_next(r, state)) {
+      sink += state;
+      decoded++;
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / decoded;
+  printf("input_rle decode_ns_per_tick=%.1f realtime_factor_at_33ms=%.0f (sink %u)\n",
+         ns, 33e6 / ns, sink);
+
+  TEST_ASSERT_GREATER_THAN(0, decoded);
+  TEST_ASSERT_LESS_THAN(33000.0, ns);  // Well over 1000x real time
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_stream);
+  RUN_TEST(test_roundtrip_sequence);
+  RUN_TEST(test_idle_run_is_compact);
+  RUN_TEST(test_open_run_not_in_buffer_until_flush);
+  RUN_TEST(test_overflow_stops_cleanly);
+  RUN_TEST(test_truncated_varint_ends_stream);
+  RUN_TEST(test_decode_throughput);
+  return UNITY_END();
+}
@@ -0,0 +1,123 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstring>
+#include "../../src/render/led_output.h"
+
+// Test the double-buffered output stage against a mock driver
+// The mock "sends" a frame for led_frame_tx_us() of virtual time
+
+static const uint16_t NUM_LEDS = 300;
+
+static uint8_t back[NUM_LEDS * 3];
+static uint8_t front[NUM_LEDS * 3];
+static uint8_t wire[NUM_LEDS * 3];  // What the mock latched at transmit start
+
+static uint32_t mockNowUs = 0;
+static uint32_t mockBusyUntilUs = 0;
+static uint32_t mockTransmits = 0;
+
+static void mockTransmit(const uint8_t* frame, uint16_t numLeds) {
+  memcpy(wire, frame, (size_t)numLeds * 3);
+  mockBusyUntilUs = mockNowUs + led_frame_tx_us(numLeds);
+  mockTransmits++;
+}
+
+static bool mockIsBusy() {
+  return mockNowUs < mockBusyUntilUs;
+}
+
+static const LedDriver MOCK_DRIVER = {mockTransmit, mockIsBusy};
+static LedOutput output;
+
+// Test wire time accounting
+void test_frame_tx_time() {
+  TEST_ASSERT_EQUAL(8 * 30 + 50, led_frame_tx_us(8));
+  TEST_ASSERT_EQUAL(1000 * 30 + 50, led_frame_tx_us(1000));
+}
+
+// Test swap semantics
+void test_submit_copies_back_to_front() {
+  back[0] = 10;
+  back[NUM_LEDS * 3 - 1] = 20;
+  TEST_ASSERT_TRUE(led_output_submit(output, back));
+  TEST_ASSERT_EQUAL(10, front[0]);
+  TEST_ASSERT_EQUAL(20, front[NUM_LEDS * 3 - 1]);
+  TEST_ASSERT_EQUAL(10, wire[0]);
+}
+
+void test_rendering_next_frame_does_not_touch_front() {
+  back[5] = 1;
+  led_output_submit(output, back);
+
+  // Game renders the next frame while the previous one streams out
+  back[5] = 200;
+  TEST_ASSERT_EQUAL(1, front[5]);
+}
+
+void test_back_buffer_keeps_previous_frame() {
+  // Copy (not pointer swap): fade trails still see the last frame
+  back[9] = 77;
+  led_output_submit(output, back);
+  TEST_ASSERT_EQUAL(77, back[9]);
+}
+
+// Test busy driver defers the frame
+void test_submit_while_busy_is_deferred() {
+  led_output_submit(output, back);
+  mockNowUs += 100;  // Far less than 300 LEDs of wire time
+
+  back[0] = 99;
+  TEST_ASSERT_FALSE(led_output_submit(output, back));
+  TEST_ASSERT_EQUAL(0, front[0]);
+  TEST_ASSERT_EQUAL(1, output.stats.framesDeferred);
+  TEST_ASSERT_EQUAL(1, mockTransmits);
+}
+
+void test_deferred_frame_sent_when_idle() {
+  led_output_submit(output, back);
+  back[0] = 99;
+  TEST_ASSERT_FALSE(led_output_submit(output, back));
+
+  mockNowUs += led_frame_tx_us(NUM_LEDS);
+  TEST_ASSERT_TRUE(led_output_submit(output, back));
+  TEST_ASSERT_EQUAL(99, wire[0]);
+  TEST_ASSERT_EQUAL(2, output.stats.framesSent);
+}
+
+// Test timing accounting over a run at 60fps
+void test_tx_time_accounted_per_frame() {
+  for (int frame = 0; frame < 60; frame++) {
+    led_output_submit(output, back);
+    mockNowUs += 16667;
+  }
+  TEST_ASSERT_EQUAL(60, output.stats.framesSent);
+  TEST_ASSERT_EQUAL(0, output.stats.framesDeferred);
+  TEST_ASSERT_EQUAL(60 * led_frame_tx_us(NUM_LEDS), output.stats.txMicros);
+}
+
+void setUp(void) {
+  memset(back, 0, sizeof(back));
+  memset(front, 0, sizeof(front));
+  memset(wire, 0, sizeof(wire));
+  mockNowUs = 0;
+  mockBusyUntilUs = 0;
+  mockTransmits = 0;
+  led_output_setup(output, front, NUM_LEDS, &MOCK_DRIVER);
+}
+
+void tearDown(void) {
+}
+
+int main() {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_frame_tx_time);
+  RUN_TEST(test_submit_copies_back_to_front);
+  RUN_TEST(test_rendering_next_frame_does_not_touch_front);
+  RUN_TEST(test_back_buffer_keeps_previous_frame);
+  RUN_TEST(test_submit_while_busy_is_deferred);
+  RUN_TEST(test_deferred_frame_sent_when_idle);
+  RUN_TEST(test_tx_time_accounted_per_frame);
+
+  return UNITY_END();
+}
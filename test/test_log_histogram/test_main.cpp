@@ -0,0 +1,98 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/status/log_histogram.h"
+
+// Test the log-linear histogram behind the timing probes' percentiles
+
+static LogHistogram h;
+
+void test_small_values_exact() {
+  for (uint32_t v = 0; v < LOG_HISTOGRAM_SUB; v++) {
+    uint8_t b = log_histogram_bucket(v);
+    TEST_ASSERT_EQUAL(v, log_histogram_lower(b));
+    TEST_ASSERT_EQUAL(v, log_histogram_upper(b));
+  }
+}
+
+void test_bucket_bounds_contain_value() {
+  const uint32_t values[] = {4, 5, 7, 8, 9, 100, 1000, 4095, 4096, 240000000, 0x7FFFFFFF, 0xFFFFFFFF};
+  for (uint32_t v : values) {
+    uint8_t b = log_histogram_bucket(v);
+    TEST_ASSERT_LESS_THAN(LOG_HISTOGRAM_BUCKETS, b);
+    TEST_ASSERT_LESS_OR_EQUAL(v, log_histogram_lower(b));
+    TEST_ASSERT_GREATER_OR_EQUAL(v, log_histogram_upper(b));
+  }
+  TEST_ASSERT_EQUAL(LOG_HISTOGRAM_BUCKETS - 1, log_histogram_bucket(0xFFFFFFFF));
+}
+
+// Buckets tile the range with no gaps or overlaps
+void test_buckets_are_contiguous() {
+  for (uint8_t b = 1; b < LOG_HISTOGRAM_BUCKETS; b++) {
+    TEST_ASSERT_EQUAL_UINT32(log_histogram_upper(b - 1) + 1, log_histogram_lower(b));
+  }
+}
+
+void test_relative_error_bounded() {
+  for (uint8_t b = LOG_HISTOGRAM_SUB; b < LOG_HISTOGRAM_BUCKETS; b++) {
+    double lo = log_histogram_lower(b);
+    double hi = log_histogram_upper(b);
+    TEST_ASSERT_LESS_OR_EQUAL(0.25, (hi - lo) / lo);
+  }
+}
+
+void test_empty_percentile_is_zero() {
+  log_histogram_clear(h);
+  TEST_ASSERT_EQUAL(0, log_histogram_percentile(h, 99));
+}
+
+void test_min_max_sum() {
+  log_histogram_clear(h);
+  log_histogram_add(h, 300);
+  log_histogram_add(h, 100);
+  log_histogram_add(h, 200);
+  TEST_ASSERT_EQUAL(3, h.total);
+  TEST_ASSERT_EQUAL(100, h.min);
+  TEST_ASSERT_EQUAL(300, h.max);
+  TEST_ASSERT_EQUAL_UINT64(600, h.sum);
+}
+
+// 990 fast samples and 10 stalls: p99 is still fast, p100 is the stall
+void test_percentile_finds_tail() {
+  log_histogram_clear(h);
+  for (int i = 0; i < 990; i++) {
+    log_histogram_add(h, 1000);
+  }
+  for (int i = 0; i < 10; i++) {
+    log_histogram_add(h, 50000);
+  }
+  uint32_t p99 = log_histogram_percentile(h, 99);
+  TEST_ASSERT_GREATER_OR_EQUAL(1000, p99);
+  TEST_ASSERT_LESS_OR_EQUAL(1250, p99);
+  TEST_ASSERT_EQUAL(50000, log_histogram_percentile(h, 100));
+
+  log_histogram_add(h, 50000);  // 11 stalls: over 1%
+  TEST_ASSERT_GREATER_OR_EQUAL(40000, log_histogram_percentile(h, 99));
+}
+
+void test_percentile_clamped_to_observed() {
+  log_histogram_clear(h);
+  log_histogram_add(h, 1001);
+  TEST_ASSERT_EQUAL(1001, log_histogram_percentile(h, 50));
+  TEST_ASSERT_EQUAL(1001, log_histogram_percentile(h, 99));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_small_values_exact);
+  RUN_TEST(test_bucket_bounds_contain_value);
+  RUN_TEST(test_buckets_are_contiguous);
+  RUN_TEST(test_relative_error_bounded);
+  RUN_TEST(test_empty_percentile_is_zero);
+  RUN_TEST(test_min_max_sum);
+  RUN_TEST(test_percentile_finds_tail);
+  RUN_TEST(test_percentile_clamped_to_observed);
+  return UNITY_END();
+}
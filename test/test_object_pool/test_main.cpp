@@ -0,0 +1,166 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/games/object_pool.h"
+
+// Test the fixed-capacity entity pool
+
+struct Entity {
+  int pos = 0;
+  int dir = 1;
+};
+
+void test_pool_starts_empty() {
+  ObjectPool<Entity, 4> pool;
+  TEST_ASSERT_TRUE(pool.empty());
+  TEST_ASSERT_EQUAL(0, pool.size());
+  TEST_ASSERT_EQUAL(4, pool.capacity());
+}
+
+void test_acquire_until_full() {
+  ObjectPool<Entity, 3> pool;
+  TEST_ASSERT_NOT_NULL(pool.acquire());
+  TEST_ASSERT_NOT_NULL(pool.acquire());
+  TEST_ASSERT_NOT_NULL(pool.acquire());
+  TEST_ASSERT_TRUE(pool.full());
+  TEST_ASSERT_NULL(pool.acquire());
+  TEST_ASSERT_EQUAL(3, pool.size());
+}
+
+void test_acquire_resets_object() {
+  ObjectPool<Entity, 1> pool;
+  Entity* e = pool.acquire();
+  e->pos = 42;
+  e->dir = -1;
+  pool.release(e);
+
+  e = pool.acquire();
+  TEST_ASSERT_EQUAL(0, e->pos);
+  TEST_ASSERT_EQUAL(1, e->dir);
+}
+
+void test_iteration_visits_live_only() {
+  ObjectPool<Entity, 8> pool;
+  for (int i = 0; i < 5; i++) {
+    pool.acquire()->pos = i;
+  }
+  pool.releaseAt(1);  // Releases pos 1
+
+  int sum = 0;
+  for (int i = 0; i < pool.size(); i++) {
+    TEST_ASSERT_NOT_EQUAL(1, pool[i].pos);
+    sum += pool[i].pos;
+  }
+  TEST_ASSERT_EQUAL(4, pool.size());
+  TEST_ASSERT_EQUAL(0 + 2 + 3 + 4, sum);
+}
+
+void test_release_while_iterating_backwards() {
+  ObjectPool<Entity, 8> pool;
+  for (int i = 0; i < 8; i++) {
+    pool.acquire()->pos = i;
+  }
+
+  // Drop every even position, as a game update loop would
+  for (int i = pool.size() - 1; i >= 0; i--) {
+    if (pool[i].pos % 2 == 0) {
+      pool.releaseAt(i);
+    }
+  }
+
+  TEST_ASSERT_EQUAL(4, pool.size());
+  for (int i = 0; i < pool.size(); i++) {
+    TEST_ASSERT_EQUAL(1, pool[i].pos % 2);
+  }
+}
+
+void test_pointers_stable_across_release() {
+  ObjectPool<Entity, 4> pool;
+  Entity* a = pool.acquire();
+  Entity* b = pool.acquire();
+  Entity* c = pool.acquire();
+  a->pos = 10;
+  b->pos = 20;
+  c->pos = 30;
+
+  pool.release(a);  // c moves in the dense order, not in memory
+
+  TEST_ASSERT_EQUAL(20, b->pos);
+  TEST_ASSERT_EQUAL(30, c->pos);
+}
+
+void test_release_rejects_dead_and_foreign() {
+  ObjectPool<Entity, 2> pool;
+  Entity other;
+  Entity* e = pool.acquire();
+
+  TEST_ASSERT_TRUE(pool.release(e));
+  TEST_ASSERT_FALSE(pool.release(e));       // Double release
+  TEST_ASSERT_FALSE(pool.release(&other));  // Not from this pool
+  TEST_ASSERT_EQUAL(0, pool.size());
+}
+
+void test_handle_goes_stale_after_release() {
+  ObjectPool<Entity, 2> pool;
+  Entity* e = pool.acquire();
+  PoolHandle h = pool.handleOf(e);
+  TEST_ASSERT_EQUAL_PTR(e, pool.get(h));
+
+  pool.release(e);
+  TEST_ASSERT_NULL(pool.get(h));
+
+  // Slot reuse does not revive the old handle
+  Entity* reused = pool.acquire();
+  TEST_ASSERT_EQUAL_PTR(e, reused);
+  TEST_ASSERT_NULL(pool.get(h));
+  TEST_ASSERT_EQUAL_PTR(reused, pool.get(pool.handleOf(reused)));
+}
+
+void test_clear_releases_all_and_invalidates_handles() {
+  ObjectPool<Entity, 4> pool;
+  PoolHandle h = pool.handleOf(pool.acquire());
+  pool.acquire();
+
+  pool.clear();
+  TEST_ASSERT_TRUE(pool.empty());
+  TEST_ASSERT_NULL(pool.get(h));
+
+  for (int i = 0; i < 4; i++) {
+    TEST_ASSERT_NOT_NULL(pool.acquire());
+  }
+  TEST_ASSERT_TRUE(pool.full());
+}
+
+void test_churn_keeps_invariants() {
+  ObjectPool<Entity, 16> pool;
+  uint32_t x = 12345;
+  int live = 0;
+
+  for (int step = 0; step < 10000; step++) {
+    x = x * 1103515245u + 12345u;
+    if ((x >> 16) & 1) {
+      if (pool.acquire()) live++;
+    } else if (!pool.empty()) {
+      pool.releaseAt((x >> 8) % pool.size());
+      live--;
+    }
+    TEST_ASSERT_EQUAL(live, pool.size());
+  }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_pool_starts_empty);
+  RUN_TEST(test_acquire_until_full);
+  RUN_TEST(test_acquire_resets_object);
+  RUN_TEST(test_iteration_visits_live_only);
+  RUN_TEST(test_release_while_iterating_backwards);
+  RUN_TEST(test_pointers_stable_across_release);
+  RUN_TEST(test_release_rejects_dead_and_foreign);
+  RUN_TEST(test_handle_goes_stale_after_release);
+  RUN_TEST(test_clear_releases_all_and_invalidates_handles);
+  RUN_TEST(test_churn_keeps_invariants);
+  return UNITY_END();
+}
@@ -0,0 +1,144 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/games/occupancy_layer.h"
+
+// Test the 1D occupancy layer used for entity collisions
+
+void test_layer_starts_empty() {
+  OccupancyLayer<100, 8> layer;
+  TEST_ASSERT_EQUAL(0, layer.count());
+  for (uint16_t c = 0; c < 100; c++) {
+    TEST_ASSERT_FALSE(layer.occupied(c));
+    TEST_ASSERT_EQUAL(OCCUPANCY_NONE, layer.first(c));
+  }
+}
+
+void test_insert_sets_bit_and_list() {
+  OccupancyLayer<100, 8> layer;
+  layer.insert(3, 40);
+  TEST_ASSERT_TRUE(layer.occupied(40));
+  TEST_ASSERT_FALSE(layer.occupied(39));
+  TEST_ASSERT_EQUAL(3, layer.first(40));
+  TEST_ASSERT_EQUAL(1, layer.count());
+}
+
+void test_cell_holds_several_ids() {
+  OccupancyLayer<16, 8> layer;
+  layer.insert(1, 5);
+  layer.insert(2, 5);
+  layer.insert(4, 5);
+
+  int seen = 0;
+  for (uint16_t id = layer.first(5); id != OCCUPANCY_NONE; id = layer.next[id]) {
+    seen |= 1 << id;
+  }
+  TEST_ASSERT_EQUAL((1 << 1) | (1 << 2) | (1 << 4), seen);
+  TEST_ASSERT_EQUAL(1, layer.count());
+
+  // Bit stays set until the last id leaves
+  layer.remove(2);
+  layer.remove(4);
+  TEST_ASSERT_TRUE(layer.occupied(5));
+  layer.remove(1);
+  TEST_ASSERT_FALSE(layer.occupied(5));
+}
+
+void test_move_updates_cells() {
+  OccupancyLayer<64, 4> layer;
+  layer.insert(0, 31);
+  layer.move(0, 32);  // Crosses a word boundary
+  TEST_ASSERT_FALSE(layer.occupied(31));
+  TEST_ASSERT_TRUE(layer.occupied(32));
+  TEST_ASSERT_EQUAL(32, layer.cell[0]);
+}
+
+void test_overlap_count_and_next() {
+  OccupancyLayer<300, 8> a;
+  OccupancyLayer<300, 8> b;
+  a.insert(0, 10);
+  a.insert(1, 150);
+  a.insert(2, 299);
+  b.insert(0, 150);
+  b.insert(1, 299);
+  b.insert(2, 11);
+
+  TEST_ASSERT_EQUAL(2, occupancy_overlap_count(a, b));
+  TEST_ASSERT_EQUAL(150, occupancy_next_overlap(a, b));
+  TEST_ASSERT_EQUAL(299, occupancy_next_overlap(a, b, 151));
+  TEST_ASSERT_EQUAL(OCCUPANCY_NONE, occupancy_next_overlap(a, b, 300));
+}
+
+void test_no_overlap() {
+  OccupancyLayer<1000, 4> a;
+  OccupancyLayer<1000, 4> b;
+  a.insert(0, 0);
+  b.insert(0, 999);
+  TEST_ASSERT_EQUAL(0, occupancy_overlap_count(a, b));
+  TEST_ASSERT_EQUAL(OCCUPANCY_NONE, occupancy_next_overlap(a, b));
+}
+
+// Bullet 5 -> 6 while enemy 6 -> 5: same-cell check misses, crossing finds it
+void test_crossing_detects_swap() {
+  OccupancyLayer<8, 2> bullets;
+  OccupancyLayer<8, 2> enemies;
+  bullets.insert(0, 5);
+  enemies.insert(0, 6);
+
+  bullets.move(0, 6);
+  enemies.move(0, 5);
+
+  TEST_ASSERT_EQUAL(0, occupancy_overlap_count(bullets, enemies));
+  TEST_ASSERT_TRUE(bullets.movedThisStep(0));
+  TEST_ASSERT_EQUAL(0, enemies.crossing(bullets.prev[0], bullets.cell[0]));
+}
+
+// Same direction, adjacent: not a crossing
+void test_crossing_ignores_followers() {
+  OccupancyLayer<8, 2> bullets;
+  OccupancyLayer<8, 2> enemies;
+  bullets.insert(0, 5);
+  enemies.insert(0, 4);
+
+  bullets.move(0, 6);
+  enemies.move(0, 5);
+
+  TEST_ASSERT_EQUAL(OCCUPANCY_NONE, enemies.crossing(5, 6));
+}
+
+void test_crossing_expires_after_step() {
+  OccupancyLayer<8, 2> enemies;
+  enemies.insert(0, 6);
+  enemies.move(0, 5);
+  TEST_ASSERT_EQUAL(0, enemies.crossing(5, 6));
+
+  enemies.endStep();
+  TEST_ASSERT_FALSE(enemies.movedThisStep(0));
+  TEST_ASSERT_EQUAL(OCCUPANCY_NONE, enemies.crossing(5, 6));
+}
+
+void test_clear_empties_layer() {
+  OccupancyLayer<60, 4> layer;
+  layer.insert(0, 1);
+  layer.insert(1, 59);
+  layer.clear();
+  TEST_ASSERT_EQUAL(0, layer.count());
+  TEST_ASSERT_EQUAL(OCCUPANCY_NONE, layer.first(59));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_layer_starts_empty);
+  RUN_TEST(test_insert_sets_bit_and_list);
+  RUN_TEST(test_cell_holds_several_ids);
+  RUN_TEST(test_move_updates_cells);
+  RUN_TEST(test_overlap_count_and_next);
+  RUN_TEST(test_no_overlap);
+  RUN_TEST(test_crossing_detects_swap);
+  RUN_TEST(test_crossing_ignores_followers);
+  RUN_TEST(test_crossing_expires_after_step);
+  RUN_TEST(test_clear_empties_layer);
+  return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstring>
+#include "../../src/games/packbits.h"
+
+// Test the PackBits codec used for game snapshots
+
+static uint8_t src[4096];
+static uint8_t packed[4200];
+static uint8_t out[4096];
+
+static void assertRoundtrip(uint32_t n) {
+  uint32_t length = packbits_encode(src, n, packed, sizeof(packed));
+  TEST_ASSERT_GREATER_THAN(0, length);
+  TEST_ASSERT_LESS_OR_EQUAL(packbits_bound(n), length);
+
+  memset(out, 0xAA, sizeof(out));
+  TEST_ASSERT_TRUE(packbits_decode(packed, length, out, n));
+  TEST_ASSERT_EQUAL_MEMORY(src, out, n);
+}
+
+void test_zeros_pack_to_runs() {
+  memset(src, 0, sizeof(src));
+  assertRoundtrip(sizeof(src));
+  // 128 bytes per 2-byte run
+  TEST_ASSERT_EQUAL(sizeof(src) / 128 * 2, packbits_encode(src, sizeof(src), packed, sizeof(packed)));
+}
+
+void test_random_bytes_roundtrip() {
+  uint32_t x = 12345;
+  for (uint32_t i = 0; i < sizeof(src); i++) {
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    src[i] = (uint8_t)x;
+  }
+  assertRoundtrip(sizeof(src));
+}
+
+void test_mixed_runs_and_literals() {
+  // Short runs (1-2 bytes) stay literal, longer ones become runs
+  uint32_t n = 0;
+  for (uint32_t len = 1; len <= 200 && n + len < sizeof(src); len++) {
+    memset(src + n, (uint8_t)len, len);
+    n += len;
+  }
+  assertRoundtrip(n);
+}
+
+void test_game_state_like_data() {
+  // A sparse uint32 array: mostly zero with scattered small values
+  memset(src, 0, sizeof(src));
+  uint32_t* words = reinterpret_cast<uint32_t*>(src);
+  for (uint32_t i = 0; i < sizeof(src) / 4; i += 37) {
+    words[i] = 800 + i;
+  }
+  uint32_t length = packbits_encode(src, sizeof(src), packed, sizeof(packed));
+  TEST_ASSERT_LESS_THAN(sizeof(src) / 4, length);
+  assertRoundtrip(sizeof(src));
+}
+
+void test_short_inputs() {
+  const uint8_t cases[][3] = {{7, 0, 0}, {7, 7, 0}, {7, 7, 7}, {1, 2, 3}};
+  for (uint32_t c = 0; c < 4; c++) {
+    for (uint32_t n = 1; n <= 3; n++) {
+      memcpy(src, cases[c], 3);
+      assertRoundtrip(n);
+    }
+  }
+}
+
+void test_capacity_too_small() {
+  memset(src, 0, 256);
+  TEST_ASSERT_EQUAL(0, packbits_encode(src, 256, packed, 3));
+  TEST_ASSERT_EQUAL(4, packbits_encode(src, 256, packed, 4));
+
+  for (uint32_t i = 0; i < 64; i++) src[i] = (uint8_t)i;
+  TEST_ASSERT_EQUAL(0, packbits_encode(src, 64, packed, 64));
+  TEST_ASSERT_EQUAL(65, packbits_encode(src, 64, packed, 65));
+}
+
+void test_malformed_streams_rejected() {
+  const uint8_t truncatedLiteral[] = {3, 1, 2};       // Promises 4 literals
+  const uint8_t truncatedRun[] = {0xFE};              // Run with no byte
+  const uint8_t tooLong[] = {0x81, 9};                // 128 bytes into 16
+  const uint8_t tooShort[] = {0xFE, 9};               // 3 bytes, 16 wanted
+  TEST_ASSERT_FALSE(packbits_decode(truncatedLiteral, sizeof(truncatedLiteral), out, 4));
+  TEST_ASSERT_FALSE(packbits_decode(truncatedRun, sizeof(truncatedRun), out, 3));
+  TEST_ASSERT_FALSE(packbits_decode(tooLong, sizeof(tooLong), out, 16));
+  TEST_ASSERT_FALSE(packbits_decode(tooShort, sizeof(tooShort), out, 16));
+
+  const uint8_t withNoop[] = {0x80, 0xFE, 9};
+  TEST_ASSERT_TRUE(packbits_decode(withNoop, sizeof(withNoop), out, 3));
+  TEST_ASSERT_EQUAL_UINT8(9, out[2]);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_zeros_pack_to_runs);
+  RUN_TEST(test_random_bytes_roundtrip);
+  RUN_TEST(test_mixed_runs_and_literals);
+  RUN_TEST(test_game_state_like_data);
+  RUN_TEST(test_short_inputs);
+  RUN_TEST(test_capacity_too_small);
+  RUN_TEST(test_malformed_streams_rejected);
+  return UNITY_END();
+}
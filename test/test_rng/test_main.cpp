@@ -0,0 +1,89 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/games/rng.h"
+
+// Test the deterministic game PRNG
+
+void test_same_seed_same_sequence() {
+  Pcg32 a, b;
+  pcg32_seed(a, 0xC0FFEE);
+  pcg32_seed(b, 0xC0FFEE);
+  for (int i = 0; i < 1000; i++) {
+    TEST_ASSERT_EQUAL_UINT32(pcg32_next(a), pcg32_next(b));
+  }
+}
+
+void test_different_seeds_diverge() {
+  Pcg32 a, b;
+  pcg32_seed(a, 1);
+  pcg32_seed(b, 2);
+  int same = 0;
+  for (int i = 0; i < 100; i++) {
+    if (pcg32_next(a) == pcg32_next(b)) same++;
+  }
+  TEST_ASSERT_LESS_THAN(2, same);
+}
+
+void test_reseed_restarts_sequence() {
+  Pcg32 rng;
+  pcg32_seed(rng, 1234);
+  uint32_t first = pcg32_next(rng);
+  pcg32_next(rng);
+  pcg32_seed(rng, 1234);
+  TEST_ASSERT_EQUAL_UINT32(first, pcg32_next(rng));
+}
+
+void test_zero_seed_is_usable() {
+  Pcg32 rng;
+  pcg32_seed(rng, 0);
+  uint32_t x = pcg32_next(rng);
+  uint32_t y = pcg32_next(rng);
+  TEST_ASSERT_NOT_EQUAL(x, y);
+}
+
+void test_below_stays_in_range() {
+  Pcg32 rng;
+  pcg32_seed(rng, 99);
+  const uint32_t bounds[] = {1, 2, 3, 10, 8, 996, 1000};
+  for (uint32_t bound : bounds) {
+    for (int i = 0; i < 2000; i++) {
+      TEST_ASSERT_LESS_THAN(bound, pcg32_below(rng, bound));
+    }
+  }
+}
+
+// Games use % 3 colour picks and & 1 coin flips; both must be balanced
+void test_below_three_is_balanced() {
+  Pcg32 rng;
+  pcg32_seed(rng, 7);
+  int counts[3] = {0, 0, 0};
+  const int N = 30000;
+  for (int i = 0; i < N; i++) counts[pcg32_below(rng, 3)]++;
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_INT_WITHIN(N / 3 / 20, N / 3, counts[i]);  // Within 5%
+  }
+}
+
+void test_low_bit_is_balanced() {
+  Pcg32 rng;
+  pcg32_seed(rng, 8);
+  int ones = 0;
+  const int N = 20000;
+  for (int i = 0; i < N; i++) ones += pcg32_next(rng) & 1;
+  TEST_ASSERT_INT_WITHIN(N / 40, N / 2, ones);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_same_seed_same_sequence);
+  RUN_TEST(test_different_seeds_diverge);
+  RUN_TEST(test_reseed_restarts_sequence);
+  RUN_TEST(test_zero_seed_is_usable);
+  RUN_TEST(test_below_stays_in_range);
+  RUN_TEST(test_below_three_is_balanced);
+  RUN_TEST(test_low_bit_is_balanced);
+  return UNITY_END();
+}
@@ -0,0 +1,264 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <sys/stat.h>
+#include <sim.h>
+#include "../../src/config/led_config.h"
+#include "../../src/games/game_arena.h"
+#include "../../src/games/game_manager.h"
+#include "../../src/input/touch_input.h"
+#include "../../src/render/effect_sequencer.h"
+#include "../../src/games/game_04_flappy.h"
+
+// Benchmark: cost of every registered game's update() and render() over a
+// fixed number of game ticks under scripted input, at this build's NUM_LEDS
+// (the native_sim_* environments sweep strip length; entity pools scale
+// with it). Ticks are timed in batches, one clock pair per batch, and the
+// median batch is reported. Ticks spent in flash effects are counted
+// separately and not timed. Results are printed and written as JSON to
+// $GAME_BENCH_OUT or .pio/bench/game_bench_<NUM_LEDS>.json
+
+static constexpr uint32_t BENCH_TICKS = 20000;
+static constexpr uint32_t BENCH_BATCH = 100;
+static constexpr uint32_t MAX_BATCHES = BENCH_TICKS / BENCH_BATCH + 1;
+static constexpr uint32_t ENTROPY = 0xBE7C;
+static constexpr uint8_t FLAPPY = 4;
+
+typedef std::chrono::steady_clock Clock;
+
+// Heap allocations made through operator new (the firmware should make none)
+static uint64_t allocations = 0;
+
+void* operator new(size_t size) {
+  allocations++;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+struct GameBench {
+  uint8_t id;
+  const char* name;
+  uint16_t tickMs;
+  double nsPerTick;    // Median batch: input hand-off and update()
+  double nsPerRender;  // Median batch of render() calls
+  uint32_t batches;    // Batches timed
+  uint64_t allocs;
+  double allocsPerFrame;
+  uint32_t effectTicks;  // Ticks spent in a flash effect instead of the game
+};
+
+static GameBench results[16];
+static uint8_t resultCount = 0;
+
+// Scripted input: a random pad held for 1-10 ticks, then released
+static uint32_t scriptState = 1;
+static uint32_t scriptRand() {
+  scriptState ^= scriptState << 13;
+  scriptState ^= scriptState >> 17;
+  scriptState ^= scriptState << 5;
+  return scriptState;
+}
+
+static void setButton(ButtonState& b, bool down) {
+  b.justPressed = down && !b.pressed;
+  b.justReleased = !down && b.pressed;
+  b.pressed = down;
+}
+
+// FlappyBird dies within ticks under random input; flap towards the next
+// gap instead, so its numbers are the game's and not the game over flash's
+static InputState flappyPilot(InputState prev) {
+  const FlappyState& f = game_04_state();
+  int target = NUM_LEDS / 2;
+  int nearest = NUM_LEDS;
+  for (int i = 0; i < f.obstacles.size(); i++) {
+    if (f.obstacles[i].pos < nearest) {
+      nearest = f.obstacles[i].pos;
+      target = f.obstacles[i].gapTop;
+    }
+  }
+  // Where gravity alone takes the bird next tick
+  bool flap = f.birdPos + f.birdVel + 1 > target && !prev.action.pressed;
+  setButton(prev.left, false);
+  setButton(prev.right, false);
+  setButton(prev.action, flap);
+  setButton(prev.alt, false);
+  return prev;
+}
+
+static InputState scriptInput(InputState prev, uint32_t& holdLeft, uint8_t& pad) {
+  if (holdLeft == 0) {
+    uint32_t r = scriptRand();
+    pad = (r & 0x8) ? (uint8_t)(r & 0x3) : 0xFF;  // Half the time: nothing held
+    holdLeft = 1 + (r >> 8) % 10;
+  }
+  holdLeft--;
+  setButton(prev.left, pad == 0);
+  setButton(prev.right, pad == 1);
+  setButton(prev.action, pad == 2);
+  setButton(prev.alt, pad == 3);
+  return prev;
+}
+
+static double elapsedNs(Clock::time_point t0, Clock::time_point t1) {
+  return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+static double median(double* samples, uint32_t n) {
+  if (n == 0) {
+    return 0;
+  }
+  std::sort(samples, samples + n);
+  return n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+}
+
+static GameBench benchGame(uint8_t id) {
+  static double updateSamples[MAX_BATCHES];
+  static double renderSamples[MAX_BATCHES];
+  const GameInfo* game = game_manager_get_game_info(id);
+  sim_init(id, ENTROPY);
+  scriptState = 12345 + id;
+
+  InputState input = touch_input_get();
+  uint32_t holdLeft = 0;
+  uint8_t pad = 0xFF;
+  uint32_t ticks = 0;
+  uint32_t batches = 0;
+  uint32_t renderBatches = 0;
+  uint32_t effectTicks = 0;
+  uint64_t allocsBefore = allocations;
+
+  // A batch is BENCH_BATCH timed ticks; a game over pauses its clock until
+  // the effect ends (short strips rarely last a whole batch)
+  double batchNs = 0;
+  uint32_t batchTicks = 0;
+  while (ticks < BENCH_TICKS && effectTicks < BENCH_TICKS) {
+    // Game over flashes hold the game, as in game_manager_loop()
+    if (effect_sequencer_update(game->tickMs)) {
+      effectTicks++;
+      continue;
+    }
+
+    uint32_t n = 0;
+    auto t0 = Clock::now();
+    while (batchTicks + n < BENCH_BATCH && ticks + n < BENCH_TICKS) {
+      input = id == FLAPPY ? flappyPilot(input) : scriptInput(input, holdLeft, pad);
+      touch_input_set(input);
+      touch_input_tick(game->tickMs);
+      game->update();
+      n++;
+      // The tick that starts an effect hands it the strip
+      if (effect_sequencer_is_active()) {
+        break;
+      }
+    }
+    auto t1 = Clock::now();
+    ticks += n;
+    batchNs += elapsedNs(t0, t1);
+    batchTicks += n;
+    if (batchTicks < BENCH_BATCH) {
+      continue;
+    }
+    updateSamples[batches++] = batchNs / batchTicks;
+    batchNs = 0;
+    batchTicks = 0;
+
+    // render() redraws the current state; repeating it costs the same
+    if (!effect_sequencer_is_active()) {
+      t0 = Clock::now();
+      for (uint32_t r = 0; r < BENCH_BATCH; r++) {
+        game->render();
+      }
+      t1 = Clock::now();
+      renderSamples[renderBatches++] = elapsedNs(t0, t1) / BENCH_BATCH;
+    }
+  }
+
+  GameBench r;
+  r.id = id;
+  r.name = game->name;
+  r.tickMs = game->tickMs;
+  r.nsPerTick = median(updateSamples, batches);
+  r.nsPerRender = median(renderSamples, renderBatches);
+  r.batches = batches;
+  r.allocs = allocations - allocsBefore;
+  r.allocsPerFrame = (double)r.allocs / (ticks + effectTicks);
+  r.effectTicks = effectTicks;
+  return r;
+}
+
+static void writeResults() {
+  char path[128];
+  const char* out = getenv("GAME_BENCH_OUT");
+  if (out) {
+    snprintf(path, sizeof(path), "%s", out);
+  } else {
+    mkdir(".pio", 0755);
+    mkdir(".pio/bench", 0755);
+    snprintf(path, sizeof(path), ".pio/bench/game_bench_%u.json", (unsigned)NUM_LEDS);
+  }
+
+  FILE* f = fopen(path, "w");
+  if (!f) {
+    printf("game_bench: cannot write %s\n", path);
+    return;
+  }
+  fprintf(f, "{\n  \"numLeds\": %u,\n  \"ticks\": %u,\n  \"batchTicks\": %u,\n"
+             "  \"arenaBytes\": %u,\n  \"unsharedStateBytes\": %u,\n  \"games\": [\n",
+          (unsigned)NUM_LEDS, BENCH_TICKS, BENCH_BATCH,
+          (unsigned)game_arena_size(), (unsigned)game_arena_unshared_size());
+  for (uint8_t i = 0; i < resultCount; i++) {
+    const GameBench& r = results[i];
+    fprintf(f, "    {\"id\": %u, \"name\": \"%s\", \"tickMs\": %u, \"nsPerTick\": %.1f, "
+               "\"nsPerRender\": %.1f, \"batches\": %u, \"allocsPerFrame\": %.3f, \"effectTicks\": %u}%s\n",
+            r.id, r.name, r.tickMs, r.nsPerTick, r.nsPerRender, r.batches, r.allocsPerFrame, r.effectTicks,
+            i + 1 < resultCount ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+  fclose(f);
+  printf("game_bench: wrote %s\n", path);
+}
+
+void test_bench_all_games() {
+  resultCount = 0;
+
+  for (uint8_t id = 0; id < game_manager_get_game_count(); id++) {
+    GameBench r = benchGame(id);
+    results[resultCount++] = r;
+    printf("game_bench leds=%u game=%u name=\"%s\" ns_per_tick=%.1f ns_per_render=%.1f batches=%u allocs_per_frame=%.3f effect_ticks=%u\n",
+           (unsigned)NUM_LEDS, r.id, r.name, r.nsPerTick, r.nsPerRender, r.batches, r.allocsPerFrame, r.effectTicks);
+
+    // Games must not touch the heap
+    TEST_ASSERT_EQUAL_UINT64(0, r.allocs);
+    // The script must keep the game playing, not parked in effects
+    TEST_ASSERT_LESS_THAN(BENCH_TICKS, r.effectTicks);
+    TEST_ASSERT_TRUE_MESSAGE(r.nsPerTick > 0 && r.nsPerRender > 0, r.name);
+  }
+
+  printf("game_bench leds=%u arena_bytes=%u unshared_state_bytes=%u\n",
+         (unsigned)NUM_LEDS, (unsigned)game_arena_size(), (unsigned)game_arena_unshared_size());
+  writeResults();
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bench_all_games);
+  return UNITY_END();
+}
@@ -0,0 +1,110 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstring>
+#include <sim.h>
+#include "../../src/config/led_config.h"
+#include "../../src/render/frame_output.h"
+#include "../../src/render/led_output.h"
+
+// frame_output_show() on the real LED output stage, over a driver the test
+// holds busy: unchanged frames are skipped, changed ones sent, and a frame
+// deferred by a busy wire goes out at the next chance
+
+extern CRGB leds[];
+
+static uint8_t front[NUM_LEDS * 3];
+static uint8_t wire[NUM_LEDS * 3];
+static bool busy = false;
+static uint32_t transmits = 0;
+
+static void mockTransmit(const uint8_t* frame, uint16_t numLeds) {
+  memcpy(wire, frame, (size_t)numLeds * 3);
+  transmits++;
+}
+
+static bool mockIsBusy() {
+  return busy;
+}
+
+static const LedDriver MOCK_DRIVER = {mockTransmit, mockIsBusy};
+
+// Counters since the test's first frame
+static FrameOutputStats start;
+static FrameOutputStats stats() {
+  FrameOutputStats now = frame_output_get_stats();
+  return {now.sent - start.sent, now.skipped - start.skipped, now.deferred - start.deferred};
+}
+
+void test_unchanged_frame_skipped() {
+  TEST_ASSERT_TRUE(frame_output_show());
+  TEST_ASSERT_FALSE(frame_output_show());
+  TEST_ASSERT_FALSE(frame_output_show());
+
+  TEST_ASSERT_EQUAL(1, stats().sent);
+  TEST_ASSERT_EQUAL(2, stats().skipped);
+  TEST_ASSERT_EQUAL(1, transmits);
+  TEST_ASSERT_EQUAL(1, led_output_get_stats().framesSent);
+}
+
+void test_changed_frame_sent() {
+  frame_output_show();
+  leds[NUM_LEDS - 1] = CRGB(0, 0, 1);
+  TEST_ASSERT_TRUE(frame_output_show());
+
+  TEST_ASSERT_EQUAL(2, stats().sent);
+  TEST_ASSERT_EQUAL(0, stats().skipped);
+  TEST_ASSERT_EQUAL(1, wire[NUM_LEDS * 3 - 1]);
+}
+
+// A changed frame that finds the wire busy is not taken as sent: the same
+// frame goes out once the wire is free, and only then counts as unchanged
+void test_busy_frame_retried() {
+  frame_output_show();
+  leds[0] = CRGB(10, 20, 30);
+  busy = true;
+  TEST_ASSERT_FALSE(frame_output_show());
+  TEST_ASSERT_FALSE(frame_output_show());
+  TEST_ASSERT_EQUAL(2, stats().deferred);
+  TEST_ASSERT_EQUAL(0, stats().skipped);
+  TEST_ASSERT_EQUAL(2, led_output_get_stats().framesDeferred);
+  TEST_ASSERT_EQUAL(1, wire[0]);  // Still the frame before
+
+  busy = false;
+  TEST_ASSERT_TRUE(frame_output_show());
+  TEST_ASSERT_EQUAL(10, wire[0]);
+  TEST_ASSERT_FALSE(frame_output_show());
+
+  TEST_ASSERT_EQUAL(2, stats().sent);
+  TEST_ASSERT_EQUAL(1, stats().skipped);
+  TEST_ASSERT_EQUAL(2, transmits);
+}
+
+void test_invalidate_forces_send() {
+  frame_output_show();
+  frame_output_invalidate();
+  TEST_ASSERT_TRUE(frame_output_show());
+  TEST_ASSERT_EQUAL(2, stats().sent);
+}
+
+void setUp(void) {
+  sim_init(0, 1);
+  led_output_init_with_driver(front, NUM_LEDS, &MOCK_DRIVER);
+  busy = false;
+  transmits = 0;
+  memset(wire, 0, sizeof(wire));
+
+  // A frame the game has not shown, so the first show() always sends
+  fill_solid(leds, NUM_LEDS, CRGB(1, 2, 3));
+  start = frame_output_get_stats();
+}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_unchanged_frame_skipped);
+  RUN_TEST(test_changed_frame_sent);
+  RUN_TEST(test_busy_frame_retried);
+  RUN_TEST(test_invalidate_forces_send);
+  return UNITY_END();
+}
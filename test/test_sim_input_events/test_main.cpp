@@ -0,0 +1,242 @@
+#include <unity.h>
+#include <cstdint>
+#include <sim.h>
+#include "../../src/input/input_events.h"
+#include "../../src/input/input_recorder.h"
+#include "../../src/input/input_rle.h"
+#include "../../src/games/game_manager.h"
+#include "../../src/games/game_00_test.h"
+#include "../../src/games/game_08_pulse_warrior.h"
+
+// Tick-by-tick input delivery: the queue on its own, then through the
+// game manager's scheduler (counted from the input recording) and Pulse
+// Warrior's sub-tick judgement
+
+static constexpr uint32_t ENTROPY = 0xE7E7;
+static constexpr uint8_t PULSE_WARRIOR = 8;
+static constexpr uint16_t TICK = 50;
+
+static InputRecording recording;
+
+void test_edges_go_to_their_window() {
+  input_events_clear();
+  input_events_push(INPUT_LEFT, true, 1010);
+  input_events_push(INPUT_LEFT, false, 1060);
+  input_events_push(INPUT_ACTION, true, 1170);
+
+  InputState a = input_events_tick(1050, TICK);
+  TEST_ASSERT_TRUE(a.left.justPressed);
+  TEST_ASSERT_TRUE(a.left.pressed);
+  TEST_ASSERT_FALSE(a.left.justReleased);
+
+  InputState b = input_events_tick(1100, TICK);
+  TEST_ASSERT_FALSE(b.left.justPressed);
+  TEST_ASSERT_TRUE(b.left.justReleased);
+  TEST_ASSERT_FALSE(b.left.pressed);
+  TEST_ASSERT_FALSE(b.action.justPressed);
+
+  // Nothing in this window; the action press waits for its own
+  InputState c = input_events_tick(1150, TICK);
+  TEST_ASSERT_FALSE(c.action.justPressed);
+  InputState d = input_events_tick(1200, TICK);
+  TEST_ASSERT_TRUE(d.action.justPressed);
+  InputState e = input_events_tick(1250, TICK);
+  TEST_ASSERT_FALSE(e.action.justPressed);
+  TEST_ASSERT_TRUE(e.action.pressed);  // Still held
+}
+
+void test_press_phase() {
+  input_events_clear();
+  input_events_push(INPUT_RIGHT, true, 1001);
+  TEST_ASSERT_EQUAL(0, input_events_tick(1050, TICK).right.pressPhase);
+
+  input_events_push(INPUT_RIGHT, true, 1100);
+  TEST_ASSERT_EQUAL(INPUT_PRESS_PHASES - 1, input_events_tick(1100, TICK).right.pressPhase);
+
+  input_events_push(INPUT_RIGHT, true, 1125);
+  TEST_ASSERT_EQUAL(INPUT_PRESS_PHASES / 2 - 1, input_events_tick(1150, TICK).right.pressPhase);
+
+  // Each button keeps the phase of its own first press in the tick
+  input_events_push(INPUT_ALT, true, 1160);
+  input_events_push(INPUT_ALT, false, 1165);
+  input_events_push(INPUT_ACTION, true, 1170);
+  input_events_push(INPUT_ALT, true, 1195);
+  InputState both = input_events_tick(1200, TICK);
+  TEST_ASSERT_EQUAL(3, both.alt.pressPhase);
+  TEST_ASSERT_EQUAL(6, both.action.pressPhase);
+  TEST_ASSERT_EQUAL(0, both.left.pressPhase);
+
+  // Late edges (from ticks the scheduler dropped) count as the tick start
+  input_events_push(INPUT_ACTION, true, 1210);
+  InputState late = input_events_tick(1400, TICK);
+  TEST_ASSERT_TRUE(late.action.justPressed);
+  TEST_ASSERT_EQUAL(0, late.action.pressPhase);
+}
+
+// Recordings keep every button's phase, so replays judge timing the same
+void test_recorded_press_phases() {
+  InputState state = {};
+  state.left = {true, true, false, 2};
+  state.action = {true, true, false, INPUT_PRESS_PHASES - 1};
+  state.alt = {false, false, true, 0};
+  InputState back = input_recorder_unpack(input_recorder_pack(state));
+  TEST_ASSERT_EQUAL(2, back.left.pressPhase);
+  TEST_ASSERT_EQUAL(0, back.right.pressPhase);
+  TEST_ASSERT_EQUAL(INPUT_PRESS_PHASES - 1, back.action.pressPhase);
+  TEST_ASSERT_TRUE(back.action.justPressed);
+  TEST_ASSERT_TRUE(back.alt.justReleased);
+}
+
+void test_tap_within_one_tick() {
+  input_events_clear();
+  input_events_push(INPUT_ACTION, true, 1010);
+  input_events_push(INPUT_ACTION, false, 1020);
+  InputState tick = input_events_tick(1050, TICK);
+  TEST_ASSERT_TRUE(tick.action.justPressed);
+  TEST_ASSERT_TRUE(tick.action.justReleased);
+  TEST_ASSERT_TRUE(tick.action.pressed);
+  TEST_ASSERT_FALSE(input_events_tick(1100, TICK).action.pressed);
+}
+
+void test_skip_keeps_levels() {
+  input_events_clear();
+  input_events_push(INPUT_LEFT, true, 1010);
+  input_events_skip(1050);
+  InputState tick = input_events_tick(1100, TICK);
+  TEST_ASSERT_FALSE(tick.left.justPressed);
+  TEST_ASSERT_TRUE(tick.left.pressed);
+}
+
+void test_full_queue_counts_drops() {
+  input_events_clear();
+  uint32_t dropped = input_events_dropped();
+  for (uint32_t i = 0; i < INPUT_EVENT_QUEUE_SIZE + 3; i++) {
+    input_events_push(INPUT_LEFT, (i & 1) == 0, 1000 + i);
+  }
+  TEST_ASSERT_EQUAL(dropped + 3, input_events_dropped());
+  input_events_clear();
+}
+
+// Ticks of the current recording whose action justPressed bit is set
+static uint32_t actionPressTicks() {
+  input_recorder_export(recording);
+  InputRleReader reader;
+  input_rle_open(reader, recording.data, recording.length);
+  uint32_t count = 0;
+  uint32_t packed;
+  while (input_rle_next(reader, packed)) {
+    count += input_recorder_unpack(packed).action.justPressed;
+  }
+  return count;
+}
+
+static void tap(SimButton button, uint32_t holdMs) {
+  sim_set_button(button, true);
+  sim_run(holdMs);
+  sim_set_button(button, false);
+}
+
+void test_press_between_ticks_is_not_lost() {
+  sim_init(PULSE_WARRIOR, ENTROPY);
+  sim_run(TICK * 4 + 10);
+
+  // Down and up again well inside one tick: no tick runs meanwhile
+  tap(SIM_ACTION, 5);
+  sim_run(TICK * 4);
+  TEST_ASSERT_EQUAL(1, actionPressTicks());
+}
+
+void test_press_not_repeated_in_multi_tick_frame() {
+  sim_init(PULSE_WARRIOR, ENTROPY);
+  sim_run(TICK * 4 + 10);
+
+  sim_set_button(SIM_ACTION, true);
+  sim_frame();
+  sim_frame(TICK * 3);  // Three ticks in one frame
+  sim_set_button(SIM_ACTION, false);
+  sim_run(TICK * 2);
+  TEST_ASSERT_EQUAL(1, actionPressTicks());
+}
+
+// The Test game moves its LED on each press and auto-repeat
+void test_held_button_repeats() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  TestState& s = game_00_state();
+
+  s.ledPos = 0;
+  tap(SIM_RIGHT, 100);
+  sim_run(200);
+  TEST_ASSERT_EQUAL(1, s.ledPos);
+
+  // TOUCH_REPEAT_DELAY_MS, then every TOUCH_REPEAT_MS
+  s.ledPos = 0;
+  tap(SIM_RIGHT, 1000);
+  sim_run(200);
+  uint32_t repeats = (1000 - TOUCH_REPEAT_DELAY_MS) / TOUCH_REPEAT_MS;
+  TEST_ASSERT_INT_WITHIN(1, 1 + repeats, s.ledPos);
+}
+
+// Run until the tick in which the pulse reaches its target has just run;
+// with 1ms frames that tick ended now
+static void runToArrival() {
+  PulseWarriorState& s = game_08_state();
+  for (uint32_t i = 0; i < 5000; i++) {
+    sim_frame();
+    if (s.pulseActive && s.clockMs == s.arrivalMs) {
+      return;
+    }
+  }
+  TEST_FAIL_MESSAGE("no pulse arrived");
+}
+
+static uint32_t pulseScoreForPressAt(int32_t offsetMs) {
+  sim_init(PULSE_WARRIOR, ENTROPY);
+  sim_run(100);
+  runToArrival();
+
+  // Rewind to an earlier press by replaying the same run up to it
+  if (offsetMs < 0) {
+    uint32_t arrival = millis();
+    sim_init(PULSE_WARRIOR, ENTROPY);
+    sim_run(100);
+    sim_run(arrival + offsetMs - millis());
+  } else {
+    sim_run(offsetMs);
+  }
+  tap(SIM_ACTION, 5);
+  sim_run(200);
+  return game_08_state().score;
+}
+
+void test_pulse_judged_within_the_tick() {
+  // Judged on the press time, within TARGET_WINDOW_MS around the arrival,
+  // not on which tick saw the press
+  TEST_ASSERT_GREATER_THAN(0, pulseScoreForPressAt(-60));
+  TEST_ASSERT_GREATER_THAN(0, pulseScoreForPressAt(20));
+  // Late presses count to the window's edge, past the arrival tick's end
+  TEST_ASSERT_GREATER_THAN(0, pulseScoreForPressAt(60));
+  TEST_ASSERT_EQUAL(0, pulseScoreForPressAt(-100));
+  TEST_ASSERT_EQUAL(0, pulseScoreForPressAt(90));
+
+  // Closer is worth more
+  TEST_ASSERT_GREATER_THAN(pulseScoreForPressAt(-60), pulseScoreForPressAt(-5));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_edges_go_to_their_window);
+  RUN_TEST(test_press_phase);
+  RUN_TEST(test_recorded_press_phases);
+  RUN_TEST(test_tap_within_one_tick);
+  RUN_TEST(test_skip_keeps_levels);
+  RUN_TEST(test_full_queue_counts_drops);
+  RUN_TEST(test_press_between_ticks_is_not_lost);
+  RUN_TEST(test_press_not_repeated_in_multi_tick_frame);
+  RUN_TEST(test_held_button_repeats);
+  RUN_TEST(test_pulse_judged_within_the_tick);
+  return UNITY_END();
+}
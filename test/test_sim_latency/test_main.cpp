@@ -0,0 +1,149 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sim.h>
+#include "../../src/config/led_config.h"
+#include "../../src/games/game_manager.h"
+#include "../../src/input/touch_input.h"
+#include "../../src/render/effect_sequencer.h"
+#include "../../src/status/input_latency.h"
+
+// Touch-to-photon latency traces through the real pipeline (the native_sim
+// envs build with INPUT_LATENCY_TRACE). The simulated show() takes no
+// virtual time, so these latencies leave out the wire time
+// (led_frame_tx_us()); the rest is the same path as on the device.
+
+static constexpr uint32_t ENTROPY = 0x1A7E;
+
+static InputLatencySnapshot latency;
+
+static const InputLatencySnapshot& snapshot() {
+  input_latency_get(latency);
+  return latency;
+}
+
+// Let every trace in flight finish or time out
+static void settle() {
+  for (uint8_t b = 0; b < 4; b++) {
+    sim_set_button((SimButton)b, false);
+  }
+  sim_run(INPUT_LATENCY_TIMEOUT_MS + 100);
+}
+
+static uint32_t tickUs(uint8_t gameId) {
+  return game_manager_get_game_info(gameId)->tickMs * 1000u;
+}
+
+void test_press_reaches_strip_within_a_tick() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  CRGB before[NUM_LEDS];
+  memcpy(before, sim_strip(), sizeof(before));
+
+  // Test game: Action changes the dot's colour
+  sim_set_button(SIM_ACTION, true);
+  sim_run(100);
+  settle();
+  TEST_ASSERT_TRUE(memcmp(before, sim_strip(), sizeof(before)) != 0);
+
+  const InputLatencySnapshot& s = snapshot();
+  TEST_ASSERT_EQUAL(1, s.games[0].latency.total);
+  TEST_ASSERT_EQUAL(0, s.games[0].unanswered);
+  TEST_ASSERT_EQUAL(0, s.skipped);
+  // Waits at most for the tick covering it, one frame late
+  TEST_ASSERT_LESS_OR_EQUAL(tickUs(0) + SIM_FRAME_MS * 1000, s.games[0].latency.max);
+  TEST_ASSERT_EQUAL(1, s.toTick.total);
+  TEST_ASSERT_EQUAL(0, s.toShow.max);
+}
+
+void test_press_without_visible_change_is_unanswered() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+
+  // Walk the dot to the start of the strip, where Left does nothing
+  sim_set_button(SIM_LEFT, true);
+  sim_run(TOUCH_REPEAT_DELAY_MS + (NUM_LEDS / 2 + 2) * TOUCH_REPEAT_MS);
+  settle();
+  uint32_t answered = snapshot().games[0].latency.total;
+
+  sim_set_button(SIM_LEFT, true);
+  sim_run(100);
+  settle();
+  TEST_ASSERT_EQUAL(answered, snapshot().games[0].latency.total);
+  TEST_ASSERT_EQUAL(1, snapshot().games[0].unanswered);
+}
+
+void test_press_no_tick_consumes_is_skipped() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+
+  // Seen, then dropped by a restart before any tick covers it
+  sim_set_button(SIM_ALT, true);
+  hal_advance_ms(SIM_FRAME_MS);
+  touch_input_update();
+  game_manager_setup();
+  settle();
+  TEST_ASSERT_EQUAL(1, snapshot().skipped);
+  TEST_ASSERT_EQUAL(0, snapshot().games[0].latency.total);
+}
+
+static uint32_t scriptState = 1;
+static uint32_t scriptRand() {
+  scriptState ^= scriptState << 13;
+  scriptState ^= scriptState >> 17;
+  scriptState ^= scriptState << 5;
+  return scriptState;
+}
+
+// Every game under random taps: every press is accounted for, and the
+// distribution is printed per game
+void test_latency_per_game() {
+  for (uint8_t id = 0; id < game_manager_get_game_count(); id++) {
+    sim_init(id, ENTROPY);
+    scriptState = 11 + id;
+    uint32_t presses = 0;
+    for (uint32_t elapsed = 0; elapsed < 20000;) {
+      uint32_t pick = scriptRand();
+      sim_set_button((SimButton)(pick % 4), true);
+      uint32_t hold = 40 + scriptRand() % 160;
+      for (uint32_t i = 0; i < hold; i++) {
+        sim_frame();
+        InputState input = touch_input_get();
+        presses += input.left.justPressed + input.right.justPressed +
+                   input.action.justPressed + input.alt.justPressed;
+      }
+      sim_set_button((SimButton)(pick % 4), false);
+      uint32_t gap = 60 + scriptRand() % 400;
+      sim_run(gap);
+      elapsed += hold + gap;
+    }
+    settle();
+
+    const InputLatencySnapshot& s = snapshot();
+    const InputLatencyGame& g = s.games[id];
+    printf("latency leds=%u game=%u name=\"%s\" presses=%u answered=%u unanswered=%u skipped=%u "
+           "p50_us=%u p90_us=%u p99_us=%u max_us=%u tick_us=%u\n",
+           (unsigned)NUM_LEDS, id, game_manager_get_current_game_name(), (unsigned)presses,
+           (unsigned)g.latency.total, (unsigned)g.unanswered, (unsigned)s.skipped,
+           (unsigned)log_histogram_percentile(g.latency, 50), (unsigned)log_histogram_percentile(g.latency, 90),
+           (unsigned)log_histogram_percentile(g.latency, 99), (unsigned)g.latency.max, (unsigned)tickUs(id));
+
+    TEST_ASSERT_GREATER_THAN(0, presses);
+    TEST_ASSERT_EQUAL_MESSAGE(presses, g.latency.total + g.unanswered + s.skipped,
+                              game_manager_get_current_game_name());
+    TEST_ASSERT_GREATER_THAN_MESSAGE(0, g.latency.total, game_manager_get_current_game_name());
+  }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_press_reaches_strip_within_a_tick);
+  RUN_TEST(test_press_without_visible_change_is_unanswered);
+  RUN_TEST(test_press_no_tick_consumes_is_skipped);
+  RUN_TEST(test_latency_per_game);
+  return UNITY_END();
+}
@@ -0,0 +1,196 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sim.h>
+#include "../../src/config/led_config.h"
+#include "../../src/games/game_manager.h"
+#include "../../src/games/game_arena.h"
+#include "../../src/games/game_snapshot.h"
+#include "../../src/input/input_recorder.h"
+#include "../../src/render/effect_sequencer.h"
+
+// Suspend/resume through the real game manager: switching back restores
+// the exact state, the cache stays bounded, and a warm reboot resumes the
+// RTC checkpoint
+
+static constexpr uint32_t ENTROPY = 0x5EED;
+static constexpr uint32_t SNAPSHOT_MAX = 64 + GAME_SNAPSHOT_CACHE_BYTES;
+
+static uint8_t before[SNAPSHOT_MAX];
+static uint8_t after[SNAPSHOT_MAX];
+static InputRecording recording;
+
+static uint32_t scriptState = 1;
+static uint32_t scriptRand() {
+  scriptState ^= scriptState << 13;
+  scriptState ^= scriptState >> 17;
+  scriptState ^= scriptState << 5;
+  return scriptState;
+}
+
+// Random single-pad presses, then wait out any end-of-round effect so the
+// game can be suspended
+static void play(uint32_t durationMs, uint32_t scriptSeed) {
+  scriptState = scriptSeed;
+  uint32_t elapsed = 0;
+  while (elapsed < durationMs) {
+    uint32_t buttons = scriptRand();
+    uint32_t hold = 20 + scriptRand() % 280;
+    for (uint8_t b = 0; b < 4; b++) {
+      sim_set_button((SimButton)b, (buttons & 0x3) == b && (buttons & 0x4));
+    }
+    sim_run(hold);
+    elapsed += hold;
+  }
+  for (uint8_t b = 0; b < 4; b++) {
+    sim_set_button((SimButton)b, false);
+  }
+  while (effect_sequencer_is_active()) {
+    sim_frame();
+  }
+}
+
+static uint32_t capture(uint8_t* out) {
+  return game_snapshot_capture(game_manager_get_current_game(), 0, out, SNAPSHOT_MAX);
+}
+
+void test_switch_back_resumes_every_game() {
+  for (uint8_t id = 0; id < game_manager_get_game_count(); id++) {
+    uint8_t other = (id + 1) % game_manager_get_game_count();
+    sim_init(id, ENTROPY);
+    play(15000, 3 + id);
+    uint32_t length = capture(before);
+    TEST_ASSERT_GREATER_THAN(0, length);
+
+    game_manager_set_game(other);
+    TEST_ASSERT_TRUE_MESSAGE(game_snapshot_is_cached(id), game_manager_get_game_info(id)->name);
+    play(5000, 50 + id);
+
+    game_manager_set_game(id);
+    TEST_ASSERT_FALSE(game_snapshot_is_cached(id));
+
+    // Same state bytes, RNG position and seed as when it was left
+    TEST_ASSERT_EQUAL(length, capture(after));
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(before, after, length, game_manager_get_game_info(id)->name);
+
+    // A resumed run is not reproducible from its seed
+    input_recorder_export(recording);
+    TEST_ASSERT_TRUE(recording.truncated);
+    TEST_ASSERT_EQUAL(0, recording.ticks);
+  }
+}
+
+void test_cache_evicts_least_recent() {
+  sim_init(0, ENTROPY);
+  uint8_t count = game_manager_get_game_count();
+  for (uint8_t id = 1; id < count; id++) {
+    sim_run(200);
+    game_manager_set_game(id);
+    TEST_ASSERT_LESS_OR_EQUAL(GAME_SNAPSHOT_SLOTS, game_snapshot_cached_count());
+  }
+
+  // The game just left is always kept; the first ones are gone
+  TEST_ASSERT_TRUE(game_snapshot_is_cached(count - 2));
+  TEST_ASSERT_FALSE(game_snapshot_is_cached(0));
+  TEST_ASSERT_FALSE(game_snapshot_is_cached(1));
+}
+
+void test_fresh_setup_drops_checkpoint() {
+  sim_init(5, ENTROPY);
+  sim_run(GAME_SNAPSHOT_CHECKPOINT_MS + 100);
+
+  // Restarted from scratch: a reboot must not bring the old run back
+  game_manager_setup();
+  sim_reboot();
+  input_recorder_export(recording);
+  TEST_ASSERT_FALSE(recording.truncated);
+}
+
+void test_warm_reboot_resumes_checkpoint() {
+  // Pong plays itself: the ball keeps moving without input
+  sim_init(5, ENTROPY);
+  sim_run(2500);  // At least one checkpoint
+
+  // Write the latest state, as the next periodic checkpoint would
+  game_snapshot_checkpoint(5, 0);
+  uint32_t length = capture(before);
+
+  sim_reboot();
+  TEST_ASSERT_EQUAL(5, game_manager_get_current_game());
+  TEST_ASSERT_EQUAL(length, capture(after));
+  TEST_ASSERT_EQUAL_MEMORY(before, after, length);
+
+  // A power cycle loses RTC memory: fresh start
+  sim_init(5, ENTROPY);
+  input_recorder_export(recording);
+  TEST_ASSERT_FALSE(recording.truncated);
+}
+
+void test_periodic_checkpoint() {
+  sim_init(5, ENTROPY);
+  sim_run(GAME_SNAPSHOT_CHECKPOINT_MS / 2);
+
+  // Too early: the reboot starts fresh and records normally
+  sim_reboot();
+  input_recorder_export(recording);
+  TEST_ASSERT_FALSE(recording.truncated);
+
+  sim_run(GAME_SNAPSHOT_CHECKPOINT_MS + 100);
+  sim_reboot();
+  input_recorder_export(recording);
+  TEST_ASSERT_TRUE(recording.truncated);
+}
+
+void test_rejects_foreign_snapshots() {
+  sim_init(9, ENTROPY);
+  play(5000, 9);
+  uint32_t length = capture(before);
+  uint32_t score;
+
+  TEST_ASSERT_TRUE(game_snapshot_apply(9, before, length, score));
+  TEST_ASSERT_FALSE(game_snapshot_apply(8, before, length, score));
+  TEST_ASSERT_FALSE(game_snapshot_apply(9, before, length - 1, score));
+  TEST_ASSERT_FALSE(game_snapshot_apply(9, before, 8, score));
+
+  memcpy(after, before, length);
+  after[length - 1] ^= 0x01;  // Payload corruption
+  TEST_ASSERT_FALSE(game_snapshot_apply(9, after, length, score));
+
+  memcpy(after, before, length);
+  after[4] ^= 0x01;  // Version
+  TEST_ASSERT_FALSE(game_snapshot_apply(9, after, length, score));
+}
+
+// Packed sizes after a long session, against the raw state
+void test_snapshot_sizes() {
+  uint32_t total = 0;
+  for (uint8_t id = 0; id < game_manager_get_game_count(); id++) {
+    sim_init(id, ENTROPY);
+    play(30000, 77 + id);
+    uint32_t length = capture(before);
+    total += length;
+    printf("snapshot leds=%u game=%u name=\"%s\" state_bytes=%u snapshot_bytes=%u\n",
+           (unsigned)NUM_LEDS, id, game_manager_get_current_game_name(),
+           (unsigned)game_arena_state_size(id), (unsigned)length);
+    TEST_ASSERT_GREATER_THAN(0, length);
+    TEST_ASSERT_LESS_OR_EQUAL(GAME_SNAPSHOT_CACHE_BYTES, length);
+  }
+  printf("snapshot leds=%u total_bytes=%u cache_bytes=%u\n",
+         (unsigned)NUM_LEDS, (unsigned)total, (unsigned)GAME_SNAPSHOT_CACHE_BYTES);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_switch_back_resumes_every_game);
+  RUN_TEST(test_cache_evicts_least_recent);
+  RUN_TEST(test_fresh_setup_drops_checkpoint);
+  RUN_TEST(test_warm_reboot_resumes_checkpoint);
+  RUN_TEST(test_periodic_checkpoint);
+  RUN_TEST(test_rejects_foreign_snapshots);
+  RUN_TEST(test_snapshot_sizes);
+  return UNITY_END();
+}
@@ -0,0 +1,115 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstring>
+#include <hal_native.h>
+#include "../../src/status/status_monitor.h"
+
+// Status change tracking: the game task calls the update_* functions every
+// frame whether or not anything moved, and only real changes may publish
+
+static GameStatus status;
+static LEDColor frame[NUM_LEDS];
+
+static const GameStatus& published() {
+  status_monitor_get(status);
+  return status;
+}
+
+// One loop() iteration's worth of updates with nothing new
+static void sameFrame() {
+  status_monitor_update_input(false, false, false, false);
+  status_monitor_update_leds(frame, NUM_LEDS);
+  status_monitor_update_stalls(0, 0);
+  status_monitor_update_score(0);
+  status_monitor_publish();
+}
+
+void test_init_publishes_every_field() {
+  const GameStatus& s = published();
+  TEST_ASSERT_EQUAL(status_monitor_version(), s.version);
+  TEST_ASSERT_EQUAL(STATUS_ALL_FIELDS, status_changed_since(s, s.version - 1));
+  TEST_ASSERT_EQUAL(0, status_changed_since(s, s.version));
+}
+
+void test_unchanged_frames_do_not_publish() {
+  uint32_t version = status_monitor_version();
+  uint32_t timestamp = published().timestamp;
+  for (int i = 0; i < 10; i++) {
+    hal_advance_ms(16);
+    sameFrame();
+  }
+  TEST_ASSERT_EQUAL(version, status_monitor_version());
+  TEST_ASSERT_EQUAL(timestamp, published().timestamp);
+}
+
+void test_led_change_marks_only_leds() {
+  uint32_t version = status_monitor_version();
+  frame[NUM_LEDS - 1] = {255, 0, 0};
+  hal_advance_ms(16);
+  sameFrame();
+
+  const GameStatus& s = published();
+  TEST_ASSERT_EQUAL(version + 1, s.version);
+  TEST_ASSERT_EQUAL(STATUS_BIT(STATUS_FIELD_LEDS), status_changed_since(s, version));
+  TEST_ASSERT_EQUAL(255, s.leds[NUM_LEDS - 1].r);
+}
+
+void test_changes_accumulate_across_versions() {
+  uint32_t version = status_monitor_version();
+  status_monitor_update_score(10);
+  status_monitor_publish();
+  status_monitor_update_state(GAME_STATE_GAME_OVER);
+  status_monitor_update_input(true, false, false, false);
+  status_monitor_publish();
+
+  const GameStatus& s = published();
+  TEST_ASSERT_EQUAL(version + 2, s.version);
+  TEST_ASSERT_EQUAL(STATUS_BIT(STATUS_FIELD_SCORE) | STATUS_BIT(STATUS_FIELD_STATE) |
+                    STATUS_BIT(STATUS_FIELD_INPUT),
+                    status_changed_since(s, version));
+  TEST_ASSERT_EQUAL(STATUS_BIT(STATUS_FIELD_STATE) | STATUS_BIT(STATUS_FIELD_INPUT),
+                    status_changed_since(s, version + 1));
+  // A consumer holding a version from before a reboot gets everything
+  TEST_ASSERT_EQUAL(STATUS_ALL_FIELDS, status_changed_since(s, s.version + 1));
+}
+
+void test_touch_changes_are_rate_limited() {
+  hal_advance_ms(STATUS_TOUCH_REFRESH_MS);
+  status_monitor_update_touch(0, 900, 1000, 650);
+  status_monitor_publish();
+  uint32_t version = status_monitor_version();
+
+  // Noisy readings inside the refresh interval do not publish...
+  for (uint16_t i = 0; i < 10; i++) {
+    hal_advance_ms(16);
+    status_monitor_update_touch(0, 901 + i, 1000, 650);
+    status_monitor_publish();
+  }
+  TEST_ASSERT_EQUAL(version, status_monitor_version());
+
+  // ...the next one after it carries the latest reading
+  hal_advance_ms(STATUS_TOUCH_REFRESH_MS);
+  status_monitor_update_touch(0, 950, 1000, 650);
+  status_monitor_publish();
+  const GameStatus& s = published();
+  TEST_ASSERT_EQUAL(version + 1, s.version);
+  TEST_ASSERT_EQUAL(STATUS_BIT(STATUS_FIELD_TOUCH), status_changed_since(s, version));
+  TEST_ASSERT_EQUAL(950, s.touch[0].raw);
+}
+
+void setUp(void) {
+  memset(frame, 0, sizeof(frame));
+  status_monitor_init();
+}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_init_publishes_every_field);
+  RUN_TEST(test_unchanged_frames_do_not_publish);
+  RUN_TEST(test_led_change_marks_only_leds);
+  RUN_TEST(test_changes_accumulate_across_versions);
+  RUN_TEST(test_touch_changes_are_rate_limited);
+  return UNITY_END();
+}
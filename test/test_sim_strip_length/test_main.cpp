@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <cstdint>
+#include <sim.h>
+#include "../../src/config/led_config.h"
+#include "../../src/games/game_manager.h"
+#include "../../src/render/effect_sequencer.h"
+#include "../../src/games/game_01_pacman.h"
+#include "../../src/games/game_02_lava_run.h"
+#include "../../src/games/game_03_lava_stealth.h"
+#include "../../src/games/game_04_flappy.h"
+#include "../../src/games/game_05_pong.h"
+#include "../../src/games/game_08_pulse_warrior.h"
+#include "../../src/games/game_09_color_runner.h"
+#include "../../src/games/game_10_splatoon.h"
+
+// Every game's layout on the strip this build is for: the native_sim
+// environments run this at 8, 60, 300 and 1000 LEDs (NUM_LEDS), through
+// the real setup/update/render and the frame sent to the strip
+
+static constexpr uint32_t ENTROPY = 0x57A1;
+
+static bool lit(int pos) {
+  const CRGB& c = sim_strip()[pos];
+  return c.r || c.g || c.b;
+}
+
+static bool isColor(int pos, const CRGB& color) {
+  const CRGB& c = sim_strip()[pos];
+  return c.r == color.r && c.g == color.g && c.b == color.b;
+}
+
+// The strip shows the game's current state once a tick has rendered it:
+// not while an effect owns the strip, nor in the tick after one ends
+static uint32_t freshAfterMs = 0;
+static bool fresh() {
+  uint16_t tickMs = game_manager_get_game_info(game_manager_get_current_game())->tickMs;
+  if (effect_sequencer_is_active()) {
+    freshAfterMs = millis() + tickMs;
+    return false;
+  }
+  return (int32_t)(millis() - freshAfterMs) > 0;
+}
+
+static void start(uint8_t gameId) {
+  sim_init(gameId, ENTROPY);
+  freshAfterMs = millis() + game_manager_get_game_info(gameId)->tickMs;
+  while (!fresh()) {
+    sim_frame();
+  }
+}
+
+// Press a random pad for a random 20-300ms, repeatedly, calling check
+// after every frame that shows the current state
+static uint32_t scriptState = 1;
+static uint32_t scriptRand() {
+  scriptState ^= scriptState << 13;
+  scriptState ^= scriptState >> 17;
+  scriptState ^= scriptState << 5;
+  return scriptState;
+}
+
+template <typename Check>
+static void mash(uint32_t durationMs, uint32_t seed, Check check) {
+  scriptState = seed;
+  for (uint32_t elapsed = 0; elapsed < durationMs;) {
+    uint32_t pick = scriptRand();
+    uint32_t hold = 20 + scriptRand() % 280;
+    sim_set_button((SimButton)(pick % 4), true);
+    for (uint32_t i = 0; i < hold; i++) {
+      sim_frame();
+      if (fresh()) {
+        check();
+      }
+    }
+    sim_set_button((SimButton)(pick % 4), false);
+    elapsed += hold;
+  }
+}
+
+// Position a game draws its player (or ball, or target) at
+struct PlayerProbe {
+  uint8_t gameId;
+  int (*pos)();
+};
+
+static const PlayerProbe PROBES[] = {
+  {1, [] { return game_01_state().pacmanPos; }},
+  {2, [] { return game_02_state().playerPos; }},
+  {3, [] { return game_03_state().playerPos; }},
+  {4, [] { return game_04_state().birdPos; }},
+  {5, [] { return game_05_state().ballPos; }},
+  {8, [] { return game_08_state().targetPos; }},
+  {9, [] { return game_09_state().playerPos; }},
+  {10, [] { return game_10_state().playerPos; }},
+};
+
+void test_every_game_draws() {
+  for (uint8_t id = 0; id < game_manager_get_game_count(); id++) {
+    start(id);
+    bool any = false;
+    for (int i = 0; i < NUM_LEDS; i++) {
+      any |= lit(i);
+    }
+    TEST_ASSERT_TRUE_MESSAGE(any, game_manager_get_current_game_name());
+  }
+}
+
+// Under play, the player stays on the strip and is drawn where it is
+void test_players_stay_on_the_strip() {
+  for (const PlayerProbe& probe : PROBES) {
+    start(probe.gameId);
+    mash(10000, 7 + probe.gameId, [&] {
+      int pos = probe.pos();
+      TEST_ASSERT_TRUE_MESSAGE(pos >= 0 && pos < NUM_LEDS, game_manager_get_current_game_name());
+      TEST_ASSERT_TRUE_MESSAGE(lit(pos), game_manager_get_current_game_name());
+    });
+  }
+}
+
+// Lava Run / Lava Stealth: lava never erupts on the start or goal LED, and
+// the goal is the strip's last LED
+void test_lava_spares_start_and_goal() {
+  for (uint8_t id = 2; id <= 3; id++) {
+    start(id);
+    for (uint32_t i = 0; i < 10000 || !fresh(); i++) {
+      sim_frame();
+      const bool* lava = id == 2 ? game_02_state().lavaActive : game_03_state().lavaActive;
+      TEST_ASSERT_FALSE(lava[0]);
+      TEST_ASSERT_FALSE(lava[NUM_LEDS - 1]);
+    }
+    TEST_ASSERT_EQUAL(NUM_LEDS - 1, id == 2 ? game_02_state().targetPos : game_03_state().targetPos);
+    TEST_ASSERT_TRUE(isColor(NUM_LEDS - 1, CRGB::Blue));
+  }
+}
+
+// Pong: paddles on the strip's ends, ball in between
+void test_pong_court_spans_the_strip() {
+  start(5);
+  TEST_ASSERT_TRUE(isColor(0, CRGB::Green));
+  TEST_ASSERT_TRUE(isColor(NUM_LEDS - 1, CRGB::Red));
+  int ball = game_05_state().ballPos;
+  TEST_ASSERT_TRUE(ball > 0 && ball < NUM_LEDS - 1);
+  TEST_ASSERT_TRUE(isColor(ball, CRGB::White));
+}
+
+// RGB Guardian 1/2: the defender sits in the middle of the strip
+void test_guardian_defender_centered() {
+  for (uint8_t id = 6; id <= 7; id++) {
+    start(id);
+    TEST_ASSERT_TRUE_MESSAGE(lit(NUM_LEDS / 2 - 1), game_manager_get_current_game_name());
+  }
+}
+
+// Pacman: walking off either end wraps to the other
+void test_pacman_wraps() {
+  start(1);
+  PacmanState& s = game_01_state();
+  int before = s.pacmanPos;
+  bool wrapped = false;
+  sim_set_button(SIM_LEFT, true);
+  for (uint32_t i = 0; i < 400000 && !wrapped; i++) {
+    sim_frame();
+    if (effect_sequencer_is_active()) {
+      break;  // Caught by the ghost first (not with this entropy)
+    }
+    wrapped = s.pacmanPos > before;
+    before = s.pacmanPos;
+  }
+  sim_set_button(SIM_LEFT, false);
+  TEST_ASSERT_TRUE(wrapped);
+  TEST_ASSERT_EQUAL(NUM_LEDS - 1, s.pacmanPos);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_every_game_draws);
+  RUN_TEST(test_players_stay_on_the_strip);
+  RUN_TEST(test_lava_spares_start_and_goal);
+  RUN_TEST(test_pong_court_spans_the_strip);
+  RUN_TEST(test_guardian_defender_centered);
+  RUN_TEST(test_pacman_wraps);
+  return UNITY_END();
+}
@@ -0,0 +1,267 @@
+#include <unity.h>
+#include <cstdint>
+#include <sim.h>
+#include <hal_native.h>
+#include "../../src/input/touch_input.h"
+
+// Touch sensing through the virtual pads, in whichever mode the build
+// selects (TOUCH_USE_INTERRUPTS): native_sim polls, native_sim_touch_irq
+// runs the interrupt-driven path against the virtual touch FSM
+
+static constexpr uint32_t ENTROPY = 0x7A9;
+
+// Live state as of the last touch_input_update() (game ticks see it later,
+// through the input event queue)
+static ButtonState live(SimButton button) {
+  InputState input = touch_input_get();
+  const ButtonState buttons[] = {input.left, input.right, input.action, input.alt};
+  return buttons[button];
+}
+
+// Long enough for one FSM measurement (TOUCH_SLEEP_CYCLES at 150kHz)
+static constexpr uint32_t MEASURE_MS = 6;
+
+void test_press_and_release() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  sim_set_button(SIM_ACTION, true);
+  sim_frame(MEASURE_MS);
+  TEST_ASSERT_TRUE(live(SIM_ACTION).justPressed);
+  TEST_ASSERT_FALSE(live(SIM_LEFT).pressed);
+
+  sim_run(200);
+  sim_set_button(SIM_ACTION, false);
+  sim_run(TOUCH_RELEASE_MS + TOUCH_DEBOUNCE_MS + SIM_FRAME_MS);
+
+  // Released: no further presses however long we wait
+  for (uint8_t i = 0; i < 20; i++) {
+    sim_frame();
+    TEST_ASSERT_FALSE(live(SIM_ACTION).pressed);
+  }
+}
+
+void test_each_pad_maps_to_its_button() {
+  sim_init(0, ENTROPY);
+  for (uint8_t b = 0; b < 4; b++) {
+    sim_run(100);
+    sim_set_button((SimButton)b, true);
+    sim_frame(MEASURE_MS);
+    InputState input = touch_input_get();
+    TEST_ASSERT_EQUAL(b == SIM_LEFT, input.left.justPressed);
+    TEST_ASSERT_EQUAL(b == SIM_RIGHT, input.right.justPressed);
+    TEST_ASSERT_EQUAL(b == SIM_ACTION, input.action.justPressed);
+    TEST_ASSERT_EQUAL(b == SIM_ALT, input.alt.justPressed);
+    sim_set_button((SimButton)b, false);
+  }
+}
+
+void test_held_pad_presses_once() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  sim_set_button(SIM_LEFT, true);
+  uint32_t presses = 0;
+  for (uint32_t i = 0; i < 1000; i++) {
+    sim_frame();
+    presses += live(SIM_LEFT).justPressed;
+    if (i >= MEASURE_MS) {
+      TEST_ASSERT_TRUE(live(SIM_LEFT).pressed);
+    }
+  }
+  TEST_ASSERT_EQUAL(1, presses);
+}
+
+#if !TOUCH_USE_INTERRUPTS
+// A reading hovering around the threshold does not flicker
+void test_hysteresis() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  sim_set_button(SIM_ALT, true);
+  sim_frame();
+  uint32_t edges = 0;
+  TouchPadReading pad = touch_input_get_pad(INPUT_ALT);
+  uint16_t releaseLevel = pad.baseline - pad.baseline * TOUCH_RELEASE_PERCENT / 100;
+  for (uint32_t i = 0; i < 500; i++) {
+    // Noise that crosses the press threshold but not the release level
+    uint16_t value = pad.threshold - 3 + (i * 7) % (releaseLevel - pad.threshold + 3);
+    hal_set_touch(TOUCH_PIN_ALT, value);
+    sim_frame();
+    edges += live(SIM_ALT).justPressed + live(SIM_ALT).justReleased;
+  }
+  TEST_ASSERT_EQUAL(0, edges);
+  TEST_ASSERT_TRUE(live(SIM_ALT).pressed);
+}
+#endif
+
+void test_touch_read_calls() {
+  sim_init(0, ENTROPY);
+  uint32_t before = hal_touch_read_count();
+  for (uint8_t i = 0; i < 60; i++) {
+    sim_set_button(SIM_LEFT, i < 30);
+    sim_frame();
+  }
+#if TOUCH_USE_INTERRUPTS
+  // Only the baselines' drift samples, one pad at a time
+  TEST_ASSERT_LESS_OR_EQUAL(before + 60 / (TOUCH_BASELINE_SAMPLE_MS / 4) + 1, hal_touch_read_count());
+#else
+  // One blocking measurement per pad per frame
+  TEST_ASSERT_EQUAL(before + 60 * 4, hal_touch_read_count());
+#endif
+}
+
+// A tap that starts and ends within one slow frame
+void test_tap_during_stalled_frame() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  sim_set_button(SIM_RIGHT, true);
+  hal_advance_ms(12);
+  sim_set_button(SIM_RIGHT, false);
+  sim_frame(100);
+#if TOUCH_USE_INTERRUPTS
+  TEST_ASSERT_TRUE(live(SIM_RIGHT).justPressed);
+  sim_run(TOUCH_RELEASE_MS + TOUCH_DEBOUNCE_MS + SIM_FRAME_MS);
+  TEST_ASSERT_FALSE(live(SIM_RIGHT).pressed);
+#else
+  // Polling only sees the pad as it is at update time
+  TEST_ASSERT_FALSE(live(SIM_RIGHT).pressed);
+#endif
+}
+
+void test_startup_calibration() {
+  sim_init(0, ENTROPY);
+  TouchPadReading pad = touch_input_get_pad(INPUT_LEFT);
+  TEST_ASSERT_EQUAL(HAL_TOUCH_RELEASED, pad.baseline);
+  TEST_ASSERT_EQUAL(HAL_TOUCH_RELEASED - HAL_TOUCH_RELEASED * TOUCH_PRESS_PERCENT / 100, pad.threshold);
+
+  // A pad wired with a lower untouched reading gets its own threshold
+  hal_set_touch(TOUCH_PIN_LEFT, 50);
+  touch_input_init();
+  pad = touch_input_get_pad(INPUT_LEFT);
+  TEST_ASSERT_EQUAL(50, pad.baseline);
+  TEST_ASSERT_EQUAL(HAL_TOUCH_RELEASED, touch_input_get_pad(INPUT_RIGHT).baseline);
+
+  sim_run(100);
+  hal_set_touch(TOUCH_PIN_LEFT, 35);  // Pressed for a fixed threshold of 40
+  sim_frame(MEASURE_MS);
+  TEST_ASSERT_FALSE(live(SIM_LEFT).pressed);
+  hal_set_touch(TOUCH_PIN_LEFT, 20);
+  sim_frame(MEASURE_MS);
+  TEST_ASSERT_TRUE(live(SIM_LEFT).justPressed);
+}
+
+#if TOUCH_DRIFT_COMPENSATION
+// Humidity slowly pulls the untouched reading down past where a fixed
+// threshold would see a phantom press; the baseline follows it
+void test_drift_compensation() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  uint32_t presses = 0;
+  for (uint16_t value = HAL_TOUCH_RELEASED; value >= 30; value--) {
+    hal_set_touch(TOUCH_PIN_ACTION, value);
+    for (uint32_t i = 0; i < 400; i++) {
+      sim_frame();
+      presses += live(SIM_ACTION).justPressed;
+    }
+  }
+  TEST_ASSERT_EQUAL(0, presses);
+  sim_run(TOUCH_BASELINE_SAMPLE_MS * (1u << TOUCH_BASELINE_SHIFT) * 6);
+  TEST_ASSERT_INT_WITHIN(1, 30, touch_input_get_pad(INPUT_ACTION).baseline);
+
+  // A real touch still presses, and a hold does not move the baseline
+  uint16_t baseline = touch_input_get_pad(INPUT_ACTION).baseline;
+  sim_set_button(SIM_ACTION, true);
+  sim_frame(MEASURE_MS);
+  TEST_ASSERT_TRUE(live(SIM_ACTION).justPressed);
+  sim_run(10000);
+  TEST_ASSERT_TRUE(live(SIM_ACTION).pressed);
+  TEST_ASSERT_EQUAL(baseline, touch_input_get_pad(INPUT_ACTION).baseline);
+
+  hal_set_touch(TOUCH_PIN_ACTION, 30);
+  sim_run(TOUCH_RELEASE_MS + TOUCH_DEBOUNCE_MS + MEASURE_MS);
+  TEST_ASSERT_FALSE(live(SIM_ACTION).pressed);
+}
+
+// A pad touched during boot calibrates too low, then recovers on release
+void test_touched_at_boot_recovers() {
+  sim_init(0, ENTROPY);
+  hal_set_touch(TOUCH_PIN_RIGHT, HAL_TOUCH_PRESSED);
+  touch_input_init();
+  hal_set_touch(TOUCH_PIN_RIGHT, HAL_TOUCH_RELEASED);
+  sim_run(TOUCH_BASELINE_SAMPLE_MS * (1u << TOUCH_BASELINE_SHIFT) * 6);
+  TEST_ASSERT_INT_WITHIN(1, HAL_TOUCH_RELEASED, touch_input_get_pad(INPUT_RIGHT).baseline);
+
+  sim_set_button(SIM_RIGHT, true);
+  sim_frame(MEASURE_MS);
+  TEST_ASSERT_TRUE(live(SIM_RIGHT).justPressed);
+}
+#endif
+
+#if TOUCH_USE_INTERRUPTS
+
+void test_injected_edge() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  hal_touch_interrupt(TOUCH_PIN_ALT);
+  sim_frame();
+  TEST_ASSERT_TRUE(live(SIM_ALT).justPressed);
+
+  // No further interrupts: released once the pad has been quiet
+  sim_run(TOUCH_RELEASE_MS + TOUCH_DEBOUNCE_MS + SIM_FRAME_MS);
+  TEST_ASSERT_FALSE(live(SIM_ALT).pressed);
+}
+
+void test_held_pad_queues_one_edge() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  uint32_t dropped = touch_input_dropped_edges();
+
+  // The FSM interrupts every measurement; only the first one is an edge
+  sim_set_button(SIM_LEFT, true);
+  hal_advance_ms(1000);
+  sim_frame(MEASURE_MS);
+  TEST_ASSERT_TRUE(live(SIM_LEFT).justPressed);
+  TEST_ASSERT_EQUAL(dropped, touch_input_dropped_edges());
+}
+
+void test_edge_queue_overflow() {
+  sim_init(0, ENTROPY);
+  sim_run(100);
+  uint32_t dropped = touch_input_dropped_edges();
+
+  // Separate taps with no update to drain them
+  for (uint8_t i = 0; i < TOUCH_EDGE_QUEUE_SIZE + 4; i++) {
+    hal_touch_interrupt(TOUCH_PIN_ACTION);
+    hal_advance_ms(TOUCH_RELEASE_MS + 5);
+  }
+  TEST_ASSERT_EQUAL(dropped + 4, touch_input_dropped_edges());
+
+  sim_frame();
+  TEST_ASSERT_TRUE(live(SIM_ACTION).justPressed);
+}
+
+#endif
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_press_and_release);
+  RUN_TEST(test_each_pad_maps_to_its_button);
+  RUN_TEST(test_held_pad_presses_once);
+#if !TOUCH_USE_INTERRUPTS
+  RUN_TEST(test_hysteresis);
+#endif
+  RUN_TEST(test_touch_read_calls);
+  RUN_TEST(test_tap_during_stalled_frame);
+  RUN_TEST(test_startup_calibration);
+#if TOUCH_DRIFT_COMPENSATION
+  RUN_TEST(test_drift_compensation);
+  RUN_TEST(test_touched_at_boot_recovers);
+#endif
+#if TOUCH_USE_INTERRUPTS
+  RUN_TEST(test_injected_edge);
+  RUN_TEST(test_held_pad_queues_one_edge);
+  RUN_TEST(test_edge_queue_overflow);
+#endif
+  return UNITY_END();
+}
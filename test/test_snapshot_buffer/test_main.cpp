@@ -0,0 +1,103 @@
+#include <unity.h>
+#include <cstdint>
+#include <cstring>
+#include "../../src/status/snapshot_buffer.h"
+
+// Test lock-free status/LED handoff between the game and network tasks
+
+struct Frame {
+  uint32_t score;
+  uint8_t leds[8][3];
+};
+
+static SnapshotBuffer<Frame> buffer;
+
+static void publishScore(uint32_t score) {
+  Frame& back = buffer.back();
+  back.score = score;
+  memset(back.leds, (int)(score & 0xFF), sizeof(back.leds));
+  buffer.publish();
+}
+
+// Test reader sees nothing new until publish
+void test_read_before_publish_is_initial() {
+  Frame out;
+  buffer.read(out);
+  TEST_ASSERT_EQUAL(0, out.score);
+}
+
+void test_read_after_publish() {
+  publishScore(42);
+  Frame out;
+  buffer.read(out);
+  TEST_ASSERT_EQUAL(42, out.score);
+  TEST_ASSERT_EQUAL(42, out.leds[7][2]);
+}
+
+// Test writing the back slot never disturbs the published snapshot
+void test_back_slot_is_not_published_slot() {
+  publishScore(1);
+  Frame& back = buffer.back();
+  back.score = 999;  // Writer mid-frame, not yet published
+
+  Frame out;
+  buffer.read(out);
+  TEST_ASSERT_EQUAL(1, out.score);
+}
+
+void test_back_slot_alternates() {
+  Frame* first = &buffer.back();
+  buffer.publish();
+  Frame* second = &buffer.back();
+  buffer.publish();
+  TEST_ASSERT_TRUE(first != second);
+  TEST_ASSERT_TRUE(first == &buffer.back());
+}
+
+// Test latest of several publishes wins
+void test_latest_publish_wins() {
+  for (uint32_t i = 1; i <= 10; i++) {
+    publishScore(i);
+  }
+  Frame out;
+  buffer.read(out);
+  TEST_ASSERT_EQUAL(10, out.score);
+  TEST_ASSERT_EQUAL(10, out.leds[0][0]);
+}
+
+// Test view() runs on the published slot and repeats a run the writer
+// published during
+void test_view_retries_after_publish() {
+  publishScore(5);
+  int runs = 0;
+  uint32_t seen = 0;
+  buffer.view([&](const Frame& f) {
+    if (runs++ == 0) {
+      publishScore(6);  // Writer publishes mid-read
+    }
+    seen = f.score;
+  });
+  TEST_ASSERT_EQUAL(2, runs);
+  TEST_ASSERT_EQUAL(6, seen);
+}
+
+void setUp(void) {
+  memset(buffer.slots, 0, sizeof(buffer.slots));
+  buffer.seq.store(0);
+}
+
+void tearDown(void) {
+}
+
+int main() {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_read_before_publish_is_initial);
+  RUN_TEST(test_read_after_publish);
+  RUN_TEST(test_back_slot_is_not_published_slot);
+  RUN_TEST(test_back_slot_alternates);
+  RUN_TEST(test_latest_publish_wins);
+  RUN_TEST(test_view_retries_after_publish);
+
+  return UNITY_END();
+}
@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/input/spsc_queue.h"
+
+// Test the lock-free queue that carries touch edges out of interrupts
+
+struct Event {
+  uint8_t id;
+  uint32_t timeMs;
+};
+
+void test_starts_empty() {
+  SpscQueue<Event, 4> queue;
+  Event e;
+  TEST_ASSERT_TRUE(queue.empty());
+  TEST_ASSERT_FALSE(queue.pop(e));
+  TEST_ASSERT_EQUAL(0, queue.dropped.load());
+}
+
+void test_fifo_order() {
+  SpscQueue<Event, 8> queue;
+  for (uint8_t i = 0; i < 5; i++) {
+    TEST_ASSERT_TRUE(queue.push({i, 100u + i}));
+  }
+  TEST_ASSERT_EQUAL(5, queue.size());
+
+  Event e;
+  for (uint8_t i = 0; i < 5; i++) {
+    TEST_ASSERT_TRUE(queue.pop(e));
+    TEST_ASSERT_EQUAL(i, e.id);
+    TEST_ASSERT_EQUAL(100u + i, e.timeMs);
+  }
+  TEST_ASSERT_FALSE(queue.pop(e));
+}
+
+void test_peek_leaves_item() {
+  SpscQueue<Event, 4> queue;
+  TEST_ASSERT_NULL(queue.peek());
+  queue.push({7, 70});
+  queue.push({8, 80});
+
+  const Event* front = queue.peek();
+  TEST_ASSERT_NOT_NULL(front);
+  TEST_ASSERT_EQUAL(7, front->id);
+  TEST_ASSERT_EQUAL(2, queue.size());
+
+  Event e;
+  TEST_ASSERT_TRUE(queue.pop(e));
+  TEST_ASSERT_EQUAL(7, e.id);
+  TEST_ASSERT_EQUAL(8, queue.peek()->id);
+}
+
+void test_full_queue_drops_newest() {
+  SpscQueue<Event, 4> queue;
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_TRUE(queue.push({i, 0}));
+  }
+  TEST_ASSERT_FALSE(queue.push({9, 0}));
+  TEST_ASSERT_FALSE(queue.push({9, 0}));
+  TEST_ASSERT_EQUAL(2, queue.dropped.load());
+  TEST_ASSERT_EQUAL(4, queue.size());
+
+  // The queued items are untouched and there is room again
+  Event e;
+  TEST_ASSERT_TRUE(queue.pop(e));
+  TEST_ASSERT_EQUAL(0, e.id);
+  TEST_ASSERT_TRUE(queue.push({4, 0}));
+}
+
+void test_wraps_around() {
+  SpscQueue<Event, 4> queue;
+  Event e;
+  uint8_t pushed = 0;
+  uint8_t popped = 0;
+  for (uint8_t round = 0; round < 40; round++) {
+    for (uint8_t i = 0; i <= round % 4; i++) {
+      TEST_ASSERT_TRUE(queue.push({pushed++, 0}));
+    }
+    while (queue.pop(e)) {
+      TEST_ASSERT_EQUAL(popped++, e.id);
+    }
+  }
+  TEST_ASSERT_EQUAL(pushed, popped);
+  TEST_ASSERT_EQUAL(0, queue.dropped.load());
+}
+
+void test_counters_wrap() {
+  // Positions near overflow behave like any others
+  SpscQueue<Event, 4> queue;
+  queue.head.store(UINT32_MAX - 1);
+  queue.tail.store(UINT32_MAX - 1);
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_TRUE(queue.push({i, 0}));
+  }
+  TEST_ASSERT_FALSE(queue.push({9, 0}));
+
+  Event e;
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_TRUE(queue.pop(e));
+    TEST_ASSERT_EQUAL(i, e.id);
+  }
+  TEST_ASSERT_TRUE(queue.empty());
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_starts_empty);
+  RUN_TEST(test_fifo_order);
+  RUN_TEST(test_peek_leaves_item);
+  RUN_TEST(test_full_queue_drops_newest);
+  RUN_TEST(test_wraps_around);
+  RUN_TEST(test_counters_wrap);
+  return UNITY_END();
+}
@@ -0,0 +1,113 @@
+#include <unity.h>
+#include <cstdint>
+#include "../../src/input/touch_baseline.h"
+
+// Test the adaptive touch baseline: IIR tracking, thresholds, hysteresis
+
+static constexpr uint8_t PRESS = 35;
+static constexpr uint8_t RELEASE = 25;
+static constexpr uint8_t SHIFT = 5;
+
+void test_reset_seeds_baseline() {
+  TouchBaseline b;
+  touch_baseline_reset(b, 80);
+  TEST_ASSERT_EQUAL(80, touch_baseline_get(b));
+  TEST_ASSERT_EQUAL(0, touch_baseline_delta(b));
+
+  b.raw = 10;
+  TEST_ASSERT_EQUAL(70, touch_baseline_delta(b));
+  b.raw = 90;
+  TEST_ASSERT_EQUAL(-10, touch_baseline_delta(b));
+}
+
+void test_levels_scale_with_baseline() {
+  TouchBaseline b;
+  touch_baseline_reset(b, 80);
+  TEST_ASSERT_EQUAL(52, touch_baseline_level(b, PRESS));
+  TEST_ASSERT_EQUAL(60, touch_baseline_level(b, RELEASE));
+
+  touch_baseline_reset(b, 40);
+  TEST_ASSERT_EQUAL(26, touch_baseline_level(b, PRESS));
+  TEST_ASSERT_EQUAL(30, touch_baseline_level(b, RELEASE));
+}
+
+void test_hysteresis_band() {
+  TouchBaseline b;
+  touch_baseline_reset(b, 80);
+
+  // Up: presses only below the press level
+  TEST_ASSERT_FALSE(touch_baseline_is_touched(b, 52, false, PRESS, RELEASE));
+  TEST_ASSERT_TRUE(touch_baseline_is_touched(b, 51, false, PRESS, RELEASE));
+
+  // Down: anything in the band stays touched
+  TEST_ASSERT_TRUE(touch_baseline_is_touched(b, 55, true, PRESS, RELEASE));
+  TEST_ASSERT_TRUE(touch_baseline_is_touched(b, 59, true, PRESS, RELEASE));
+  TEST_ASSERT_FALSE(touch_baseline_is_touched(b, 60, true, PRESS, RELEASE));
+
+  // The same band reading does not press an up pad
+  TEST_ASSERT_FALSE(touch_baseline_is_touched(b, 55, false, PRESS, RELEASE));
+}
+
+void test_track_converges_to_reading() {
+  TouchBaseline b;
+  touch_baseline_reset(b, 80);
+
+  // One time constant covers ~63% of a step
+  for (uint32_t i = 0; i < (1u << SHIFT); i++) {
+    touch_baseline_track(b, 60, SHIFT);
+  }
+  TEST_ASSERT_INT_WITHIN(1, 67, touch_baseline_get(b));
+
+  for (uint32_t i = 0; i < 20 * (1u << SHIFT); i++) {
+    touch_baseline_track(b, 60, SHIFT);
+  }
+  TEST_ASSERT_EQUAL(60, touch_baseline_get(b));
+
+  // And back up: small steps must not round away
+  for (uint32_t i = 0; i < 20 * (1u << SHIFT); i++) {
+    touch_baseline_track(b, 61, SHIFT);
+  }
+  TEST_ASSERT_EQUAL(61, touch_baseline_get(b));
+}
+
+void test_slow_drift_never_crosses_threshold() {
+  // Humidity pulls the untouched reading from 80 down to 30, one count per
+  // 10 samples; a fixed threshold of 40 would read that as a press
+  TouchBaseline b;
+  touch_baseline_reset(b, 80);
+  for (uint16_t raw = 80; raw >= 30; raw--) {
+    for (uint8_t i = 0; i < 10; i++) {
+      b.raw = raw;
+      TEST_ASSERT_FALSE(touch_baseline_is_touched(b, raw, false, PRESS, RELEASE));
+      touch_baseline_track(b, raw, SHIFT);
+    }
+  }
+
+  // A real touch still reads as one
+  TEST_ASSERT_TRUE(touch_baseline_is_touched(b, 10, false, PRESS, RELEASE));
+}
+
+void test_noise_filtered() {
+  TouchBaseline b;
+  touch_baseline_reset(b, 80);
+  uint32_t x = 99;
+  for (uint32_t i = 0; i < 2000; i++) {
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    touch_baseline_track(b, (uint16_t)(75 + x % 11), SHIFT);  // 80 +- 5
+  }
+  TEST_ASSERT_INT_WITHIN(2, 80, touch_baseline_get(b));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_reset_seeds_baseline);
+  RUN_TEST(test_levels_scale_with_baseline);
+  RUN_TEST(test_hysteresis_band);
+  RUN_TEST(test_track_converges_to_reading);
+  RUN_TEST(test_slow_drift_never_crosses_threshold);
+  RUN_TEST(test_noise_filtered);
+  return UNITY_END();
+}